@@ -25,11 +25,15 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <cstring>
 #include <mutex>
+#include <set>
 #include <utility>
 
 #include <wx/datetime.h>
 #include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
 #include <wx/log.h>
 #include <wx/stdpaths.h>
 
@@ -48,6 +52,7 @@
 #include <project.h>
 #include <settings/common_settings.h>
 #include <settings/settings_manager.h>
+#include <thread_pool.h>
 #include <wx_filename.h>
 
 
@@ -56,6 +61,272 @@
 static std::mutex mutex3D_cache;
 
 
+/*
+ * Render cache files (".3dm") hold the S3DMODEL of a model, in native byte order:
+ *
+ *   magic, byte order mark, plugin info length and string, material count, mesh count
+ *   materials, as 14 floats each
+ *   meshes, as vertex count, face index count, material index and flags, followed by the
+ *   contiguous position, normal, optional texture coordinate, optional color and face index
+ *   arrays
+ *
+ * Bump the magic when the layout or the scene graph to render data conversion changes.
+ */
+static const char     RENDER_CACHE_MAGIC[8] = { 'K', 'I', '3', 'D', 'M', 'D', 'L', '1' };
+static const uint32_t RENDER_CACHE_BOM = 0x01020304;
+
+enum RENDER_CACHE_MESH_FLAGS : uint32_t
+{
+    RCF_TEXCOORDS = 1,
+    RCF_COLORS    = 2
+};
+
+static_assert( sizeof( SFVEC3F ) == 3 * sizeof( float ), "SFVEC3F must be packed" );
+static_assert( sizeof( SFVEC2F ) == 2 * sizeof( float ), "SFVEC2F must be packed" );
+
+
+bool S3D_CACHE::WriteRenderCache( const wxString& aFileName, const std::string& aPluginInfo,
+                                  const S3DMODEL& aModel )
+{
+    std::vector<char> buffer;
+
+    auto put =
+            [&]( const void* aData, size_t aSize )
+            {
+                const char* data = static_cast<const char*>( aData );
+                buffer.insert( buffer.end(), data, data + aSize );
+            };
+
+    auto putU32 =
+            [&]( uint32_t aValue )
+            {
+                put( &aValue, sizeof( aValue ) );
+            };
+
+    put( RENDER_CACHE_MAGIC, sizeof( RENDER_CACHE_MAGIC ) );
+    putU32( RENDER_CACHE_BOM );
+    putU32( aPluginInfo.size() );
+    put( aPluginInfo.data(), aPluginInfo.size() );
+    putU32( aModel.m_MaterialsSize );
+    putU32( aModel.m_MeshesSize );
+
+    for( unsigned int ii = 0; ii < aModel.m_MaterialsSize; ++ii )
+    {
+        const SMATERIAL& mat = aModel.m_Materials[ii];
+
+        put( &mat.m_Ambient, sizeof( SFVEC3F ) );
+        put( &mat.m_Diffuse, sizeof( SFVEC3F ) );
+        put( &mat.m_Emissive, sizeof( SFVEC3F ) );
+        put( &mat.m_Specular, sizeof( SFVEC3F ) );
+        put( &mat.m_Shininess, sizeof( float ) );
+        put( &mat.m_Transparency, sizeof( float ) );
+    }
+
+    for( unsigned int ii = 0; ii < aModel.m_MeshesSize; ++ii )
+    {
+        const SMESH& mesh = aModel.m_Meshes[ii];
+        uint32_t     flags = ( mesh.m_Texcoords ? RCF_TEXCOORDS : 0 )
+                             | ( mesh.m_Color ? RCF_COLORS : 0 );
+
+        putU32( mesh.m_VertexSize );
+        putU32( mesh.m_FaceIdxSize );
+        putU32( mesh.m_MaterialIdx );
+        putU32( flags );
+
+        put( mesh.m_Positions, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+        put( mesh.m_Normals, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+
+        if( mesh.m_Texcoords )
+            put( mesh.m_Texcoords, mesh.m_VertexSize * sizeof( SFVEC2F ) );
+
+        if( mesh.m_Color )
+            put( mesh.m_Color, mesh.m_VertexSize * sizeof( SFVEC3F ) );
+
+        put( mesh.m_FaceIdx, mesh.m_FaceIdxSize * sizeof( unsigned int ) );
+    }
+
+    // Write to a temporary file first so that a concurrent reader never sees a partial file
+    wxString tmpName = aFileName + wxString::Format( wxT( ".%lu.tmp" ), wxGetProcessId() );
+
+    {
+        wxFFile file( tmpName, wxT( "wb" ) );
+
+        if( !file.IsOpened() || file.Write( buffer.data(), buffer.size() ) != buffer.size() )
+        {
+            file.Close();
+            wxRemoveFile( tmpName );
+            return false;
+        }
+    }
+
+    if( !wxRenameFile( tmpName, aFileName, true ) )
+    {
+        wxRemoveFile( tmpName );
+        return false;
+    }
+
+    return true;
+}
+
+
+S3DMODEL* S3D_CACHE::ReadRenderCache( const wxString& aFileName, std::string& aPluginInfo )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return nullptr;
+
+    // Read the whole file at once; the arrays are then copied out of it without parsing
+    wxFileOffset length = file.Length();
+
+    if( length <= 0 )
+        return nullptr;
+
+    std::vector<char> buffer( length );
+
+    if( file.Read( buffer.data(), buffer.size() ) != buffer.size() )
+        return nullptr;
+
+    size_t pos = 0;
+
+    auto get =
+            [&]( void* aData, size_t aSize ) -> bool
+            {
+                if( aSize > buffer.size() - pos )
+                    return false;
+
+                if( aSize )
+                    memcpy( aData, buffer.data() + pos, aSize );
+
+                pos += aSize;
+                return true;
+            };
+
+    auto getU32 =
+            [&]( uint32_t& aValue ) -> bool
+            {
+                return get( &aValue, sizeof( aValue ) );
+            };
+
+    char     magic[sizeof( RENDER_CACHE_MAGIC )];
+    uint32_t bom = 0;
+    uint32_t infoSize = 0;
+
+    if( !get( magic, sizeof( magic ) ) || memcmp( magic, RENDER_CACHE_MAGIC, sizeof( magic ) )
+            || !getU32( bom ) || bom != RENDER_CACHE_BOM || !getU32( infoSize )
+            || infoSize > buffer.size() - pos )
+    {
+        return nullptr;
+    }
+
+    aPluginInfo.assign( buffer.data() + pos, infoSize );
+    pos += infoSize;
+
+    uint32_t materialsSize = 0;
+    uint32_t meshesSize = 0;
+
+    if( !getU32( materialsSize ) || !getU32( meshesSize )
+            || materialsSize > buffer.size() || meshesSize > buffer.size() )
+    {
+        return nullptr;
+    }
+
+    S3DMODEL* model = S3D::New3DModel();
+    bool      ok = true;
+
+    if( materialsSize )
+    {
+        model->m_Materials = new SMATERIAL[materialsSize];
+        model->m_MaterialsSize = materialsSize;
+
+        for( uint32_t ii = 0; ok && ii < materialsSize; ++ii )
+        {
+            SMATERIAL& mat = model->m_Materials[ii];
+
+            ok = get( &mat.m_Ambient, sizeof( SFVEC3F ) )
+                 && get( &mat.m_Diffuse, sizeof( SFVEC3F ) )
+                 && get( &mat.m_Emissive, sizeof( SFVEC3F ) )
+                 && get( &mat.m_Specular, sizeof( SFVEC3F ) )
+                 && get( &mat.m_Shininess, sizeof( float ) )
+                 && get( &mat.m_Transparency, sizeof( float ) );
+        }
+    }
+
+    if( ok && meshesSize )
+    {
+        model->m_Meshes = new SMESH[meshesSize];
+        model->m_MeshesSize = meshesSize;
+
+        for( uint32_t ii = 0; ii < meshesSize; ++ii )
+            S3D::Init3DMesh( model->m_Meshes[ii] );
+
+        for( uint32_t ii = 0; ok && ii < meshesSize; ++ii )
+        {
+            SMESH&   mesh = model->m_Meshes[ii];
+            uint32_t vertexSize = 0;
+            uint32_t faceIdxSize = 0;
+            uint32_t materialIdx = 0;
+            uint32_t flags = 0;
+
+            ok = getU32( vertexSize ) && getU32( faceIdxSize ) && getU32( materialIdx )
+                 && getU32( flags );
+
+            // Check the sizes against the data left before allocating anything
+            size_t vertexBytes = (size_t) vertexSize * sizeof( SFVEC3F );
+            size_t faceBytes = (size_t) faceIdxSize * sizeof( unsigned int );
+
+            if( !ok || vertexBytes > buffer.size() - pos || faceBytes > buffer.size() - pos )
+            {
+                ok = false;
+                break;
+            }
+
+            mesh.m_VertexSize = vertexSize;
+            mesh.m_FaceIdxSize = faceIdxSize;
+            mesh.m_MaterialIdx = materialIdx;
+
+            mesh.m_Positions = new SFVEC3F[vertexSize];
+            mesh.m_Normals = new SFVEC3F[vertexSize];
+            mesh.m_FaceIdx = new unsigned int[faceIdxSize];
+
+            ok = get( mesh.m_Positions, vertexBytes ) && get( mesh.m_Normals, vertexBytes );
+
+            if( ok && ( flags & RCF_TEXCOORDS ) )
+            {
+                mesh.m_Texcoords = new SFVEC2F[vertexSize];
+                ok = get( mesh.m_Texcoords, (size_t) vertexSize * sizeof( SFVEC2F ) );
+            }
+
+            if( ok && ( flags & RCF_COLORS ) )
+            {
+                mesh.m_Color = new SFVEC3F[vertexSize];
+                ok = get( mesh.m_Color, vertexBytes );
+            }
+
+            ok = ok && get( mesh.m_FaceIdx, faceBytes );
+
+            // The renderers index the materials and vertices without checking them
+            if( ok && materialIdx >= materialsSize )
+                ok = false;
+
+            for( uint32_t jj = 0; ok && jj < faceIdxSize; ++jj )
+            {
+                if( mesh.m_FaceIdx[jj] >= vertexSize )
+                    ok = false;
+            }
+        }
+    }
+
+    if( !ok )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] bad render cache file '%s'" ), aFileName );
+        S3D::Destroy3DModel( &model );
+    }
+
+    return model;
+}
+
+
 static bool checkTag( const char* aTag, void* aPluginMgrPtr )
 {
     if( nullptr == aTag || nullptr == aPluginMgrPtr )
@@ -67,6 +338,27 @@ static bool checkTag( const char* aTag, void* aPluginMgrPtr )
 }
 
 
+struct TAG_CHECK_CONTEXT
+{
+    S3D_PLUGIN_MANAGER* m_Plugins;
+    std::string         m_Tag;
+};
+
+
+// Check a tag like checkTag(), keeping it so that the plugin info of a model read from a
+// scene cache file is known
+static bool checkAndKeepTag( const char* aTag, void* aContext )
+{
+    TAG_CHECK_CONTEXT* context = static_cast<TAG_CHECK_CONTEXT*>( aContext );
+
+    if( nullptr == aTag || nullptr == context )
+        return false;
+
+    context->m_Tag = aTag;
+    return checkTag( aTag, context->m_Plugins );
+}
+
+
 class S3D_CACHE_ENTRY
 {
 public:
@@ -141,7 +433,8 @@ S3D_CACHE::~S3D_CACHE()
 
 
 SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePath,
-                             S3D_CACHE_ENTRY** aCachePtr, const EMBEDDED_FILES* aEmbeddedFiles )
+                             S3D_CACHE_ENTRY** aCachePtr, const EMBEDDED_FILES* aEmbeddedFiles,
+                             bool aNeedScene )
 {
     if( aCachePtr )
         *aCachePtr = nullptr;
@@ -200,6 +493,9 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
             }
         }
 
+        if( aNeedScene && nullptr == mi->second->sceneData && nullptr != mi->second->renderData )
+            loadDeferredScene( full3Dpath, mi->second );
+
         if( nullptr != aCachePtr )
             *aCachePtr = mi->second;
 
@@ -207,7 +503,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
     }
 
     // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return checkCache( full3Dpath, aCachePtr, aNeedScene );
 }
 
 
@@ -218,7 +514,8 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile, const wxString& aBasePa
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr,
+                                   bool aNeedScene )
 {
     if( aCachePtr )
         *aCachePtr = nullptr;
@@ -269,6 +566,11 @@ SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY**
 
     ep->SetHash( hashSum );
 
+    // Render data alone is enough for the renderers
+    if( !aNeedScene && !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache
+        && loadRenderCacheData( ep ) )
+        return nullptr;
+
     wxString bname = ep->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
@@ -348,11 +650,15 @@ bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
     if( nullptr != aCacheItem->sceneData )
         S3D::DestroyNode( (SGNODE*) aCacheItem->sceneData );
 
-    aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), m_Plugins, checkTag );
+    TAG_CHECK_CONTEXT tagCheck = { m_Plugins, {} };
+
+    aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), &tagCheck,
+                                                         checkAndKeepTag );
 
     if( nullptr == aCacheItem->sceneData )
         return false;
 
+    aCacheItem->pluginInfo = tagCheck.m_Tag;
     return true;
 }
 
@@ -411,6 +717,70 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
 }
 
 
+bool S3D_CACHE::loadRenderCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    std::string pluginInfo;
+    S3DMODEL*   model = ReadRenderCache( fname, pluginInfo );
+
+    if( nullptr == model )
+        return false;
+
+    if( !checkTag( pluginInfo.c_str(), m_Plugins ) )
+    {
+        S3D::Destroy3DModel( &model );
+        return false;
+    }
+
+    if( nullptr != aCacheItem->renderData )
+        S3D::Destroy3DModel( &aCacheItem->renderData );
+
+    aCacheItem->renderData = model;
+    aCacheItem->pluginInfo = pluginInfo;
+    return true;
+}
+
+
+bool S3D_CACHE::saveRenderCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( nullptr == aCacheItem->renderData || bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    // Without plugin info the render cache file could not be checked when read back
+    if( aCacheItem->pluginInfo.empty() )
+        return false;
+
+    return WriteRenderCache( m_CacheDir + bname + wxT( ".3dm" ), aCacheItem->pluginInfo,
+                             *aCacheItem->renderData );
+}
+
+
+void S3D_CACHE::loadDeferredScene( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString cachename = m_CacheDir + aCacheItem->GetCacheBaseName() + wxT( ".3dc" );
+
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && wxFileName::FileExists( cachename )
+        && loadCacheData( aCacheItem ) )
+        return;
+
+    aCacheItem->sceneData = m_Plugins->Load3DModel( aFileName, aCacheItem->pluginInfo );
+
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != aCacheItem->sceneData )
+        saveCacheData( aCacheItem );
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -551,7 +921,11 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
                                const EMBEDDED_FILES* aEmbeddedFiles )
 {
     S3D_CACHE_ENTRY* cp = nullptr;
-    SCENEGRAPH*      sp = load( aModelFileName, aBasePath, &cp, aEmbeddedFiles );
+    SCENEGRAPH*      sp = load( aModelFileName, aBasePath, &cp, aEmbeddedFiles, false );
+
+    // Render data read from a render cache file comes without scene data
+    if( cp && cp->renderData )
+        return cp->renderData;
 
     if( !sp )
         return nullptr;
@@ -571,14 +945,102 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache )
+        saveRenderCacheData( cp );
+
     return mp;
 }
 
+
+void S3D_CACHE::PreloadModels( const std::vector<MODEL_SOURCE>& aModels )
+{
+    if( m_CacheDir.empty() || ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache )
+        return;
+
+    struct PRELOAD
+    {
+        wxString    m_FullPath;
+        wxDateTime  m_ModTime;
+        HASH_128    m_Hash;
+        std::string m_PluginInfo;
+        S3DMODEL*   m_Model = nullptr;
+    };
+
+    std::vector<PRELOAD> preloads;
+    std::set<wxString>   fullPaths;
+
+    for( const MODEL_SOURCE& source : aModels )
+    {
+        wxString fullPath = m_FNResolver->ResolvePath( source.m_Filename, source.m_BasePath,
+                                                       source.m_EmbeddedFiles );
+
+        if( !fullPath.empty() )
+            fullPaths.insert( fullPath );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+        for( const wxString& fullPath : fullPaths )
+        {
+            if( !m_CacheMap.contains( fullPath ) )
+                preloads.emplace_back().m_FullPath = fullPath;
+        }
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.parallelize_loop( preloads.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    PRELOAD& preload = preloads[ii];
+
+                    preload.m_ModTime = wxFileName( preload.m_FullPath ).GetModificationTime();
+
+                    if( !getHash( preload.m_FullPath, preload.m_Hash ) )
+                        continue;
+
+                    wxString fname = m_CacheDir + preload.m_Hash.ToString() + wxT( ".3dm" );
+
+                    if( wxFileName::FileExists( fname ) )
+                        preload.m_Model = ReadRenderCache( fname, preload.m_PluginInfo );
+                }
+            } );
+
+    results.wait();
+
+    std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+    for( PRELOAD& preload : preloads )
+    {
+        if( nullptr == preload.m_Model )
+            continue;
+
+        if( m_CacheMap.contains( preload.m_FullPath )
+                || !checkTag( preload.m_PluginInfo.c_str(), m_Plugins ) )
+        {
+            S3D::Destroy3DModel( &preload.m_Model );
+            continue;
+        }
+
+        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+
+        ep->modTime = preload.m_ModTime;
+        ep->SetHash( preload.m_Hash );
+        ep->pluginInfo = preload.m_PluginInfo;
+        ep->renderData = preload.m_Model;
+
+        m_CacheList.push_back( ep );
+        m_CacheMap.emplace( preload.m_FullPath, ep );
+    }
+}
+
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
-    wxString      fileSpec = wxT( "*.3dc" );
-    wxArrayString fileList; // Holds list of ".3dc" files found in cache directory
+    wxArrayString fileList; // Holds list of ".3dc" and ".3dm" files found in cache directory
     size_t        numFilesFound = 0;
 
     wxFileName thisFile;
@@ -594,8 +1056,10 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
     {
         thisFile.SetPath( m_CacheDir ); // Set the base path to the cache folder
 
-        // Get a list of all the ".3dc" files in the cache directory
-        numFilesFound = dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        // Get a list of all the ".3dc" and ".3dm" files in the cache directory
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dc" ) );
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dm" ) );
+        numFilesFound = fileList.GetCount();
 
         for( unsigned int i = 0; i < numFilesFound; i++ )
         {
@@ -35,6 +35,8 @@
 #include <hash_128.h>
 #include <list>
 #include <map>
+#include <string>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -54,6 +56,14 @@ class  S3D_PLUGIN_MANAGER;
 class S3D_CACHE : public PROJECT::_ELEM
 {
 public:
+    /// A model file name with the base path and embedded files to resolve it against.
+    struct MODEL_SOURCE
+    {
+        wxString              m_Filename;
+        wxString              m_BasePath;
+        const EMBEDDED_FILES* m_EmbeddedFiles;
+    };
+
     S3D_CACHE();
     virtual ~S3D_CACHE();
 
@@ -134,15 +144,50 @@ public:
     S3DMODEL* GetModel( const wxString& aModelFileName, const wxString& aBasePath,
                         const EMBEDDED_FILES* aEmbeddedFiles );
 
+    /**
+     * Load the render data of several models from their render cache files ahead of
+     * GetModel() calls.
+     *
+     * The model files are hashed and the cache files are read on the thread pool.  Models
+     * without a render cache file are left to GetModel(), which loads them with their plugin
+     * and writes the cache file for the next time.
+     *
+     * @param aModels is the list of models to load.
+     */
+    void PreloadModels( const std::vector<MODEL_SOURCE>& aModels );
+
     /**
      * Delete up old cache files in cache directory.
      *
-     * Deletes ".3dc" files in the cache directory that are older than \a aNumDaysOld.
+     * Deletes ".3dc" and ".3dm" files in the cache directory that are older than
+     * \a aNumDaysOld.
      *
-     * @param aNumDaysOld is age threshold to delete ".3dc" cache files.
+     * @param aNumDaysOld is age threshold to delete cache files.
      */
     void CleanCacheDir( int aNumDaysOld );
 
+    /**
+     * Write the render data of a model to a render cache (".3dm") file.
+     *
+     * @param aFileName is the full path of the cache file.
+     * @param aPluginInfo is the info string of the plugin which loaded the model.
+     * @param aModel is the render data to write.
+     * @return true on success.
+     */
+    static bool WriteRenderCache( const wxString& aFileName, const std::string& aPluginInfo,
+                                  const S3DMODEL& aModel );
+
+    /**
+     * Read the render data of a model from a render cache (".3dm") file.
+     *
+     * Truncated files and meshes referencing missing materials or vertices are rejected.
+     *
+     * @param aFileName is the full path of the cache file.
+     * @param aPluginInfo receives the info string of the plugin which loaded the model.
+     * @return the render data, to be freed with S3D::Destroy3DModel(), or nullptr on error.
+     */
+    static S3DMODEL* ReadRenderCache( const wxString& aFileName, std::string& aPluginInfo );
+
 private:
     /**
      * Find or create cache entry for file name
@@ -154,7 +199,8 @@ private:
      * @param aCachePtr is an optional return address for cache entry pointer.
      * @return SCENEGRAPH object associated with file name or NULL on error.
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = nullptr );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = nullptr,
+                            bool aNeedScene = true );
 
     /**
      * Calculate the SHA1 hash of the given file.
@@ -171,10 +217,20 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    // load render data from a render cache file
+    bool loadRenderCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a render cache file
+    bool saveRenderCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // load the scene data of an entry created from its render cache file
+    void loadDeferredScene( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
+    // when aNeedScene is false, an entry with render data may be returned without scene data
     SCENEGRAPH* load( const wxString& aModelFile, const wxString& aBasePath,
                       S3D_CACHE_ENTRY** aCachePtr = nullptr,
-                      const EMBEDDED_FILES* aEmbeddedFiles = nullptr );
+                      const EMBEDDED_FILES* aEmbeddedFiles = nullptr, bool aNeedScene = true );
 
     /// Cache entries.
     std::list< S3D_CACHE_ENTRY* > m_CacheList;
@@ -30,6 +30,8 @@
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <3d_rendering/raytracing/shapes2D/polygon_2d.h>
 #include <board.h>
+#include <fp_lib_table.h>
+#include <project_pcb.h>
 #include <dialogs/dialog_color_picker.h>
 #include <layer_range.h>
 #include <3d_math.h>
@@ -305,6 +307,46 @@ bool BOARD_ADAPTER::IsFootprintShown( FOOTPRINT_ATTR_T aFPAttributes ) const
 }
 
 
+void BOARD_ADAPTER::Preload3dModels() const
+{
+    if( !m_board || !m_3dModelManager )
+        return;
+
+    std::vector<S3D_CACHE::MODEL_SOURCE> models;
+
+    for( const FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        wxString footprintBasePath = wxEmptyString;
+
+        if( m_board->GetProject() )
+        {
+            try
+            {
+                // FindRow() can throw an exception
+                const FP_LIB_TABLE_ROW* fpRow =
+                        PROJECT_PCB::PcbFootprintLibs( m_board->GetProject() )
+                                ->FindRow( footprint->GetFPID().GetLibNickname(), false );
+
+                if( fpRow )
+                    footprintBasePath = fpRow->GetFullURI( true );
+            }
+            catch( ... )
+            {
+                // Do nothing if the libraryName is not found in lib table
+            }
+        }
+
+        for( const FP_3DMODEL& model : footprint->Models() )
+        {
+            if( model.m_Show && !model.m_Filename.empty() )
+                models.push_back( { model.m_Filename, footprintBasePath, footprint } );
+        }
+    }
+
+    m_3dModelManager->PreloadModels( models );
+}
+
+
 int BOARD_ADAPTER::GetHolePlatingThickness() const noexcept
 {
     return m_board ? m_board->GetDesignSettings().GetHolePlatingThickness()
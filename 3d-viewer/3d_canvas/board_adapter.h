@@ -27,6 +27,7 @@
 #define BOARD_ADAPTER_H
 
 #include <array>
+#include <mutex>
 #include <vector>
 #include "../3d_rendering/raytracing/accelerators/container_2d.h"
 #include "../3d_rendering/raytracing/accelerators/container_3d.h"
@@ -84,6 +85,12 @@ public:
     void Set3dCacheManager( S3D_CACHE* aCacheMgr ) noexcept { m_3dModelManager = aCacheMgr; }
     S3D_CACHE* Get3dCacheManager() const noexcept { return m_3dModelManager; }
 
+    /**
+     * Load the render data of the board footprint 3D models into the 3D cache manager, so
+     * that the renderers find them there.
+     */
+    void Preload3dModels() const;
+
     /**
      * Check if a layer is enabled.
      *
@@ -406,6 +413,14 @@ private:
     void buildPadOutlineAsSegments( const PAD* aPad, PCB_LAYER_ID aLayer,
                                     CONTAINER_2D_BASE* aDstContainer, int aWidth );
 
+    /**
+     * Make a union of the contours of \a aPoly, the polygons of \a aLayer.
+     *
+     * The result of the previous build of the layer is reused when its contours have not
+     * changed.  This is thread safe for different layers.
+     */
+    void simplifyLayerPolys( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPoly );
+
 public:
     static CUSTOM_COLORS_LIST   g_SilkColors;
     static CUSTOM_COLORS_LIST   g_MaskColors;
@@ -467,6 +482,11 @@ private:
     MAP_POLY          m_layerHoleOdPolys;     ///< Hole outer diameters (per layer)
     MAP_POLY          m_layerHoleIdPolys;     ///< Hole inner diameters (per layer)
 
+    /// Simplified layer polygons of the previous builds, with the hash of their contours
+    /// before simplification.  Kept across builds so unchanged layers are not simplified again.
+    std::map<PCB_LAYER_ID, std::pair<HASH_128, SHAPE_POLY_SET>> m_simplifiedPolysCache;
+    std::mutex        m_simplifiedPolysCacheMutex;
+
     SHAPE_POLY_SET    m_NPTH_ODPolys;         ///< NPTH outer diameters
     SHAPE_POLY_SET    m_TH_ODPolys;           ///< PTH outer diameters
     SHAPE_POLY_SET    m_viaTH_ODPolys;        ///< Via hole outer diameters
@@ -32,8 +32,8 @@
 #include <lset.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
+#include <thread_pool.h>
 #include <vector>
-#include <thread>
 #include <algorithm>
 #include <atomic>
 #include <wx/log.h>
@@ -201,6 +201,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
 #endif
 
     EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_Cfg->m_Render;
+    thread_pool&                             tp = GetKiCadThreadPool();
 
     std::bitset<LAYER_3D_END> visibilityFlags = GetVisibleLayers();
 
@@ -769,56 +770,45 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
 
         // Add zones objects
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>( zones.size(),
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < zones.size();
-                            areaId = nextZone.fetch_add( 1 ) )
+        auto results = tp.parallelize_loop( zones.size(),
+                [&]( const int a, const int b )
                 {
-                    ZONE* zone = zones[areaId].first;
-
-                    if( zone == nullptr )
-                        break;
-
-                    PCB_LAYER_ID layer = zones[areaId].second;
-
-                    if( m_layerMap.contains( layer ) )
-                        addSolidAreasShapes( zone, m_layerMap[layer], layer );
-
-                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
-                            && m_layers_poly.contains( layer ) )
+                    for( int areaId = a; areaId < b; ++areaId )
                     {
-                        auto mut_it = layer_lock.find( layer );
+                        ZONE*        zone = zones[areaId].first;
+                        PCB_LAYER_ID layer = zones[areaId].second;
 
-                        std::lock_guard< std::mutex > lock( *( mut_it->second ) );
-                        zone->TransformSolidAreasShapesToPolygon( layer, *m_layers_poly[layer] );
-                    }
-                }
+                        if( m_layerMap.contains( layer ) )
+                            addSolidAreasShapes( zone, m_layerMap[layer], layer );
 
-                threadsFinished++;
-            } );
+                        if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
+                                && m_layers_poly.contains( layer ) )
+                        {
+                            auto mut_it = layer_lock.find( layer );
 
-            t.detach();
-        }
+                            std::lock_guard< std::mutex > lock( *( mut_it->second ) );
+                            zone->TransformSolidAreasShapesToPolygon( layer, *m_layers_poly[layer] );
+                        }
+                    }
+                } );
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        results.wait();
     }
     // End Build Copper layers
 
-    // This will make a union of all added contours
-    m_TH_ODPolys.Simplify();
-    m_NPTH_ODPolys.Simplify();
-    m_viaTH_ODPolys.Simplify();
-    m_viaAnnuliPolys.Simplify();
+    // This will make a union of all added contours.  Nothing below reads these until the
+    // end of createLayers(), so let them simplify while the tech layers are built.
+    BS::multi_future<void> holeSimplifyFutures;
+
+    for( SHAPE_POLY_SET* holePolys : { &m_TH_ODPolys, &m_NPTH_ODPolys, &m_viaTH_ODPolys,
+                                       &m_viaAnnuliPolys } )
+    {
+        holeSimplifyFutures.push_back( tp.submit(
+                [holePolys]()
+                {
+                    holePolys->Simplify();
+                } ) );
+    }
 
     // Build Tech layers
     // Based on:
@@ -1116,7 +1106,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
             }
 
             // This will make a union of all added contours
-            layerPoly->Simplify();
+            simplifyLayerPolys( layer, *layerPoly );
         }
     }
     // End Build Tech layers
@@ -1177,6 +1167,9 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         m_platedPadsBack->BuildBVH();
     }
 
+    // Simplifications and BVH builds left to finish before returning
+    BS::multi_future<void> finalFutures;
+
     if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
     {
         std::vector<PCB_LAYER_ID> &selected_layer_id = layer_ids;
@@ -1204,38 +1197,21 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                                                            (int) selected_layer_id.size() ) );
             }
 
-            std::atomic<size_t> nextItem( 0 );
-            std::atomic<size_t> threadsFinished( 0 );
-
-            size_t parallelThreadCount = std::min<size_t>(
-                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                    selected_layer_id.size() );
-
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            for( PCB_LAYER_ID layer : selected_layer_id )
             {
-                std::thread t = std::thread(
-                        [&nextItem, &threadsFinished, &selected_layer_id, this]()
-                        {
-                            for( size_t i = nextItem.fetch_add( 1 );
-                                        i < selected_layer_id.size();
-                                        i = nextItem.fetch_add( 1 ) )
+                if( m_layers_poly.contains( layer ) )
+                {
+                    SHAPE_POLY_SET* layerPoly = m_layers_poly[layer];
+
+                    finalFutures.push_back( tp.submit(
+                            [this, layer, layerPoly]()
                             {
-                                if( m_layers_poly.contains( selected_layer_id[i] ) )
-                                {
-                                    // This will make a union of all added contours
-                                    m_layers_poly[ selected_layer_id[i] ]->ClearArcs();
-                                    m_layers_poly[ selected_layer_id[i] ]->Simplify();
-                                }
-                            }
-
-                            threadsFinished++;
-                        } );
-
-                t.detach();
+                                // This will make a union of all added contours
+                                layerPoly->ClearArcs();
+                                simplifyLayerPolys( layer, *layerPoly );
+                            } ) );
+                }
             }
-
-            while( threadsFinished < parallelThreadCount )
-                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
         }
     }
 
@@ -1247,14 +1223,17 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     {
         if( m_layerHoleOdPolys.contains( layer ) )
         {
-            // found
-            SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify();
-
             wxASSERT( m_layerHoleIdPolys.contains( layer ) );
 
-            polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify();
+            for( SHAPE_POLY_SET* polyLayer : { m_layerHoleOdPolys[layer],
+                                               m_layerHoleIdPolys[layer] } )
+            {
+                finalFutures.push_back( tp.submit(
+                        [polyLayer]()
+                        {
+                            polyLayer->Simplify();
+                        } ) );
+            }
         }
     }
 
@@ -1263,21 +1242,54 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_TH_IDs.BuildBVH();
-    m_TH_ODs.BuildBVH();
-    m_viaAnnuli.BuildBVH();
+    std::vector<BVH_CONTAINER_2D*> bvhContainers = { &m_TH_IDs, &m_TH_ODs, &m_viaAnnuli };
 
-    if( !m_layerHoleMap.empty() )
-    {
-        for( std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& hole : m_layerHoleMap )
-            hole.second->BuildBVH();
-    }
+    for( std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& hole : m_layerHoleMap )
+        bvhContainers.push_back( hole.second );
 
     // We only need the Solder mask to initialize the BVH
     // because..?
     if( m_layerMap[B_Mask] )
-        m_layerMap[B_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layerMap[B_Mask] );
 
     if( m_layerMap[F_Mask] )
-        m_layerMap[F_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layerMap[F_Mask] );
+
+    for( BVH_CONTAINER_2D* container : bvhContainers )
+    {
+        finalFutures.push_back( tp.submit(
+                [container]()
+                {
+                    container->BuildBVH();
+                } ) );
+    }
+
+    // None of the final simplifications and BVH builds depend on each other
+    holeSimplifyFutures.wait();
+    finalFutures.wait();
+}
+
+
+void BOARD_ADAPTER::simplifyLayerPolys( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPoly )
+{
+    // The layer polygons are built fresh and never triangulated before this, so the hash is
+    // computed from the current contours
+    const HASH_128 sourceHash = aPoly.GetHash();
+
+    {
+        std::lock_guard<std::mutex> lock( m_simplifiedPolysCacheMutex );
+
+        auto it = m_simplifiedPolysCache.find( aLayer );
+
+        if( it != m_simplifiedPolysCache.end() && it->second.first == sourceHash )
+        {
+            aPoly = it->second.second;
+            return;
+        }
+    }
+
+    aPoly.Simplify();
+
+    std::lock_guard<std::mutex> lock( m_simplifiedPolysCacheMutex );
+    m_simplifiedPolysCache[aLayer] = { sourceHash, aPoly };
 }
@@ -32,9 +32,7 @@
 #include <cstring> // For memcpy
 
 #include <algorithm>
-#include <atomic>
-#include <thread>
-#include <chrono>
+#include <thread_pool.h>
 
 
 #ifndef CLAMP
@@ -478,49 +476,40 @@ void IMAGE::EfxFilter( IMAGE* aInImg, IMAGE_FILTER aFilterType )
     aInImg->m_wraping = IMAGE_WRAP::CLAMP;
     m_wraping         = IMAGE_WRAP::CLAMP;
 
-    std::atomic<size_t> nextRow( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+    thread_pool& tp = GetKiCadThreadPool();
 
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [&]()
-        {
-            for( size_t iy = nextRow.fetch_add( 1 ); iy < m_height; iy = nextRow.fetch_add( 1 ) )
+    auto results = tp.parallelize_loop( m_height,
+            [&]( const int a, const int b )
             {
-                for( size_t ix = 0; ix < m_width; ix++ )
+                for( size_t iy = a; iy < (size_t) b; iy++ )
                 {
-                    int v = 0;
-
-                    for( size_t sy = 0; sy < 5; sy++ )
+                    for( size_t ix = 0; ix < m_width; ix++ )
                     {
-                        for( size_t sx = 0; sx < 5; sx++ )
-                        {
-                            int factor = filter.kernel[sx][sy];
-                            unsigned char pixelv = aInImg->Getpixel( ix + sx - 2, iy + sy - 2 );
+                        int v = 0;
 
-                            v += pixelv * factor;
+                        for( size_t sy = 0; sy < 5; sy++ )
+                        {
+                            for( size_t sx = 0; sx < 5; sx++ )
+                            {
+                                int factor = filter.kernel[sx][sy];
+                                unsigned char pixelv = aInImg->Getpixel( ix + sx - 2,
+                                                                         iy + sy - 2 );
+
+                                v += pixelv * factor;
+                            }
                         }
-                    }
 
-                    v /= filter.div;
-                    v += filter.offset;
-                    CLAMP(v, 0, 255);
+                        v /= filter.div;
+                        v += filter.offset;
+                        CLAMP(v, 0, 255);
 
-                    /// @todo This needs to write to a separate buffer.
-                    m_pixels[ix + iy * m_width] = v;
+                        /// @todo This needs to write to a separate buffer.
+                        m_pixels[ix + iy * m_width] = v;
+                    }
                 }
-            }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
-    }
+            } );
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    results.wait();
 }
 
 
@@ -273,6 +273,23 @@ MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
         MakeBbox( m_model_bbox, 0, &bbox_tmp_vertices[0], &bbox_tmp_indices[0],
                   { 0.0f, 1.0f, 0.0f, 1.0f } );
 
+    // the proxy box takes the color of the opaque material covering the most triangles.
+    size_t proxy_idx_count = 0;
+
+    for( unsigned int mg_i = 0; mg_i < mesh_groups.size(); ++mg_i )
+    {
+        const MATERIAL& mat = m_materials[mg_i];
+
+        if( mesh_groups[mg_i].m_indices.size() > proxy_idx_count
+              && ( !mat.IsTransparent() || m_materialMode == MATERIAL_MODE::DIFFUSE_ONLY ) )
+        {
+            proxy_idx_count = mesh_groups[mg_i].m_indices.size();
+            m_proxy_color = m_materialMode == MATERIAL_MODE::CAD_MODE
+                                    ? MaterialDiffuseToColorCAD( mat.m_Diffuse )
+                                    : mat.m_Diffuse;
+        }
+    }
+
     // create bounding box buffers
     glGenBuffers( 1, &m_bbox_vertex_buffer );
     glBindBuffer( GL_ARRAY_BUFFER, m_bbox_vertex_buffer );
@@ -587,6 +604,62 @@ void MODEL_3D::DrawBbox() const
 }
 
 
+void MODEL_3D::DrawProxy( bool aUseSelectedMaterial, const SFVEC3F& aSelectionColor ) const
+{
+    if( !m_model_bbox.IsInitialized() )
+        return;
+
+    const SFVEC3F color = aUseSelectedMaterial ? aSelectionColor : m_proxy_color;
+
+    // GL_COLOR_MATERIAL may be enabled, in which case the current color is the material.
+    OglSetDiffuseMaterial( color, 1.0f );
+    glColor4f( color.r, color.g, color.b, 1.0f );
+
+    const SFVEC3F& min = m_model_bbox.Min();
+    const SFVEC3F& max = m_model_bbox.Max();
+
+    glBegin( GL_QUADS );
+
+    glNormal3f( 0.0f, 0.0f, 1.0f );
+    glVertex3f( min.x, min.y, max.z );
+    glVertex3f( max.x, min.y, max.z );
+    glVertex3f( max.x, max.y, max.z );
+    glVertex3f( min.x, max.y, max.z );
+
+    glNormal3f( 0.0f, 0.0f, -1.0f );
+    glVertex3f( min.x, min.y, min.z );
+    glVertex3f( min.x, max.y, min.z );
+    glVertex3f( max.x, max.y, min.z );
+    glVertex3f( max.x, min.y, min.z );
+
+    glNormal3f( 1.0f, 0.0f, 0.0f );
+    glVertex3f( max.x, min.y, min.z );
+    glVertex3f( max.x, max.y, min.z );
+    glVertex3f( max.x, max.y, max.z );
+    glVertex3f( max.x, min.y, max.z );
+
+    glNormal3f( -1.0f, 0.0f, 0.0f );
+    glVertex3f( min.x, min.y, min.z );
+    glVertex3f( min.x, min.y, max.z );
+    glVertex3f( min.x, max.y, max.z );
+    glVertex3f( min.x, max.y, min.z );
+
+    glNormal3f( 0.0f, 1.0f, 0.0f );
+    glVertex3f( min.x, max.y, min.z );
+    glVertex3f( min.x, max.y, max.z );
+    glVertex3f( max.x, max.y, max.z );
+    glVertex3f( max.x, max.y, min.z );
+
+    glNormal3f( 0.0f, -1.0f, 0.0f );
+    glVertex3f( min.x, min.y, min.z );
+    glVertex3f( max.x, min.y, min.z );
+    glVertex3f( max.x, min.y, max.z );
+    glVertex3f( min.x, min.y, max.z );
+
+    glEnd();
+}
+
+
 void MODEL_3D::DrawBboxes() const
 {
     if( !glBindBuffer )
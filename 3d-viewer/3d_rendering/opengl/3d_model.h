@@ -96,6 +96,14 @@ public:
      */
     void DrawBboxes() const;
 
+    /**
+     * Draw the main bounding box as a solid box in the color of the model's main opaque
+     * material.
+     *
+     * This replaces the model when it is too small on screen for its detail to be seen.
+     */
+    void DrawProxy( bool aUseSelectedMaterial, const SFVEC3F& aSelectionColor ) const;
+
     /**
      * Get the main bounding box.
      * @return the main model bounding box.
@@ -122,6 +130,7 @@ private:
 
     BBOX_3D   m_model_bbox;               ///< global bounding box for this model
     std::vector<BBOX_3D> m_meshes_bbox;   ///< individual bbox for each mesh
+    SFVEC3F   m_proxy_color = SFVEC3F( 0.8f ); ///< color of the box drawn by DrawProxy()
 
     // unified vertex format for mesh rendering.
     struct VERTEX
@@ -923,6 +923,9 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
     }
 #endif
 
+    // Read the cached models concurrently before going through the footprints
+    m_boardAdapter.Preload3dModels();
+
     // Go for all footprints
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
@@ -38,6 +38,7 @@
 #include <lset.h>
 #include <pgm_base.h>
 #include <math/util.h>      // for KiROUND
+#include <limits>
 #include <utility>
 #include <vector>
 #include <wx/log.h>
@@ -986,6 +987,8 @@ void RENDER_3D_OPENGL::get3dModelsSelected( std::list<MODELTORENDER> &aDstRender
 
     EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_boardAdapter.m_Cfg->m_Render;
 
+    const glm::mat4 viewProjMatrix = m_camera.GetProjectionMatrix() * m_camera.GetViewMatrix();
+
     // Go for all footprints
     for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
     {
@@ -1011,16 +1014,85 @@ void RENDER_3D_OPENGL::get3dModelsSelected( std::list<MODELTORENDER> &aDstRender
 
                 if( aGetTop == !isFlipped || aGetBot == isFlipped )
                     get3dModelsFromFootprint( aDstRenderList, fp, aRenderTransparentOnly,
-                                              highlight );
+                                              highlight, viewProjMatrix );
             }
         }
     }
 }
 
 
+/// Models smaller than this on screen, in pixels, are drawn as their bounding box
+static constexpr float MODEL_PROXY_MAX_SIZE = 2.0f;
+
+
+/**
+ * Project a model bounding box to the screen.
+ *
+ * @param aScreenSize receives the largest side, in pixels, of the screen rectangle enclosing
+ *                    the box.  It is infinite when the box reaches behind the camera.
+ * @return false if the box is entirely outside the view frustum.
+ */
+static bool projectModelBBox( const BBOX_3D& aBBox, const glm::mat4& aModelViewProjMatrix,
+                              const wxSize& aWindowSize, float& aScreenSize )
+{
+    // Count, for each clip plane, the corners outside of it
+    int       outside[6] = { 0, 0, 0, 0, 0, 0 };
+    bool      behindCamera = false;
+    glm::vec2 ndcMin( std::numeric_limits<float>::max() );
+    glm::vec2 ndcMax( -std::numeric_limits<float>::max() );
+
+    for( int i = 0; i < 8; ++i )
+    {
+        const SFVEC3F corner( ( i & 1 ) ? aBBox.Max().x : aBBox.Min().x,
+                              ( i & 2 ) ? aBBox.Max().y : aBBox.Min().y,
+                              ( i & 4 ) ? aBBox.Max().z : aBBox.Min().z );
+
+        const glm::vec4 clip = aModelViewProjMatrix * glm::vec4( corner, 1.0f );
+
+        outside[0] += clip.x < -clip.w;
+        outside[1] += clip.x > clip.w;
+        outside[2] += clip.y < -clip.w;
+        outside[3] += clip.y > clip.w;
+        outside[4] += clip.z < -clip.w;
+        outside[5] += clip.z > clip.w;
+
+        if( clip.w <= 0.0f )
+        {
+            behindCamera = true;
+        }
+        else
+        {
+            const glm::vec2 ndc = glm::vec2( clip ) / clip.w;
+
+            ndcMin = glm::min( ndcMin, ndc );
+            ndcMax = glm::max( ndcMax, ndc );
+        }
+    }
+
+    for( int plane = 0; plane < 6; ++plane )
+    {
+        if( outside[plane] == 8 )
+            return false;
+    }
+
+    if( behindCamera )
+    {
+        aScreenSize = std::numeric_limits<float>::infinity();
+    }
+    else
+    {
+        aScreenSize = glm::max( ( ndcMax.x - ndcMin.x ) * 0.5f * aWindowSize.x,
+                                ( ndcMax.y - ndcMin.y ) * 0.5f * aWindowSize.y );
+    }
+
+    return true;
+}
+
+
 void RENDER_3D_OPENGL::get3dModelsFromFootprint( std::list<MODELTORENDER> &aDstRenderList,
                                                  const FOOTPRINT* aFootprint,
-                                                 bool aRenderTransparentOnly, bool aIsSelected )
+                                                 bool aRenderTransparentOnly, bool aIsSelected,
+                                                 const glm::mat4& aViewProjMatrix )
 {
     if( !aFootprint->Models().empty() )
     {
@@ -1099,10 +1171,28 @@ void RENDER_3D_OPENGL::get3dModelsFromFootprint( std::list<MODELTORENDER> &aDstR
                         modelworldMatrix *= mtx;
                     }
 
+                    float screenSize = 0.0f;
+
+                    if( !projectModelBBox( modelPtr->GetBBox(), aViewProjMatrix * modelworldMatrix,
+                                           m_windowSize, screenSize ) )
+                    {
+                        continue;
+                    }
+
+                    // A proxy box is opaque and drawn in the opaque pass instead of all of the
+                    // model, so only models which have a place in that pass get one.  Tiny
+                    // models without opaque meshes, or made transparent, are drawn normally.
+                    const bool isProxy = screenSize < MODEL_PROXY_MAX_SIZE
+                                         && modelPtr->HasOpaqueMeshes() && opaque;
+
+                    if( isProxy && aRenderTransparentOnly )
+                        continue;
+
                     aDstRenderList.emplace_back( modelworldMatrix, modelPtr,
                                                  aRenderTransparentOnly ? sM.m_Opacity : 1.0f,
                                                  aRenderTransparentOnly,
-                                                 aFootprint->IsSelected() || aIsSelected );
+                                                 aFootprint->IsSelected() || aIsSelected,
+                                                 isProxy );
                 }
             }
         }
@@ -1255,9 +1345,16 @@ void RENDER_3D_OPENGL::renderModel( const glm::mat4 &aCameraViewMatrix,
 
     glLoadMatrixf( glm::value_ptr( modelviewMatrix ) );
 
-    aModelToRender.m_model->Draw( aModelToRender.m_isTransparent, aModelToRender.m_opacity,
-                                  aModelToRender.m_isSelected, aSelColor,
-                                  &aModelToRender.m_modelWorldMat, aCameraWorldPos );
+    if( aModelToRender.m_isProxy )
+    {
+        aModelToRender.m_model->DrawProxy( aModelToRender.m_isSelected, aSelColor );
+    }
+    else
+    {
+        aModelToRender.m_model->Draw( aModelToRender.m_isTransparent, aModelToRender.m_opacity,
+                                      aModelToRender.m_isSelected, aSelColor,
+                                      &aModelToRender.m_modelWorldMat, aCameraWorldPos );
+    }
 
     if( cfg.show_model_bbox )
     {
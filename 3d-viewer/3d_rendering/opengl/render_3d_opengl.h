@@ -135,17 +135,20 @@ private:
         float m_opacity;
         bool m_isTransparent;
         bool m_isSelected;
+        bool m_isProxy;       ///< too small on screen, draw its bounding box instead
 
         MODELTORENDER( glm::mat4 aModelWorldMat,
                        const MODEL_3D* aNodel,
                        float aOpacity,
                        bool aIsTransparent,
-                       bool aIsSelected ) :
+                       bool aIsSelected,
+                       bool aIsProxy = false ) :
                        m_modelWorldMat( std::move( aModelWorldMat ) ),
                        m_model( aNodel ),
                        m_opacity( aOpacity ),
                        m_isTransparent( aIsTransparent ),
-                       m_isSelected( aIsSelected )
+                       m_isSelected( aIsSelected ),
+                       m_isProxy( aIsProxy )
         {
         }
     };
@@ -160,9 +163,17 @@ private:
     void get3dModelsSelected( std::list<MODELTORENDER> &aDstRenderList, bool aGetTop, bool aGetBot,
                               bool aRenderTransparentOnly, bool aRenderSelectedOnly );
 
+    /**
+     * Add the models of \a aFootprint to \a aDstRenderList.
+     *
+     * Models outside the view frustum are skipped, and models smaller on screen than a few
+     * pixels are added as proxies (opaque pass) or skipped (transparent pass).
+     *
+     * @param aViewProjMatrix is the camera projection and view matrix used for culling.
+     */
     void get3dModelsFromFootprint( std::list<MODELTORENDER> &aDstRenderList,
                                    const FOOTPRINT* aFootprint, bool aRenderTransparentOnly,
-                                   bool aIsSelected );
+                                   bool aIsSelected, const glm::mat4& aViewProjMatrix );
 
     void setLightFront( bool enabled );
     void setLightTop( bool enabled );
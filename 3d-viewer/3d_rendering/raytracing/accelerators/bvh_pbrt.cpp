@@ -73,11 +73,17 @@
 #include <boost/range/algorithm/nth_element.hpp>
 #include <boost/range/algorithm/partition.hpp>
 #include <cstdlib>
+#include <limits>
 #include <vector>
 
 #include <stack>
 #include <wx/debug.h>
 
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#define BVH_WIDE_SSE
+#include <xmmintrin.h>
+#endif
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
 #include <stdio.h>
 #endif
@@ -300,6 +306,31 @@ BVH_PBRT::BVH_PBRT( const CONTAINER_3D_BASE& aObjectContainer, int aMaxPrimsInNo
     flattenBVHTree( root, &offset );
 
     wxASSERT( offset == (unsigned int)totalNodes );
+
+    // Single rays traverse a 4-wide copy of the tree
+    if( m_nodes[0].nPrimitives > 0 )
+    {
+        LinearBVHNode4& rootNode = m_wideNodes.emplace_back();
+
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            for( int i = 0; i < 4; ++i )
+            {
+                rootNode.bounds[0][axis][i] = std::numeric_limits<float>::infinity();
+                rootNode.bounds[1][axis][i] = -std::numeric_limits<float>::infinity();
+            }
+
+            rootNode.bounds[0][axis][0] = m_nodes[0].bounds.Min()[axis];
+            rootNode.bounds[1][axis][0] = m_nodes[0].bounds.Max()[axis];
+        }
+
+        rootNode.children[0] = ~0;
+        rootNode.nChildren = 1;
+    }
+    else
+    {
+        flattenWideBVHTree( 0 );
+    }
 }
 
 
@@ -1060,67 +1091,236 @@ int BVH_PBRT::flattenBVHTree( BVHBuildNode* node, uint32_t* offset )
 }
 
 
+int BVH_PBRT::flattenWideBVHTree( int aNode )
+{
+    wxASSERT( m_nodes[aNode].nPrimitives == 0 );
+
+    // Open the interior children with the largest surface area first, until there are four
+    int nSlots = 2;
+    int slots[4] = { aNode + 1, m_nodes[aNode].secondChildOffset, 0, 0 };
+
+    while( nSlots < 4 )
+    {
+        int   best = -1;
+        float bestArea = -1.0f;
+
+        for( int i = 0; i < nSlots; ++i )
+        {
+            const LinearBVHNode& slotNode = m_nodes[slots[i]];
+
+            if( slotNode.nPrimitives == 0 && slotNode.bounds.SurfaceArea() > bestArea )
+            {
+                best = i;
+                bestArea = slotNode.bounds.SurfaceArea();
+            }
+        }
+
+        if( best < 0 )
+            break;
+
+        const int opened = slots[best];
+
+        slots[best] = opened + 1;
+        slots[nSlots++] = m_nodes[opened].secondChildOffset;
+    }
+
+    const int myOffset = m_wideNodes.size();
+
+    // Empty child boxes are inverted, so that rays always miss them
+    LinearBVHNode4 wideNode;
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        for( int i = 0; i < 4; ++i )
+        {
+            wideNode.bounds[0][axis][i] = std::numeric_limits<float>::infinity();
+            wideNode.bounds[1][axis][i] = -std::numeric_limits<float>::infinity();
+        }
+    }
+
+    wideNode.nChildren = nSlots;
+    m_wideNodes.push_back( wideNode );
+
+    for( int i = 0; i < nSlots; ++i )
+    {
+        const LinearBVHNode& slotNode = m_nodes[slots[i]];
+        int                  child = ~slots[i];
+
+        if( slotNode.nPrimitives == 0 )
+            child = flattenWideBVHTree( slots[i] );
+
+        // The recursion grows m_wideNodes, so only take a reference afterwards
+        LinearBVHNode4& node = m_wideNodes[myOffset];
+
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            node.bounds[0][axis][i] = slotNode.bounds.Min()[axis];
+            node.bounds[1][axis][i] = slotNode.bounds.Max()[axis];
+        }
+
+        node.children[i] = child;
+    }
+
+    return myOffset;
+}
+
+
+/**
+ * Test a ray against the four child boxes of a wide node with the slab method.
+ *
+ * A ray lying in the plane of a box face makes that axis test NaN; the axis is then ignored,
+ * which can only report extra hits.
+ *
+ * @param aTNear receives the distance at which the ray enters each child box.
+ * @return a bit mask of the children entered before \a aMaxDistance.
+ */
+static inline unsigned int intersectWideNode( const LinearBVHNode4& aNode, const RAY& aRay,
+                                              float aMaxDistance, float aTNear[4] )
+{
+    unsigned int mask = 0;
+
+#ifdef BVH_WIDE_SSE
+    __m128 tMin = _mm_setzero_ps();
+    __m128 tMax = _mm_set1_ps( aMaxDistance );
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        // Use the sign of the inverse, which is also right for a -0 direction
+        const int    nearSide = aRay.m_InvDir[axis] < 0.0f ? 1 : 0;
+        const __m128 origin = _mm_set1_ps( aRay.m_Origin[axis] );
+        const __m128 invDir = _mm_set1_ps( aRay.m_InvDir[axis] );
+
+        const __m128 tNear = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( aNode.bounds[nearSide][axis] ),
+                                                     origin ),
+                                         invDir );
+        const __m128 tFar = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( aNode.bounds[1 - nearSide][axis] ),
+                                                    origin ),
+                                        invDir );
+
+        // These return their second operand when the first one is NaN
+        tMin = _mm_max_ps( tNear, tMin );
+        tMax = _mm_min_ps( tFar, tMax );
+    }
+
+    _mm_storeu_ps( aTNear, tMin );
+    mask = _mm_movemask_ps( _mm_cmple_ps( tMin, tMax ) );
+#else
+    float tMin[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float tMax[4] = { aMaxDistance, aMaxDistance, aMaxDistance, aMaxDistance };
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        const int   nearSide = aRay.m_InvDir[axis] < 0.0f ? 1 : 0;
+        const float origin = aRay.m_Origin[axis];
+        const float invDir = aRay.m_InvDir[axis];
+
+        for( int i = 0; i < 4; ++i )
+        {
+            const float tNear = ( aNode.bounds[nearSide][axis][i] - origin ) * invDir;
+            const float tFar = ( aNode.bounds[1 - nearSide][axis][i] - origin ) * invDir;
+
+            // Comparisons with NaN are false, leaving the range unchanged
+            if( tNear > tMin[i] )
+                tMin[i] = tNear;
+
+            if( tFar < tMax[i] )
+                tMax[i] = tFar;
+        }
+    }
+
+    for( int i = 0; i < 4; ++i )
+    {
+        aTNear[i] = tMin[i];
+
+        if( tMin[i] <= tMax[i] )
+            mask |= 1 << i;
+    }
+#endif
+
+    return mask & ( ( 1 << aNode.nChildren ) - 1 );
+}
+
+
 #define MAX_TODOS 64
 
+// Each wide node visited replaces itself on the stack with up to four children
+#define MAX_WIDE_TODOS ( 3 * MAX_TODOS )
+
+
+struct WIDE_TODO
+{
+    int   child;    ///< as in LinearBVHNode4::children
+    float tNear;    ///< distance at which the ray enters the child
+};
+
 
 bool BVH_PBRT::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
 {
-    if( !m_nodes )
+    if( m_wideNodes.empty() )
         return false;
 
     bool hit = false;
 
     // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
+    int       todoOffset = 0;
+    WIDE_TODO todo[MAX_WIDE_TODOS];
 
-    while( true )
-    {
-        const LinearBVHNode *node = &m_nodes[nodeNum];
+    todo[todoOffset++] = { 0, 0.0f };
 
-        wxASSERT( todoOffset < MAX_TODOS );
-
-        // Check ray against BVH node
-        float hitBox = 0.0f;
+    while( todoOffset > 0 )
+    {
+        const WIDE_TODO item = todo[--todoOffset];
 
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
+        // Skip the children entered behind a hit found since they were pushed
+        if( item.tNear >= aHitInfo.m_tHit )
+            continue;
 
-        if( hitted && ( hitBox < aHitInfo.m_tHit ) )
+        if( item.child < 0 )
         {
-            if( node->nPrimitives > 0 )
+            const int            nodeNum = ~item.child;
+            const LinearBVHNode& node = m_nodes[nodeNum];
+
+            // Intersect ray with primitives in leaf BVH node
+            for( int i = 0; i < node.nPrimitives; ++i )
             {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
+                if( m_primitives[node.primitivesOffset + i]->Intersect( aRay, aHitInfo ) )
                 {
-                    if( m_primitives[node->primitivesOffset + i]->Intersect( aRay, aHitInfo ) )
-                    {
-                        aHitInfo.m_acc_node_info = nodeNum;
-                        hit = true;
-                    }
+                    aHitInfo.m_acc_node_info = nodeNum;
+                    hit = true;
                 }
             }
-            else
+
+            continue;
+        }
+
+        float        tNear[4];
+        unsigned int mask = intersectWideNode( m_wideNodes[item.child], aRay, aHitInfo.m_tHit,
+                                               tNear );
+
+        if( !mask )
+            continue;
+
+        // Push the children hit farthest first, so that the nearest one is visited next
+        int order[4];
+        int count = 0;
+
+        for( int i = 0; i < 4; ++i )
+        {
+            if( mask & ( 1 << i ) )
             {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
+                int j = count++;
 
-                continue;
+                for( ; j > 0 && tNear[order[j - 1]] < tNear[i]; --j )
+                    order[j] = order[j - 1];
+
+                order[j] = i;
             }
         }
 
-        if( todoOffset == 0 )
-            break;
+        wxASSERT( todoOffset + count <= MAX_WIDE_TODOS );
 
-        nodeNum = todo[--todoOffset];
+        for( int j = 0; j < count; ++j )
+            todo[todoOffset++] = { m_wideNodes[item.child].children[order[j]], tNear[order[j]] };
     }
 
     return hit;
@@ -1194,60 +1394,48 @@ bool BVH_PBRT::Intersect( const RAY& aRay, HITINFO& aHitInfo, unsigned int aAccN
 
 bool BVH_PBRT::IntersectP( const RAY& aRay, float aMaxDistance ) const
 {
-    if( !m_nodes )
+    if( m_wideNodes.empty() )
         return false;
 
-    // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
+    // Follow ray through BVH nodes to find primitive intersections.  Any hit will do, so
+    // the children are visited in no particular order.
+    int todoOffset = 0;
+    int todo[MAX_WIDE_TODOS];
 
-    while( true )
-    {
-        const LinearBVHNode* node = &m_nodes[nodeNum];
-
-        wxASSERT( todoOffset < MAX_TODOS );
+    todo[todoOffset++] = 0;
 
-        // Check ray against BVH node
-        float hitBox = 0.0f;
-
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
+    while( todoOffset > 0 )
+    {
+        const int child = todo[--todoOffset];
 
-        if( hitted && ( hitBox < aMaxDistance ) )
+        if( child < 0 )
         {
-            if( node->nPrimitives > 0 )
-            {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
-                {
-                    const OBJECT_3D* obj = m_primitives[node->primitivesOffset + i];
+            const LinearBVHNode& node = m_nodes[~child];
 
-                    if( obj->GetMaterial()->GetCastShadows()
-                      && obj->IntersectP( aRay, aMaxDistance ) )
-                        return true;
-                }
-            }
-            else
+            // Intersect ray with primitives in leaf BVH node
+            for( int i = 0; i < node.nPrimitives; ++i )
             {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
+                const OBJECT_3D* obj = m_primitives[node.primitivesOffset + i];
 
-                continue;
+                if( obj->GetMaterial()->GetCastShadows()
+                  && obj->IntersectP( aRay, aMaxDistance ) )
+                    return true;
             }
+
+            continue;
         }
 
-        if( todoOffset == 0 )
-            break;
+        const LinearBVHNode4& wideNode = m_wideNodes[child];
+        float                 tNear[4];
+        unsigned int          mask = intersectWideNode( wideNode, aRay, aMaxDistance, tNear );
 
-        nodeNum = todo[--todoOffset];
+        wxASSERT( todoOffset + 4 <= MAX_WIDE_TODOS );
+
+        for( int i = 0; i < 4; ++i )
+        {
+            if( mask & ( 1 << i ) )
+                todo[todoOffset++] = wideNode.children[i];
+        }
     }
 
     return false;
@@ -73,6 +73,7 @@
 #include "accelerator_3d.h"
 #include <cstdint>
 #include <list>
+#include <vector>
 
 // Forward Declarations
 struct BVHBuildNode;
@@ -98,6 +99,23 @@ struct LinearBVHNode
 };
 
 
+/**
+ * A node of the 4-wide BVH used by single ray traversal, made by collapsing levels of the
+ * binary BVH.
+ *
+ * The child bounds are stored per axis so that a ray can be tested against the four children
+ * at once.
+ */
+struct alignas( 16 ) LinearBVHNode4
+{
+    float bounds[2][3][4];  ///< [min, max][x, y, z][child]
+
+    /// Interior child: index of its wide node.  Leaf child: ~index of its binary leaf node.
+    int   children[4];
+    int   nChildren;
+};
+
+
 enum class SPLITMETHOD
 {
     MIDDLE,
@@ -138,12 +156,21 @@ private:
 
     int flattenBVHTree( BVHBuildNode* node, uint32_t* offset );
 
+    /**
+     * Build the wide nodes below the binary interior node \a aNode.
+     *
+     * @return the index of the wide node of \a aNode.
+     */
+    int flattenWideBVHTree( int aNode );
+
     // BVH Private Data
     const int           m_maxPrimsInNode;
     SPLITMETHOD         m_splitMethod;
     CONST_VECTOR_OBJECT m_primitives;
     LinearBVHNode*      m_nodes;
 
+    std::vector<LinearBVHNode4> m_wideNodes;
+
     std::list<void*>    m_nodesToFree;
 
     // Partition traversal
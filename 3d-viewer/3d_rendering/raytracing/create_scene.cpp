@@ -368,6 +368,7 @@ void RENDER_3D_RAYTRACE_BASE::Reload( REPORTER* aStatusReporter, REPORTER* aWarn
     m_reloadRequested = false;
 
     m_modelMaterialMap.clear();
+    m_modelMeshMap.clear();
 
     OBJECT_2D_STATS::Instance().ResetStats();
     OBJECT_3D_STATS::Instance().ResetStats();
@@ -796,6 +797,9 @@ void RENDER_3D_RAYTRACE_BASE::Reload( REPORTER* aStatusReporter, REPORTER* aWarn
 
     load3DModels( m_objectContainer, aOnlyLoadCopperAndShapes );
 
+    // The triangles hold their own transformed copies of the scaled meshes
+    m_modelMeshMap.clear();
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     int64_t stats_endLoad3DmodelsTime = GetRunningMicroSecs();
 #endif
@@ -1223,6 +1227,9 @@ void RENDER_3D_RAYTRACE_BASE::load3DModels( CONTAINER_3D& aDstContainer,
         return;
     }
 
+    // Read the cached models concurrently before going through the footprints
+    m_boardAdapter.Preload3dModels();
+
     // Go for all footprints
     for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
     {
@@ -1314,11 +1321,10 @@ void RENDER_3D_RAYTRACE_BASE::load3DModels( CONTAINER_3D& aDstContainer,
                             (float) -( model.m_Rotation.x / 180.0f ) * glm::pi<float>(),
                             SFVEC3F( 1.0f, 0.0f, 0.0f ) );
 
-                    modelMatrix = glm::scale( modelMatrix,
-                            SFVEC3F( model.m_Scale.x, model.m_Scale.y, model.m_Scale.z ) );
-
-                    addModels( aDstContainer, modelPtr, modelMatrix, (float) model.m_Opacity,
-                               aSkipMaterialInformation, fp );
+                    // The model scale is applied once per model by the mesh cache
+                    addModels( aDstContainer, modelPtr, modelMatrix,
+                               SFVEC3F( model.m_Scale.x, model.m_Scale.y, model.m_Scale.z ),
+                               (float) model.m_Opacity, aSkipMaterialInformation, fp );
                 }
             }
         }
@@ -1429,8 +1435,81 @@ MODEL_MATERIALS* RENDER_3D_RAYTRACE_BASE::getModelMaterial( const S3DMODEL* a3DM
 }
 
 
+const MODEL_MESHES& RENDER_3D_RAYTRACE_BASE::getModelMeshes( const S3DMODEL* a3DModel,
+                                                             const SFVEC3F& aModelScale )
+{
+    auto key = std::make_tuple( a3DModel, aModelScale.x, aModelScale.y, aModelScale.z );
+    auto it = m_modelMeshMap.find( key );
+
+    if( it != m_modelMeshMap.end() )
+        return it->second;
+
+    MODEL_MESHES& meshes = m_modelMeshMap[key];
+    const bool    cadMode =
+            m_boardAdapter.m_Cfg->m_Render.material_mode == MATERIAL_MODE::CAD_MODE;
+
+    auto toLinear =
+            [&]( const SFVEC3F& aColor ) -> SFVEC3F
+            {
+                if( cadMode )
+                    return ConvertSRGBToLinear( MaterialDiffuseToColorCAD( aColor ) );
+                else
+                    return ConvertSRGBToLinear( aColor );
+            };
+
+    for( unsigned int mesh_i = 0; mesh_i < a3DModel->m_MeshesSize; ++mesh_i )
+    {
+        const SMESH& mesh = a3DModel->m_Meshes[mesh_i];
+
+        // Validate the mesh pointers
+        wxASSERT( mesh.m_Positions != nullptr );
+        wxASSERT( mesh.m_FaceIdx != nullptr );
+        wxASSERT( mesh.m_Normals != nullptr );
+        wxASSERT( mesh.m_FaceIdxSize > 0 );
+        wxASSERT( ( mesh.m_FaceIdxSize % 3 ) == 0 );
+
+        if( ( mesh.m_Positions == nullptr ) || ( mesh.m_Normals == nullptr )
+          || ( mesh.m_FaceIdx == nullptr ) || ( mesh.m_FaceIdxSize == 0 )
+          || ( mesh.m_VertexSize == 0 ) || ( ( mesh.m_FaceIdxSize % 3 ) != 0 )
+          || ( mesh.m_MaterialIdx >= a3DModel->m_MaterialsSize ) )
+        {
+            continue;
+        }
+
+        MODEL_MESH& scaledMesh = meshes.emplace_back();
+
+        scaledMesh.m_Mesh = &mesh;
+        scaledMesh.m_Positions.resize( mesh.m_VertexSize );
+        scaledMesh.m_Normals.resize( mesh.m_VertexSize );
+
+        // Normals transform with the inverse transpose of the scale, which is its inverse
+        for( unsigned int v = 0; v < mesh.m_VertexSize; ++v )
+        {
+            scaledMesh.m_Positions[v] = mesh.m_Positions[v] * aModelScale;
+            scaledMesh.m_Normals[v] = glm::normalize( mesh.m_Normals[v] / aModelScale );
+        }
+
+        if( mesh.m_Color == nullptr )
+        {
+            scaledMesh.m_Colors.push_back(
+                    toLinear( a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse ) );
+        }
+        else
+        {
+            scaledMesh.m_Colors.resize( mesh.m_VertexSize );
+
+            for( unsigned int v = 0; v < mesh.m_VertexSize; ++v )
+                scaledMesh.m_Colors[v] = toLinear( mesh.m_Color[v] );
+        }
+    }
+
+    return meshes;
+}
+
+
 void RENDER_3D_RAYTRACE_BASE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL* a3DModel,
-                                         const glm::mat4& aModelMatrix, float aFPOpacity,
+                                         const glm::mat4& aModelMatrix,
+                                         const SFVEC3F& aModelScale, float aFPOpacity,
                                          bool aSkipMaterialInformation, BOARD_ITEM* aBoardItem )
 {
     // Validate a3DModel pointers
@@ -1462,107 +1541,71 @@ void RENDER_3D_RAYTRACE_BASE::addModels( CONTAINER_3D& aDstContainer, const S3DM
 
         const glm::mat3 normalMatrix = glm::transpose( glm::inverse( glm::mat3( aModelMatrix ) ) );
 
-        for( unsigned int mesh_i = 0; mesh_i < a3DModel->m_MeshesSize; ++mesh_i )
+        for( const MODEL_MESH& scaledMesh : getModelMeshes( a3DModel, aModelScale ) )
         {
-            const SMESH& mesh = a3DModel->m_Meshes[mesh_i];
+            const SMESH&                mesh = *scaledMesh.m_Mesh;
+            float                       fpTransparency;
+            const BLINN_PHONG_MATERIAL* blinn_material;
 
-            // Validate the mesh pointers
-            wxASSERT( mesh.m_Positions != nullptr );
-            wxASSERT( mesh.m_FaceIdx != nullptr );
-            wxASSERT( mesh.m_Normals != nullptr );
-            wxASSERT( mesh.m_FaceIdxSize > 0 );
-            wxASSERT( ( mesh.m_FaceIdxSize % 3 ) == 0 );
+            if( !aSkipMaterialInformation )
+            {
+                blinn_material = &( *materialVector )[mesh.m_MaterialIdx];
 
+                fpTransparency =
+                        1.0f - ( ( 1.0f - blinn_material->GetTransparency() ) * aFPOpacity );
+            }
 
-            if( ( mesh.m_Positions != nullptr ) && ( mesh.m_Normals != nullptr )
-              && ( mesh.m_FaceIdx != nullptr ) && ( mesh.m_FaceIdxSize > 0 )
-              && ( mesh.m_VertexSize > 0 ) && ( ( mesh.m_FaceIdxSize % 3 ) == 0 )
-              && ( mesh.m_MaterialIdx < a3DModel->m_MaterialsSize ) )
+            // Add all face triangles
+            for( unsigned int faceIdx = 0; faceIdx < mesh.m_FaceIdxSize; faceIdx += 3 )
             {
-                float                       fpTransparency;
-                const BLINN_PHONG_MATERIAL* blinn_material;
+                const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
+                const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
+                const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
 
-                if( !aSkipMaterialInformation )
-                {
-                    blinn_material = &( *materialVector )[mesh.m_MaterialIdx];
-
-                    fpTransparency =
-                            1.0f - ( ( 1.0f - blinn_material->GetTransparency() ) * aFPOpacity );
-                }
+                wxASSERT( idx0 < mesh.m_VertexSize );
+                wxASSERT( idx1 < mesh.m_VertexSize );
+                wxASSERT( idx2 < mesh.m_VertexSize );
 
-                // Add all face triangles
-                for( unsigned int faceIdx = 0; faceIdx < mesh.m_FaceIdxSize; faceIdx += 3 )
+                if( ( idx0 < mesh.m_VertexSize ) && ( idx1 < mesh.m_VertexSize )
+                  && ( idx2 < mesh.m_VertexSize ) )
                 {
-                    const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
-                    const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
-                    const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
+                    const SFVEC3F& v0 = scaledMesh.m_Positions[idx0];
+                    const SFVEC3F& v1 = scaledMesh.m_Positions[idx1];
+                    const SFVEC3F& v2 = scaledMesh.m_Positions[idx2];
 
-                    wxASSERT( idx0 < mesh.m_VertexSize );
-                    wxASSERT( idx1 < mesh.m_VertexSize );
-                    wxASSERT( idx2 < mesh.m_VertexSize );
+                    const SFVEC3F& n0 = scaledMesh.m_Normals[idx0];
+                    const SFVEC3F& n1 = scaledMesh.m_Normals[idx1];
+                    const SFVEC3F& n2 = scaledMesh.m_Normals[idx2];
 
-                    if( ( idx0 < mesh.m_VertexSize ) && ( idx1 < mesh.m_VertexSize )
-                      && ( idx2 < mesh.m_VertexSize ) )
-                    {
-                        const SFVEC3F& v0 = mesh.m_Positions[idx0];
-                        const SFVEC3F& v1 = mesh.m_Positions[idx1];
-                        const SFVEC3F& v2 = mesh.m_Positions[idx2];
-
-                        const SFVEC3F& n0 = mesh.m_Normals[idx0];
-                        const SFVEC3F& n1 = mesh.m_Normals[idx1];
-                        const SFVEC3F& n2 = mesh.m_Normals[idx2];
+                    // Transform vertex with the model matrix
+                    const SFVEC3F vt0 = SFVEC3F( aModelMatrix * glm::vec4( v0, 1.0f ) );
+                    const SFVEC3F vt1 = SFVEC3F( aModelMatrix * glm::vec4( v1, 1.0f ) );
+                    const SFVEC3F vt2 = SFVEC3F( aModelMatrix * glm::vec4( v2, 1.0f ) );
 
-                        // Transform vertex with the model matrix
-                        const SFVEC3F vt0 = SFVEC3F( aModelMatrix * glm::vec4( v0, 1.0f ) );
-                        const SFVEC3F vt1 = SFVEC3F( aModelMatrix * glm::vec4( v1, 1.0f ) );
-                        const SFVEC3F vt2 = SFVEC3F( aModelMatrix * glm::vec4( v2, 1.0f ) );
+                    const SFVEC3F nt0 = glm::normalize( SFVEC3F( normalMatrix * n0 ) );
+                    const SFVEC3F nt1 = glm::normalize( SFVEC3F( normalMatrix * n1 ) );
+                    const SFVEC3F nt2 = glm::normalize( SFVEC3F( normalMatrix * n2 ) );
 
-                        const SFVEC3F nt0 = glm::normalize( SFVEC3F( normalMatrix * n0 ) );
-                        const SFVEC3F nt1 = glm::normalize( SFVEC3F( normalMatrix * n1 ) );
-                        const SFVEC3F nt2 = glm::normalize( SFVEC3F( normalMatrix * n2 ) );
+                    TRIANGLE* newTriangle = new TRIANGLE( vt0, vt2, vt1, nt0, nt2, nt1 );
 
-                        TRIANGLE* newTriangle = new TRIANGLE( vt0, vt2, vt1, nt0, nt2, nt1 );
+                    newTriangle->SetBoardItem( aBoardItem );
 
-                        newTriangle->SetBoardItem( aBoardItem );
+                    aDstContainer.Add( newTriangle );
 
-                        aDstContainer.Add( newTriangle );
+                    if( !aSkipMaterialInformation )
+                    {
+                        newTriangle->SetMaterial( blinn_material );
+                        newTriangle->SetModelTransparency( fpTransparency );
 
-                        if( !aSkipMaterialInformation )
+                        if( mesh.m_Color == nullptr )
                         {
-                            newTriangle->SetMaterial( blinn_material );
-                            newTriangle->SetModelTransparency( fpTransparency );
-
-                            if( mesh.m_Color == nullptr )
-                            {
-                                const SFVEC3F diffuseColor =
-                                        a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse;
-
-                                if( m_boardAdapter.m_Cfg->m_Render.material_mode == MATERIAL_MODE::CAD_MODE )
-                                    newTriangle->SetColor( ConvertSRGBToLinear(
-                                            MaterialDiffuseToColorCAD( diffuseColor ) ) );
-                                else
-                                    newTriangle->SetColor( ConvertSRGBToLinear( diffuseColor ) );
-                            }
-                            else
-                            {
-                                if( m_boardAdapter.m_Cfg->m_Render.material_mode == MATERIAL_MODE::CAD_MODE )
-                                {
-                                    newTriangle->SetColor(
-                                            ConvertSRGBToLinear( MaterialDiffuseToColorCAD(
-                                                    mesh.m_Color[idx0] ) ),
-                                            ConvertSRGBToLinear( MaterialDiffuseToColorCAD(
-                                                    mesh.m_Color[idx1] ) ),
-                                            ConvertSRGBToLinear( MaterialDiffuseToColorCAD(
-                                                    mesh.m_Color[idx2] ) ) );
-                                }
-                                else
-                                {
-                                    newTriangle->SetColor(
-                                            ConvertSRGBToLinear( mesh.m_Color[idx0] ),
-                                            ConvertSRGBToLinear( mesh.m_Color[idx1] ),
-                                            ConvertSRGBToLinear( mesh.m_Color[idx2] ) );
-                                }
-                            }
+                            newTriangle->SetColor( scaledMesh.m_Colors[0] );
+                        }
+                        else
+                        {
+                            newTriangle->SetColor( scaledMesh.m_Colors[idx0],
+                                                   scaledMesh.m_Colors[idx1],
+                                                   scaledMesh.m_Colors[idx2] );
                         }
                     }
                 }
@@ -25,7 +25,6 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <thread>
 
 #include "render_3d_raytrace_base.h"
 #include "mortoncodes.h"
@@ -108,6 +107,7 @@ RENDER_3D_RAYTRACE_BASE::RENDER_3D_RAYTRACE_BASE( BOARD_ADAPTER& aAdapter, CAMER
 
     m_is_canvas_initialized = false;
     m_isPreview = false;
+    m_offlineRender = false;
     m_renderState = RT_RENDER_STATE_MAX; // Set to an initial invalid state
     m_renderStartTime = 0;
     m_blockRenderProgressCount = 0;
@@ -266,6 +266,9 @@ void RENDER_3D_RAYTRACE_BASE::renderTracing( uint8_t* ptrPBO, REPORTER* aStatusR
                 numBlocksRendered++;
             }
 
+            if( m_offlineRender )
+                continue;
+
             auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now() - startTime );
 
@@ -480,6 +483,10 @@ void RENDER_3D_RAYTRACE_BASE::renderAntiAliasPackets( const SFVEC4F* aBgColorY,
 
 #define DISP_FACTOR 0.075f
 
+// Largest difference of a color component between the two first samples of a pixel for which
+// an offline render considers the pixel smooth enough to skip the other anti-aliasing samples
+#define AA_ADAPTIVE_THRESHOLD ( 1.0f / 512.0f )
+
 
 void RENDER_3D_RAYTRACE_BASE::renderBlockTracing( uint8_t* ptrPBO, signed int iBlock )
 {
@@ -588,6 +595,7 @@ void RENDER_3D_RAYTRACE_BASE::renderBlockTracing( uint8_t* ptrPBO, signed int iB
         SFVEC4F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
         SFVEC4F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
         SFVEC4F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+        bool    blockIsSmooth = m_offlineRender;
 
         for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
         {
@@ -596,32 +604,46 @@ void RENDER_3D_RAYTRACE_BASE::renderBlockTracing( uint8_t* ptrPBO, signed int iB
             hitColor_AA_X1Y0[i] = color_average;
             hitColor_AA_X0Y1[i] = color_average;
             hitColor_AA_X0Y1_half[i] = color_average;
+
+            if( blockIsSmooth )
+            {
+                SFVEC4F delta = glm::abs( hitColor_X0Y0[i] - hitColor_AA_X1Y1[i] );
+
+                if( std::max( { delta.r, delta.g, delta.b, delta.a } ) > AA_ADAPTIVE_THRESHOLD )
+                    blockIsSmooth = false;
+            }
         }
 
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
+        // Skip the remaining samples of smooth blocks.  They start from the average of the
+        // first two samples, so the result is the same as if they found nothing new.
+        if( !blockIsSmooth )
+        {
+            RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
 
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f - DISP_FACTOR, DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y0 );
+            RAYPACKET_InitRays_with2DDisplacement(
+                    m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f - DISP_FACTOR, DISP_FACTOR ),
+                    SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y0 );
 
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( DISP_FACTOR, 0.5f - DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X0Y1 );
+            RAYPACKET_InitRays_with2DDisplacement(
+                    m_camera, (SFVEC2F) blockPosI + SFVEC2F( DISP_FACTOR, 0.5f - DISP_FACTOR ),
+                    SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X0Y1 );
 
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y1_half );
+            RAYPACKET_InitRays_with2DDisplacement(
+                    m_camera,
+                    (SFVEC2F) blockPosI + SFVEC2F( 0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR ),
+                    SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y1_half );
 
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X1Y0,
-                                hitColor_AA_X1Y0 );
+            renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                    blockRayPck_AA_X1Y0, hitColor_AA_X1Y0 );
 
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X0Y1,
-                                hitColor_AA_X0Y1 );
+            renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                    blockRayPck_AA_X0Y1, hitColor_AA_X0Y1 );
 
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                                blockRayPck_AA_X1Y1_half, hitColor_AA_X0Y1_half );
+            renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                    blockRayPck_AA_X1Y1_half, hitColor_AA_X0Y1_half );
+        }
 
         // Average the result
         for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
@@ -701,35 +723,24 @@ void RENDER_3D_RAYTRACE_BASE::postProcessShading( uint8_t* /* ptrPBO */, REPORTE
 
         m_postShaderSsao.SetShadowsEnabled( m_boardAdapter.m_Cfg->m_Render.raytrace_shadows );
 
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+        thread_pool& tp = GetKiCadThreadPool();
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        auto results = tp.parallelize_loop( m_realBufferSize.y,
+                [&]( const int a, const int b )
                 {
-                    SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
-
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                    for( int y = a; y < b; ++y )
                     {
-                        *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
-                        ptr++;
-                    }
-                }
+                        SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
+                        for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                        {
+                            *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
+                            ptr++;
+                        }
+                    }
+                } );
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        results.wait();
 
         m_postShaderSsao.SetShadedBuffer( m_shaderBuffer );
 
@@ -750,48 +761,38 @@ void RENDER_3D_RAYTRACE_BASE::postProcessBlurFinish( uint8_t* ptrPBO,
     if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
     {
         // Now blurs the shader result and compute the final color
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+        thread_pool& tp = GetKiCadThreadPool();
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        auto results = tp.parallelize_loop( m_realBufferSize.y,
+                [&]( const int a, const int b )
                 {
-                    uint8_t* ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
-
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                    for( int y = a; y < b; ++y )
                     {
-                        const SFVEC3F bluredShadeColor = m_postShaderSsao.Blur( SFVEC2I( x, y ) );
+                        uint8_t* ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
+
+                        for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                        {
+                            const SFVEC3F bluredShadeColor =
+                                    m_postShaderSsao.Blur( SFVEC2I( x, y ) );
 
 #ifdef USE_SRGB_SPACE
-                        const SFVEC4F originColor = convertLinearToSRGBA(
-                                m_postShaderSsao.GetColorAtNotProtected( SFVEC2I( x, y ) ) );
+                            const SFVEC4F originColor = convertLinearToSRGBA(
+                                    m_postShaderSsao.GetColorAtNotProtected( SFVEC2I( x, y ) ) );
 #else
-                        const SFVEC4F originColor =
-                                m_postShaderSsao.GetColorAtNotProtected( SFVEC2I( x, y ) );
+                            const SFVEC4F originColor =
+                                    m_postShaderSsao.GetColorAtNotProtected( SFVEC2I( x, y ) );
 #endif
-                        const SFVEC4F shadedColor = m_postShaderSsao.ApplyShadeColor(
-                                SFVEC2I( x, y ), originColor, bluredShadeColor );
+                            const SFVEC4F shadedColor = m_postShaderSsao.ApplyShadeColor(
+                                    SFVEC2I( x, y ), originColor, bluredShadeColor );
 
-                        renderFinalColor( ptr, shadedColor, false );
+                            renderFinalColor( ptr, shadedColor, false );
 
-                        ptr += 4;
+                            ptr += 4;
+                        }
                     }
-                }
+                } );
 
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        results.wait();
 
         // Debug code
         //m_postShaderSsao.DebugBuffersOutputAsImages();
@@ -810,16 +811,16 @@ void RENDER_3D_RAYTRACE_BASE::renderPreview( uint8_t* ptrPBO )
     m_backgroundColorBottom =
             ConvertSRGBAToLinear( premultiplyAlpha( m_boardAdapter.m_BgColorBot ) );
 
-    std::atomic<size_t> nextBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+    thread_pool&           tp = GetKiCadThreadPool();
+    std::atomic<size_t>    nextBlock( 0 );
+    BS::multi_future<void> futures;
 
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
+    size_t parallelThreadCount = std::min<size_t>( tp.get_thread_count(),
+                                                   m_blockPositions.size() );
 
     for( size_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        std::thread t = std::thread( [&]()
+        futures.push_back( tp.submit( [&]()
         {
             for( size_t iBlock = nextBlock.fetch_add( 1 ); iBlock < m_blockPositionsFast.size();
                  iBlock = nextBlock.fetch_add( 1 ) )
@@ -1395,15 +1396,10 @@ void RENDER_3D_RAYTRACE_BASE::renderPreview( uint8_t* ptrPBO )
                     }
                 }
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
+        } ) );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    futures.wait();
 }
 
 
@@ -1781,6 +1777,35 @@ void RENDER_3D_RAYTRACE_BASE::initializeBlockPositions()
 }
 
 
+void RENDER_3D_RAYTRACE_BASE::initializeTileBlockPositions( const SFVEC2UI& aOrigin,
+                                                            const SFVEC2UI& aSize )
+{
+    m_realBufferSize.x = ( aSize.x + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK;
+    m_realBufferSize.y = ( aSize.y + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK;
+    m_fastPreviewModeSize = m_realBufferSize;
+
+    m_xoffset = aOrigin.x;
+    m_yoffset = aOrigin.y;
+
+    m_postShaderSsao.UpdateSize( m_realBufferSize );
+
+    // Tiles are only traced offline, the order of the blocks doesn't matter
+    m_blockPositionsFast.clear();
+    m_blockPositions.clear();
+
+    for( unsigned int y = 0; y < m_realBufferSize.y; y += RAYPACKET_DIM )
+    {
+        for( unsigned int x = 0; x < m_realBufferSize.x; x += RAYPACKET_DIM )
+            m_blockPositions.emplace_back( x, y );
+    }
+
+    delete[] m_shaderBuffer;
+    m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
+
+    initPbo();
+}
+
+
 BOARD_ITEM* RENDER_3D_RAYTRACE_BASE::IntersectBoardItem( const RAY& aRay )
 {
     HITINFO hitInfo;
@@ -34,6 +34,7 @@
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <tuple>
 
 /// Vector of materials.
 typedef std::vector< BLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -41,6 +42,23 @@ typedef std::vector< BLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a #S3DMODEL pointer with a created BLINN_PHONG_MATERIAL vector.
 typedef std::map< const S3DMODEL* , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+/// A #SMESH with the footprint model scale applied and its colors converted to linear space.
+struct MODEL_MESH
+{
+    const SMESH*         m_Mesh;
+    std::vector<SFVEC3F> m_Positions;   ///< Scaled vertex positions.
+    std::vector<SFVEC3F> m_Normals;     ///< Normalized normals of the scaled mesh.
+    std::vector<SFVEC3F> m_Colors;      ///< One color per vertex, or a single diffuse color.
+};
+
+/// Vector of the valid meshes of a model.
+typedef std::vector< MODEL_MESH > MODEL_MESHES;
+
+/// Maps a #S3DMODEL pointer and a model scale to its scaled meshes, shared by all the
+/// footprints using the same model at the same scale.
+typedef std::map< std::tuple<const S3DMODEL*, float, float, float>, MODEL_MESHES >
+        MAP_MODEL_MESHES;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -112,13 +130,23 @@ protected:
     void insertHole( const PAD* aPad );
     void load3DModels( CONTAINER_3D& aDstContainer, bool aSkipMaterialInformation );
     void addModels( CONTAINER_3D& aDstContainer, const S3DMODEL* a3DModel,
-                    const glm::mat4& aModelMatrix, float aFPOpacity,
+                    const glm::mat4& aModelMatrix, const SFVEC3F& aModelScale, float aFPOpacity,
                     bool aSkipMaterialInformation, BOARD_ITEM* aBoardItem );
 
     MODEL_MATERIALS* getModelMaterial( const S3DMODEL* a3DModel );
+    const MODEL_MESHES& getModelMeshes( const S3DMODEL* a3DModel, const SFVEC3F& aModelScale );
 
     void initializeBlockPositions();
 
+    /**
+     * Set up the buffers and blocks to trace only a part of the window.
+     *
+     * @param aOrigin is the window position of the first pixel of the buffer.
+     * @param aSize is the size of the part to trace.  It is rounded up to a whole number of
+     *              ray packets.
+     */
+    void initializeTileBlockPositions( const SFVEC2UI& aOrigin, const SFVEC2UI& aSize );
+
     void render( uint8_t* ptrPBO, REPORTER* aStatusReporter );
     void renderPreview( uint8_t* ptrPBO );
 
@@ -147,6 +175,10 @@ protected:
     bool m_is_canvas_initialized;
     bool m_isPreview;
 
+    /// Rendering an image file rather than an interactive view: tracing is not split into
+    /// time slices and anti-aliasing samples are only added to blocks that need them.
+    bool m_offlineRender;
+
     /// State used on quality render
     RT_RENDER_STATE m_renderState;
 
@@ -204,6 +236,9 @@ protected:
     /// Stores materials of the 3D models
     MAP_MODEL_MATERIALS m_modelMaterialMap;
 
+    /// Stores the scaled meshes of the 3D models while the scene is being built
+    MAP_MODEL_MESHES m_modelMeshMap;
+
     // Statistics
     unsigned int m_convertedDummyBlockCount;
     unsigned int m_converted2dRoundSegmentCount;
@@ -24,9 +24,18 @@
  */
 
 #include "render_3d_raytrace_ram.h"
+#include <algorithm>
+#include <cstring>
 #include <wx/log.h>
 
 
+/**
+ * Distance, in pixels, up to which the SSAO shader and its blur read the neighbors of a pixel.
+ * Tiles are traced this much larger than their visible part when post processing is enabled.
+ */
+static constexpr unsigned int TILE_POST_PROCESS_MARGIN = 20 * RAYPACKET_DIM;
+
+
 RENDER_3D_RAYTRACE_RAM::RENDER_3D_RAYTRACE_RAM( BOARD_ADAPTER& aAdapter, CAMERA& aCamera ) :
         RENDER_3D_RAYTRACE_BASE( aAdapter, aCamera ),
     m_outputBuffer( nullptr ),
@@ -150,6 +159,153 @@ bool RENDER_3D_RAYTRACE_RAM::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
 }
 
 
+void RENDER_3D_RAYTRACE_RAM::LoadScene( REPORTER* aStatusReporter, REPORTER* aWarningReporter )
+{
+    // The buffers are left to the render, a tiled render doesn't need them for the full window
+    m_canvasInitialized = true;
+
+    if( m_reloadRequested )
+    {
+        if( aStatusReporter )
+            aStatusReporter->Report( _( "Loading..." ) );
+
+        Reload( aStatusReporter, aWarningReporter, false );
+    }
+}
+
+
+void RENDER_3D_RAYTRACE_RAM::RenderView( REPORTER* aStatusReporter )
+{
+    LoadScene( aStatusReporter, nullptr );
+
+    if( m_windowSize != m_oldWindowsSize )
+    {
+        m_oldWindowsSize = m_windowSize;
+        initializeBlockPositions();
+    }
+
+    if( !m_outputBuffer )
+        return;
+
+    // The camera has been set up by the caller, there is nothing to redraw for its changes
+    m_camera.ParametersChanged();
+
+    std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
+
+    m_offlineRender = true;
+    m_renderState = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( m_outputBuffer, aStatusReporter );
+    } while( m_renderState != RT_RENDER_STATE_FINISH );
+
+    m_offlineRender = false;
+}
+
+
+wxSize RENDER_3D_RAYTRACE_RAM::GetTiledImageSize() const
+{
+    return wxSize( m_windowSize.x & RAYPACKET_INVMASK, m_windowSize.y & RAYPACKET_INVMASK );
+}
+
+
+unsigned int RENDER_3D_RAYTRACE_RAM::GetMinTileSize() const
+{
+    if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
+        return 2 * TILE_POST_PROCESS_MARGIN;
+
+    return RAYPACKET_DIM;
+}
+
+
+bool RENDER_3D_RAYTRACE_RAM::RenderViewTiled(
+        unsigned int aTileSize,
+        const std::function<bool( const uint8_t* aBand, unsigned int aRows )>& aBandWriter,
+        REPORTER* aStatusReporter )
+{
+    LoadScene( aStatusReporter, nullptr );
+
+    // The camera has no rays outside of the window, so with whole ray packet tiles and margins
+    // no tile buffer can go past it
+    const wxSize       imageSize = GetTiledImageSize();
+    const unsigned int width = std::max( imageSize.x, 0 );
+    const unsigned int height = std::max( imageSize.y, 0 );
+    const SFVEC2UI     imageOrigin( ( m_windowSize.x - width ) / 2,
+                                    ( m_windowSize.y - height ) / 2 );
+    const unsigned int tileSize = std::max( aTileSize & RAYPACKET_INVMASK, GetMinTileSize() );
+    const unsigned int margin = m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing
+                                        ? TILE_POST_PROCESS_MARGIN
+                                        : 0;
+
+    if( width == 0 || height == 0 )
+        return false;
+
+    m_camera.ParametersChanged();
+
+    std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
+    std::vector<uint8_t>            band( (size_t) width * std::min( tileSize, height ) * 4 );
+
+    const unsigned int tilesX = ( width + tileSize - 1 ) / tileSize;
+    const unsigned int tilesY = ( height + tileSize - 1 ) / tileSize;
+    bool               success = true;
+
+    m_offlineRender = true;
+
+    // Row 0 of the buffers is the bottom of the image, the bands are written from the top
+    for( unsigned int ty = 0; ty < tilesY && success; ++ty )
+    {
+        const unsigned int rows = std::min( tileSize, height - ty * tileSize );
+        const unsigned int y0 = height - ty * tileSize - rows;
+
+        for( unsigned int tx = 0; tx < tilesX; ++tx )
+        {
+            if( aStatusReporter )
+            {
+                aStatusReporter->Report( wxString::Format( _( "Rendering tile %u of %u" ),
+                                                           ty * tilesX + tx + 1,
+                                                           tilesX * tilesY ) );
+            }
+
+            const unsigned int x0 = tx * tileSize;
+            const unsigned int cols = std::min( tileSize, width - x0 );
+
+            const SFVEC2UI origin( x0 > margin ? x0 - margin : 0,
+                                   y0 > margin ? y0 - margin : 0 );
+            const SFVEC2UI end( std::min( x0 + cols + margin, width ),
+                                std::min( y0 + rows + margin, height ) );
+
+            initializeTileBlockPositions( imageOrigin + origin, end - origin );
+
+            m_renderState = RT_RENDER_STATE_MAX;
+
+            do
+            {
+                render( m_outputBuffer, nullptr );
+            } while( m_renderState != RT_RENDER_STATE_FINISH );
+
+            for( unsigned int y = 0; y < rows; ++y )
+            {
+                const uint8_t* src = &m_outputBuffer[( ( y0 + y - origin.y ) * m_realBufferSize.x
+                                                       + ( x0 - origin.x ) ) * 4];
+                uint8_t*       dst = &band[( (size_t) ( rows - 1 - y ) * width + x0 ) * 4];
+
+                memcpy( dst, src, cols * 4 );
+            }
+        }
+
+        success = aBandWriter( band.data(), rows );
+    }
+
+    m_offlineRender = false;
+
+    // The buffers only hold the last tile, a later render must set them up again
+    m_oldWindowsSize = wxSize( 0, 0 );
+
+    return success;
+}
+
+
 void RENDER_3D_RAYTRACE_RAM::initPbo()
 {
     deletePbo();
@@ -28,6 +28,8 @@
 
 #include "render_3d_raytrace_base.h"
 
+#include <functional>
+
 
 class RENDER_3D_RAYTRACE_RAM : public RENDER_3D_RAYTRACE_BASE
 {
@@ -46,6 +48,54 @@ public:
     void SetCurWindowSize( const wxSize& aSize ) override;
     bool Redraw( bool aIsMoving, REPORTER* aStatusReporter, REPORTER* aWarningReporter ) override;
 
+    /**
+     * Build the scene if it isn't built yet.  The camera's board look at position is only
+     * known once this is done.  The render buffers are allocated by the first render.
+     */
+    void LoadScene( REPORTER* aStatusReporter, REPORTER* aWarningReporter );
+
+    /**
+     * Render the final image for the current camera position into the buffer.
+     *
+     * Unlike Redraw(), there is no preview and the tracing isn't split into time slices for
+     * an interactive view.  The scene is kept, so several views can be rendered from one scene
+     * by moving the camera between calls.
+     */
+    void RenderView( REPORTER* aStatusReporter );
+
+    /**
+     * @return the size of the image rendered by RenderViewTiled(): the window size rounded down
+     *         to whole ray packets.
+     */
+    wxSize GetTiledImageSize() const;
+
+    /**
+     * @return the smallest tile side used by RenderViewTiled().  With post processing, a tile
+     *         is traced with a margin on each side, and smaller tiles would spend most of their
+     *         time tracing the margins.
+     */
+    unsigned int GetMinTileSize() const;
+
+    /**
+     * Render the final image for the current camera position in square tiles, so that only
+     * one tile and one band of tiles of the image are held in memory at a time.
+     *
+     * Each tile is traced with a margin wide enough for the post processing shader to see the
+     * same neighborhood as in a full frame render.  The image is GetTiledImageSize(), centered
+     * in the window.
+     *
+     * @param aTileSize is the tile side, in pixels.  It is rounded down to whole ray packets,
+     *                  and raised to GetMinTileSize().
+     * @param aBandWriter is called for each band of tiles, from the top of the image to the
+     *                    bottom, with \a aRows RGBA rows of the image width, top row first.
+     *                    Returning false stops the render.
+     * @return false if \a aBandWriter failed.
+     */
+    bool RenderViewTiled( unsigned int aTileSize,
+                          const std::function<bool( const uint8_t* aBand,
+                                                    unsigned int aRows )>& aBandWriter,
+                          REPORTER* aStatusReporter );
+
 private:
     void initPbo() override;
     void deletePbo() override;
@@ -71,7 +71,8 @@ JOB_EXPORT_PCB_DRILL::JOB_EXPORT_PCB_DRILL() :
         m_mapFormat( MAP_FORMAT::PDF ),
         m_gerberPrecision( 5 ),
         m_generateMap( false ),
-        m_generateTenting( false )
+        m_generateTenting( false ),
+        m_optimizeHoleOrder( false )
 {
     m_params.emplace_back( new JOB_PARAM<bool>( "excellon.mirror_y",
                                                 &m_excellonMirrorY,
@@ -120,6 +121,10 @@ JOB_EXPORT_PCB_DRILL::JOB_EXPORT_PCB_DRILL() :
     m_params.emplace_back( new JOB_PARAM<int>( "gerber_precision",
                                                &m_gerberPrecision,
                                                m_gerberPrecision ) );
+
+    m_params.emplace_back( new JOB_PARAM<bool>( "optimize_hole_order",
+                                                &m_optimizeHoleOrder,
+                                                m_optimizeHoleOrder ) );
 }
 
 
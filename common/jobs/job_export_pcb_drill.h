@@ -87,6 +87,8 @@ public:
     bool         m_generateMap;
 
     bool         m_generateTenting;
+
+    bool         m_optimizeHoleOrder;   ///< Order holes of each tool for a shorter drill path
 };
 
 #endif
@@ -32,6 +32,7 @@ JOB_EXPORT_PCB_SVG::JOB_EXPORT_PCB_SVG() :
     JOB_EXPORT_PCB_PLOT( JOB_EXPORT_PCB_PLOT::PLOT_FORMAT::SVG, "svg", false ),
     m_fitPageToBoard( false ),
     m_precision( 4 ),
+    m_compact( false ),
     m_genMode( GEN_MODE::SINGLE )   // TODO change to MULTI for V10
 {
     m_plotDrawingSheet = true;
@@ -40,6 +41,7 @@ JOB_EXPORT_PCB_SVG::JOB_EXPORT_PCB_SVG() :
     m_params.emplace_back(
             new JOB_PARAM<bool>( "fit_page_to_board", &m_fitPageToBoard, m_fitPageToBoard ) );
     m_params.emplace_back( new JOB_PARAM<unsigned int>( "precision", &m_precision, m_precision ) );
+    m_params.emplace_back( new JOB_PARAM<bool>( "compact", &m_compact, m_compact ) );
     m_params.emplace_back( new JOB_PARAM<GEN_MODE>( "gen_mode", &m_genMode, m_genMode ) );
 }
 
@@ -37,6 +37,7 @@ public:
 
     bool         m_fitPageToBoard;
     unsigned int m_precision;
+    bool         m_compact;
 
     enum class GEN_MODE
     {
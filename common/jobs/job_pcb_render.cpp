@@ -88,6 +88,8 @@ JOB_PCB_RENDER::JOB_PCB_RENDER() :
     m_params.emplace_back( new JOB_PARAM<QUALITY>( "quality", &m_quality, m_quality ) );
     m_params.emplace_back( new JOB_PARAM<BG_STYLE>( "bg_style", &m_bgStyle, m_bgStyle ) );
     m_params.emplace_back( new JOB_PARAM<SIDE>( "side", &m_side, m_side ) );
+    m_params.emplace_back( new JOB_PARAM_LIST<SIDE>( "extra_sides", &m_extraSides,
+                                                     m_extraSides ) );
 
     m_params.emplace_back( new JOB_PARAM<double>( "zoom", &m_zoom, m_zoom ) );
     m_params.emplace_back( new JOB_PARAM<bool>( "perspective", &m_perspective, m_perspective ) );
@@ -98,6 +100,7 @@ JOB_PCB_RENDER::JOB_PCB_RENDER() :
 
     m_params.emplace_back( new JOB_PARAM<int>( "width", &m_width, m_width ) );
     m_params.emplace_back( new JOB_PARAM<int>( "height", &m_height, m_height ) );
+    m_params.emplace_back( new JOB_PARAM<int>( "tile_size", &m_tileSize, m_tileSize ) );
 
     m_params.emplace_back( new JOB_PARAM<double>( "pivot_x", &m_pivot.x, m_pivot.x ) );
     m_params.emplace_back( new JOB_PARAM<double>( "pivot_y", &m_pivot.y, m_pivot.y ) );
@@ -26,6 +26,7 @@
 #include <wx/string.h>
 #include "job.h"
 #include <optional>
+#include <vector>
 #include <math/vector3.h>
 
 // Defined in wingdi.h
@@ -86,8 +87,18 @@ public:
     BG_STYLE    m_bgStyle = BG_STYLE::DEFAULT;
     int         m_width = 0;
     int         m_height = 0;
+
+    /// When not 0, PNG images are rendered in square tiles of this size and streamed to the
+    /// file, so that the memory used doesn't depend on the image size.
+    int         m_tileSize = 0;
+
     std::string m_appearancePreset;
     SIDE        m_side = SIDE::TOP;
+
+    /// Further sides to render after m_side, from the same scene.  When not empty, each image
+    /// file name gets its side appended.
+    std::vector<SIDE> m_extraSides;
+
     double      m_zoom = 1.0;
     bool        m_perspective = false;
     VECTOR3D    m_rotation;
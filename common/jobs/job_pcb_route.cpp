@@ -0,0 +1,47 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jobs/job_pcb_route.h>
+#include <jobs/job_registry.h>
+#include <i18n_utility.h>
+
+JOB_PCB_ROUTE::JOB_PCB_ROUTE() :
+        JOB( "route", false ),
+        m_filename(),
+        m_exitCodeUnrouted( false )
+{
+    m_params.emplace_back( new JOB_PARAM_LIST<wxString>( "nets", &m_nets, m_nets ) );
+    m_params.emplace_back( new JOB_PARAM<bool>( "exit_code_unrouted", &m_exitCodeUnrouted,
+                                                m_exitCodeUnrouted ) );
+}
+
+
+wxString JOB_PCB_ROUTE::GetDefaultDescription() const
+{
+    return _( "Route unconnected nets" );
+}
+
+
+wxString JOB_PCB_ROUTE::GetSettingsDialogTitle() const
+{
+    return _( "Route Job Settings" );
+}
+
+
+REGISTER_JOB( pcb_route, _HKI( "PCB: Route Unconnected Nets" ), KIWAY::FACE_PCB, JOB_PCB_ROUTE );
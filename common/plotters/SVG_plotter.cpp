@@ -93,6 +93,7 @@
 #include <macros.h>
 #include <trigo.h>
 #include <fmt/format.h>
+#include <mmh3_hash.h>
 
 #include <cstdint>
 #include <wx/mstream.h>
@@ -174,6 +175,8 @@ SVG_PLOTTER::SVG_PLOTTER( const PROJECT* aProject ) :
     m_brush_alpha     = 1.0;
     m_dashed          = LINE_STYLE::SOLID;
     m_precision       = 4;               // default: 4 digits in mantissa.
+    m_compactMode     = false;
+    m_pathOpen        = false;
 }
 
 
@@ -207,6 +210,39 @@ void SVG_PLOTTER::SetSvgCoordinatesFormat( unsigned aPrecision )
 }
 
 
+std::string SVG_PLOTTER::formatCoord( double aValue ) const
+{
+    std::string str = fmt::format( "{:.{}f}", aValue, m_precision );
+
+    if( !m_compactMode )
+        return str;
+
+    // Remove trailing zeros (and the decimal point if no decimal remains)
+    if( str.find( '.' ) != std::string::npos )
+    {
+        str.erase( str.find_last_not_of( '0' ) + 1 );
+
+        if( str.back() == '.' )
+            str.pop_back();
+    }
+
+    if( str == "-0" )
+        str = "0";
+
+    return str;
+}
+
+
+void SVG_PLOTTER::closePath()
+{
+    if( m_pathOpen )
+    {
+        fmt::print( m_outputFile, "\" />\n" );
+        m_pathOpen = false;
+    }
+}
+
+
 void SVG_PLOTTER::setFillMode( FILL_T fill )
 {
     if( m_fillMode != fill )
@@ -297,6 +333,10 @@ void SVG_PLOTTER::setSVGPlotStyle( int aLineWidth, bool aIsGroup, const std::str
         }
     }
 
+    // In compact mode polygons use the group style, so their fill rule is set here
+    if( m_compactMode && m_fillMode != FILL_T::NO_FILL )
+        fmt::print( m_outputFile, "fill-rule:evenodd;" );
+
     if( aExtraStyle.length() )
         fmt::print( m_outputFile, "{}", aExtraStyle );
 
@@ -387,6 +427,7 @@ void SVG_PLOTTER::Rect( const VECTOR2I& p1, const VECTOR2I& p2, FILL_T fill, int
     BOX2D rect_dev( org_dev, size_dev );
     rect_dev.Normalize();
 
+    closePath();
     setFillMode( fill );
     SetCurrentLineWidth( width );
 
@@ -422,6 +463,7 @@ void SVG_PLOTTER::Circle( const VECTOR2I& pos, int diametre, FILL_T fill, int wi
     VECTOR2D pos_dev = userToDeviceCoordinates( pos );
     double   radius  = userToDeviceSize( diametre / 2.0 );
 
+    closePath();
     setFillMode( fill );
     SetCurrentLineWidth( width );
 
@@ -437,6 +479,13 @@ void SVG_PLOTTER::Circle( const VECTOR2I& pos, int diametre, FILL_T fill, int wi
         radius = userToDeviceSize( ( diametre / 2.0 ) + ( width / 2.0 ) );
     }
 
+    if( m_compactMode )
+    {
+        fmt::print( m_outputFile, "<circle cx=\"{}\" cy=\"{}\" r=\"{}\"/>\n",
+                    formatCoord( pos_dev.x ), formatCoord( pos_dev.y ), formatCoord( radius ) );
+        return;
+    }
+
     fmt::print( m_outputFile,
                   "<circle cx=\"{:.{}f}\" cy=\"{:.{}f}\" r=\"{:.{}f}\" /> \n",
                   pos_dev.x, m_precision,
@@ -454,6 +503,8 @@ void SVG_PLOTTER::Arc( const VECTOR2D& aCenter, const EDA_ANGLE& aStartAngle,
      *
      *  The arc is drawn in an anticlockwise direction from the start point to the end point.
      */
+    closePath();
+
     if( aRadius <= 0 )
     {
         Circle( aCenter, aWidth, FILL_T::FILLED_SHAPE, 0 );
@@ -567,6 +618,7 @@ void SVG_PLOTTER::BezierCurve( const VECTOR2I& aStart, const VECTOR2I& aControl1
                                int aTolerance, int aLineThickness )
 {
 #if 1
+    closePath();
     setFillMode( FILL_T::NO_FILL );
     SetCurrentLineWidth( aLineThickness );
 
@@ -601,8 +653,83 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
     if( aCornerList.size() <= 1 )
         return;
 
+    closePath();
     setFillMode( aFill );
     SetCurrentLineWidth( aWidth );
+
+    if( m_compactMode && aFill != FILL_T::HATCH && aFill != FILL_T::REVERSE_HATCH
+            && aFill != FILL_T::CROSS_HATCH )
+    {
+        if( m_graphics_changed )
+            setSVGPlotStyle( GetCurrentLineWidth() );
+
+        // Build the path using coordinates relative to the first point.  Coordinates are
+        // quantized to the current precision before computing the offsets, to avoid
+        // accumulating rounding errors.
+        const double scale = std::pow( 10.0, m_precision );
+        VECTOR2D     first = userToDeviceCoordinates( aCornerList[0] );
+        VECTOR2L     start( std::llround( first.x * scale ), std::llround( first.y * scale ) );
+        VECTOR2L     prev = start;
+        std::string  relPath = "l";
+
+        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
+        {
+            if( ii == aCornerList.size() - 1 && aCornerList.front() == aCornerList.back() )
+                break;
+
+            VECTOR2D pos = userToDeviceCoordinates( aCornerList[ii] );
+            VECTOR2L curr( std::llround( pos.x * scale ), std::llround( pos.y * scale ) );
+
+            relPath += formatCoord( ( curr.x - prev.x ) / scale ) + ' '
+                       + formatCoord( ( curr.y - prev.y ) / scale ) + ' ';
+            prev = curr;
+        }
+
+        if( relPath.back() == ' ' )
+            relPath.pop_back();
+        else
+            relPath.clear();        // no segment
+
+        if( aCornerList.front() == aCornerList.back() )
+            relPath += 'z';
+
+        VECTOR2D origin( start.x / scale, start.y / scale );
+
+        // Small polygons are cheaper to output than to reference
+        const size_t minSharedLength = 64;
+
+        if( relPath.length() >= minSharedLength )
+        {
+            MMH3_HASH hash;
+            hash.add( relPath );
+
+            const HASH_128 key = hash.digest();
+            auto           it = m_sharedPolys.find( key );
+
+            if( it != m_sharedPolys.end() )
+            {
+                // The referenced path has no style of its own, so it inherits the current
+                // style through the <use> element.
+                fmt::print( m_outputFile, "<use xlink:href=\"#p{}\" x=\"{}\" y=\"{}\"/>\n",
+                            it->second.first,
+                            formatCoord( origin.x - it->second.second.x ),
+                            formatCoord( origin.y - it->second.second.y ) );
+                return;
+            }
+
+            int id = m_sharedPolys.size() + 1;
+            m_sharedPolys.emplace( key, std::make_pair( id, origin ) );
+
+            fmt::print( m_outputFile, "<path id=\"p{}\" d=\"M{} {}{}\"/>\n", id,
+                        formatCoord( origin.x ), formatCoord( origin.y ), relPath );
+            return;
+        }
+
+        fmt::print( m_outputFile, "<path d=\"M{} {}{}\"/>\n",
+                    formatCoord( origin.x ), formatCoord( origin.y ), relPath );
+        return;
+    }
+
     fmt::print( m_outputFile, "<path " );
 
     switch( aFill )
@@ -648,6 +775,8 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
 
 void SVG_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double aScaleFactor )
 {
+    closePath();
+
     VECTOR2I pix_size( aImage.GetWidth(), aImage.GetHeight() );
 
     // Requested size (in IUs)
@@ -710,7 +839,11 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
     {
         if( m_penState != 'Z' )
         {
-            fmt::print( m_outputFile, "\" />\n" );
+            // In compact mode, the path is left open to coalesce the next strokes using the
+            // same style.  It is closed by closePath().
+            if( !m_compactMode )
+                fmt::print( m_outputFile, "\" />\n" );
+
             m_penState        = 'Z';
             m_penLastpos.x    = -1;
             m_penLastpos.y    = -1;
@@ -729,11 +862,22 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
             setFillMode( FILL_T::NO_FILL );
 
         if( m_graphics_changed )
+        {
+            closePath();
             setSVGPlotStyle( GetCurrentLineWidth() );
+        }
 
-        fmt::print( m_outputFile, "<path d=\"M{:.{}f} {:.{}f}\n",
-                    pos_dev.x, m_precision,
-                    pos_dev.y, m_precision );
+        if( m_pathOpen )
+        {
+            fmt::print( m_outputFile, "M{} {}\n", formatCoord( pos_dev.x ),
+                        formatCoord( pos_dev.y ) );
+        }
+        else
+        {
+            fmt::print( m_outputFile, "<path d=\"M{} {}\n", formatCoord( pos_dev.x ),
+                        formatCoord( pos_dev.y ) );
+            m_pathOpen = m_compactMode;
+        }
     }
     else if( m_penState != plume || pos != m_penLastpos )
     {
@@ -742,9 +886,8 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
 
         VECTOR2D pos_dev = userToDeviceCoordinates( pos );
 
-        fmt::print( m_outputFile, "L{:.{}f} {:.{}f}\n",
-                    pos_dev.x, m_precision,
-                    pos_dev.y, m_precision );
+        fmt::print( m_outputFile, "L{} {}\n", formatCoord( pos_dev.x ),
+                    formatCoord( pos_dev.y ) );
     }
 
     m_penState    = plume;
@@ -756,6 +899,9 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 {
     wxASSERT( m_outputFile );
 
+    m_pathOpen = false;
+    m_sharedPolys.clear();
+
     std::string header = "<?xml version=\"1.0\" standalone=\"no\"?>\n"
                 " <!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \n"
                 " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\"> \n"
@@ -810,6 +956,7 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 
 bool SVG_PLOTTER::EndPlot()
 {
+    closePath();
     fmt::print( m_outputFile, "</g> \n</svg>\n" );
     fclose( m_outputFile );
     m_outputFile = nullptr;
@@ -833,6 +980,7 @@ void SVG_PLOTTER::Text( const VECTOR2I&        aPos,
                         const KIFONT::METRICS& aFontMetrics,
                         void*                  aData )
 {
+    closePath();
     setFillMode( FILL_T::NO_FILL );
     SetColor( aColor );
     SetCurrentLineWidth( aWidth );
@@ -925,6 +1073,7 @@ void SVG_PLOTTER::Text( const VECTOR2I&        aPos,
         PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify, aWidth,
                        aItalic, aBold, aMultilineAllowed, aFont, aFontMetrics );
 
+        closePath();
         fmt::print( m_outputFile, "</g>" );
     }
 }
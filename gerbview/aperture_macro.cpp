@@ -100,14 +100,12 @@ AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
 }
 
 
-SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
-                                                       const VECTOR2I& aShapePos )
+void APERTURE_MACRO::BuildShape( const D_CODE* aDcode, SHAPE_POLY_SET& aShape )
 {
     SHAPE_POLY_SET holeBuffer;
 
-    m_shape.RemoveAllContours();
-    D_CODE* dcode = aParent->GetDcodeDescr();
-    InitLocalParams( dcode );
+    aShape.RemoveAllContours();
+    InitLocalParams( aDcode );
 
     for( AM_PRIMITIVE& prim_macro : m_primitivesList )
     {
@@ -116,7 +114,7 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
         if( prim_macro.IsAMPrimitiveExposureOn( this ) )
         {
-            prim_macro.ConvertBasicShapeToPolygon( this, m_shape );
+            prim_macro.ConvertBasicShapeToPolygon( this, aShape );
         }
         else
         {
@@ -124,19 +122,27 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                m_shape.BooleanSubtract( holeBuffer );
+                aShape.BooleanSubtract( holeBuffer );
                 holeBuffer.RemoveAllContours();
             }
         }
     }
 
     // Merge and cleanup basic shape polygons
-    m_shape.Simplify();
+    aShape.Simplify();
 
     // A hole can be is defined inside a polygon, or the polygons themselve can create
     // a hole when merged, so we must fracture the polygon to be able to drawn it
     // (i.e link holes by overlapping edges)
-    m_shape.Fracture();
+    aShape.Fracture();
+}
+
+
+SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                                       const VECTOR2I& aShapePos )
+{
+    // The shape in local coordinates only depends on the D_CODE, and is cached by it
+    m_shape = aParent->GetDcodeDescr()->GetMacroShape();
 
     // Move m_shape to the actual draw position:
     for( int icnt = 0; icnt < m_shape.OutlineCount(); icnt++ )
@@ -108,6 +108,17 @@ public:
      */
     double GetLocalParamValue( int aIndex );
 
+    /**
+     * Build the shape of this aperture macro, customized by the parameters of \a aDcode.
+     *
+     * The shape is built in local coordinates, without the flash position and the image
+     * transform.  Use D_CODE::GetMacroShape() to get a cached version of this shape.
+     *
+     * @param aDcode is the D_CODE that uses this aperture macro and defines its parameters.
+     * @param aShape is the buffer that receives the shape.
+     */
+    void BuildShape( const D_CODE* aDcode, SHAPE_POLY_SET& aShape );
+
     /**
      * Calculate the primitive shape for flashed items.
      *
@@ -80,6 +80,16 @@ void D_CODE::Clear_D_CODE_Data()
     m_Rotation   = ANGLE_0;
     m_EdgesCount = 0;
     m_Polygon.RemoveAllContours();
+    ClearShapeCache();
+}
+
+
+void D_CODE::ClearShapeCache()
+{
+    m_macroShape.RemoveAllContours();
+    m_macroShapeValid = false;
+    m_flashedShape.RemoveAllContours();
+    m_flashedShapeValid = false;
 }
 
 
@@ -417,6 +427,75 @@ void D_CODE::ConvertShapeToPolygon( const GERBER_DRAW_ITEM* aParent )
 }
 
 
+const SHAPE_POLY_SET& D_CODE::GetMacroShape()
+{
+    if( !m_macroShapeValid )
+    {
+        m_macroShape.RemoveAllContours();
+
+        if( m_Macro )
+            m_Macro->BuildShape( this, m_macroShape );
+
+        m_macroShapeValid = true;
+    }
+
+    return m_macroShape;
+}
+
+
+const SHAPE_POLY_SET& D_CODE::GetFlashedShape( const GERBER_DRAW_ITEM* aParent,
+                                               bool aTriangulate )
+{
+    // The AB transform is fully defined by the images of the origin and of two unit
+    // vectors, so these points are used as a signature of the transform the cache was
+    // built with.
+    const int unit = gerbIUScale.mmToIU( 100.0 );
+    VECTOR2I  xform[3] = { aParent->GetABPosition( VECTOR2I( 0, 0 ) ),
+                           aParent->GetABPosition( VECTOR2I( unit, 0 ) ),
+                           aParent->GetABPosition( VECTOR2I( 0, unit ) ) };
+
+    if( m_flashedShapeValid
+            && ( xform[0] != m_flashedShapeXform[0] || xform[1] != m_flashedShapeXform[1]
+                 || xform[2] != m_flashedShapeXform[2] ) )
+    {
+        m_flashedShapeValid = false;
+    }
+
+    if( !m_flashedShapeValid )
+    {
+        if( m_ApertType == APT_MACRO )
+        {
+            m_flashedShape = GetMacroShape();
+        }
+        else
+        {
+            if( m_Polygon.OutlineCount() == 0 )
+                ConvertShapeToPolygon( aParent );
+
+            m_flashedShape = m_Polygon;
+        }
+
+        for( int ii = 0; ii < m_flashedShape.OutlineCount(); ii++ )
+        {
+            SHAPE_LINE_CHAIN& outline = m_flashedShape.Outline( ii );
+
+            for( int jj = 0; jj < outline.PointCount(); jj++ )
+                outline.SetPoint( jj, aParent->GetABPosition( outline.CPoint( jj ) ) - xform[0] );
+        }
+
+        for( int ii = 0; ii < 3; ii++ )
+            m_flashedShapeXform[ii] = xform[ii];
+
+        m_flashedShapeValid = true;
+    }
+
+    if( aTriangulate && !m_flashedShape.IsTriangulationUpToDate() )
+        m_flashedShape.CacheTriangulation( false );
+
+    return m_flashedShape;
+}
+
+
 // The helper function for D_CODE::ConvertShapeToPolygon().
 // Add a hole to a polygon
 static void addHoleToPolygon( SHAPE_POLY_SET* aPolygon, APERTURE_DEF_HOLETYPE aHoleShape,
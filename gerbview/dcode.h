@@ -102,6 +102,7 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        ClearShapeCache();
     }
 
     /**
@@ -131,6 +132,7 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        ClearShapeCache();
     }
 
     APERTURE_MACRO* GetMacro() const { return m_Macro; }
@@ -184,6 +186,33 @@ public:
      */
     void ConvertShapeToPolygon( const GERBER_DRAW_ITEM* aParent );
 
+    /**
+     * Return the shape of the aperture macro used by this D_CODE.
+     *
+     * The shape is given in local coordinates (relative to the flash position and without
+     * any image transform).  It only depends on the macro and on the D_CODE parameters, so
+     * it is built once and shared by all items flashed with this D_CODE.
+     */
+    const SHAPE_POLY_SET& GetMacroShape();
+
+    /**
+     * Return the flashed shape of this D_CODE in draw (AB) coordinates, relative to the draw
+     * position of the image origin.
+     *
+     * To draw a flash, the shape only needs to be moved by the AB position of the flash, so
+     * the same shape (and its triangulation) is shared by all items flashed with this D_CODE.
+     * The cache is rebuilt when the image transform of \a aParent changes.
+     *
+     * @param aParent is the #GERBER_DRAW_ITEM being drawn.
+     * @param aTriangulate set to true to also cache the triangulation of the shape.
+     */
+    const SHAPE_POLY_SET& GetFlashedShape( const GERBER_DRAW_ITEM* aParent, bool aTriangulate );
+
+    /**
+     * Clear the cached macro and flashed shapes, when the D_CODE definition is modified.
+     */
+    void ClearShapeCache();
+
     /**
      * Calculate a value that can be used to evaluate the size of text when displaying the
      * D-Code of an item.
@@ -222,6 +251,12 @@ public:
 private:
     APERTURE_MACRO* m_Macro;    ///< no ownership, points to GERBER.m_aperture_macros element.
 
+    SHAPE_POLY_SET  m_macroShape;           ///< Cached macro shape, in local coordinates
+    bool            m_macroShapeValid;
+    SHAPE_POLY_SET  m_flashedShape;         ///< Cached flashed shape, in AB coordinates
+    VECTOR2I        m_flashedShapeXform[3]; ///< AB transform used to build m_flashedShape
+    bool            m_flashedShapeValid;
+
     /**
      * parameters used only when this D_CODE holds a reference to an aperture
      * macro, and these parameters would customize the macro.
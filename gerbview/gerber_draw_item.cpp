@@ -907,7 +907,8 @@ bool GERBER_DRAW_ITEM::HitTest( const VECTOR2I& aRefPos, int aAccuracy ) const
     }
 
     case GBR_SPOT_MACRO:
-        return m_AbsolutePolygon.Contains( VECTOR2I( aRefPos ), -1, aAccuracy );
+        // The macro shape is cached by the D_CODE, in local coordinates
+        return GetDcodeDescr()->GetMacroShape().Contains( ref_pos - m_Start, -1, aAccuracy );
 
     case GBR_SEGMENT:
     case GBR_CIRCLE:
@@ -505,10 +505,7 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
         }
         else    // rectangular hole
         {
-            if( code->m_Polygon.OutlineCount() == 0 )
-                code->ConvertShapeToPolygon( aItem );
-
-            drawPolygon( aItem, code->m_Polygon, aFilled, true );
+            drawFlashedPolygon( aItem, code, aFilled );
         }
 
         break;
@@ -530,10 +527,7 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
         }
         else
         {
-            if( code->m_Polygon.OutlineCount() == 0 )
-                code->ConvertShapeToPolygon( aItem );
-
-            drawPolygon( aItem, code->m_Polygon, aFilled, true );
+            drawFlashedPolygon( aItem, code, aFilled );
         }
         break;
     }
@@ -569,23 +563,14 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
         }
         else
         {
-            if( code->m_Polygon.OutlineCount() == 0 )
-                code->ConvertShapeToPolygon( aItem );
-
-            drawPolygon( aItem, code->m_Polygon, aFilled, true );
+            drawFlashedPolygon( aItem, code, aFilled );
         }
         break;
     }
 
     case GBR_SPOT_POLY:
-        if( code->m_Polygon.OutlineCount() == 0 )
-            code->ConvertShapeToPolygon( aItem );
-
-        drawPolygon( aItem, code->m_Polygon, aFilled, true );
-        break;
-
     case GBR_SPOT_MACRO:
-        drawApertureMacro( aItem, aFilled );
+        drawFlashedPolygon( aItem, code, aFilled );
         break;
 
     default:
@@ -595,29 +580,34 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
 }
 
 
-void GERBVIEW_PAINTER::drawApertureMacro( GERBER_DRAW_ITEM* aParent, bool aFilled )
+void GERBVIEW_PAINTER::drawFlashedPolygon( GERBER_DRAW_ITEM* aItem, D_CODE* aCode,
+                                           bool aFilled )
 {
-    if( aParent->m_AbsolutePolygon.OutlineCount() == 0 )
-    {
-        D_CODE* code = aParent->GetDcodeDescr();
-        APERTURE_MACRO* macro = code->GetMacro();
-        aParent->m_AbsolutePolygon = *macro->GetApertureMacroShape( aParent, aParent->m_Start );
-    }
+    // All the flashes of a D_CODE share the same cached shape (and its triangulation on
+    // OpenGL), so the shape is only built once and each flash is just a translated instance.
+    const SHAPE_POLY_SET& shape = aCode->GetFlashedShape( aItem,
+                                                          aFilled && m_gal->IsOpenGlEngine() );
 
-    SHAPE_POLY_SET& polyset = aParent->m_AbsolutePolygon;
+    if( shape.OutlineCount() == 0 )
+        return;
 
     if( !gvconfig()->m_Display.m_DisplayPolygonsFill )
         m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
 
+    m_gal->Save();
+    m_gal->Translate( aItem->GetABPosition( aItem->m_Start ) );
+
     if( !aFilled )
     {
-        for( int i = 0; i < polyset.OutlineCount(); i++ )
-            m_gal->DrawPolyline( polyset.COutline( i ) );
+        for( int i = 0; i < shape.OutlineCount(); i++ )
+            m_gal->DrawPolyline( shape.COutline( i ) );
     }
     else
     {
-        m_gal->DrawPolygon( polyset );
+        m_gal->DrawPolygon( shape );
     }
+
+    m_gal->Restore();
 }
 
 
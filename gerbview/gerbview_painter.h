@@ -31,6 +31,7 @@
 #include <memory>
 
 
+class D_CODE;
 class EDA_ITEM;
 class GERBER_DRAW_ITEM;
 class GERBER_FILE_IMAGE;
@@ -155,8 +156,11 @@ protected:
     /// Helper to draw a flashed shape (aka spot)
     void drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled );
 
-    /// Helper to draw an aperture macro shape
-    void drawApertureMacro( GERBER_DRAW_ITEM* aParent, bool aFilled );
+    /**
+     * Helper to draw a flashed shape built from the polygon cached by its D_CODE
+     * (aperture macros, regular polygons and shapes with holes).
+     */
+    void drawFlashedPolygon( GERBER_DRAW_ITEM* aItem, D_CODE* aCode, bool aFilled );
 
     /**
      * Get the thickness to draw for a line (e.g. 0 thickness lines get a minimum value).
@@ -134,8 +134,8 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     case APT_MACRO:
         aGbrItem->m_ShapeType = GBR_SPOT_MACRO;
 
-        // Cache the bounding box for aperture macros
-        aGbrItem->GetDcodeDescr()->GetMacro()->GetApertureMacroShape( aGbrItem, aPos );
+        // Build the aperture macro shape, cached by the D_CODE and shared by all its flashes
+        aGbrItem->GetDcodeDescr()->GetMacroShape();
         break;
     }
 }
@@ -349,6 +349,8 @@ public:
      * This does not prevent the models from being cached in memory meaning reopening the 3D
      * viewer in the same project session will not reload model data from disk again.
      *
+     * This also disables the cache of converted STEP and IGES models used by the STEP exporter.
+     *
      * Setting name: "Skip3DModelFileCache"
      * Valid values: 0 or 1
      * Default value: 0
@@ -714,9 +716,9 @@ public:
     double m_MinimumMarkerSeparationDistance;
 
     /**
-     * When updating the net inspector, it either recalculates all nets or iterates through items
-     * one-by-one. This value controls the threshold at which all nets are recalculated rather than
-     * iterating over the items.
+     * When updating the net inspector, it either recalculates all nets or only the nets touched by
+     * the change. This value controls the number of touched nets at which all nets are recalculated
+     * instead.
      *
      * Setting name: "NetInspectorBulkUpdateOptimisationThreshold"
      * Default value: 25
@@ -533,6 +533,12 @@ public:
         // NOP for most plotters. Only for SVG plotter
     }
 
+    /// Enable the compact output mode of the SVG plotter
+    virtual void SetSvgCompactMode( bool aCompact )
+    {
+        // NOP for most plotters. Only for SVG plotter
+    }
+
     /**
      * calling this function allows one to define the beginning of a group
      * of drawing items, for instance in SVG  or Gerber format.
@@ -27,6 +27,9 @@
 
 #include "plotter.h"
 
+#include <hash_128.h>
+#include <unordered_map>
+
 
 /**
  * The PSLIKE_PLOTTER class is an intermediate class to handle common routines for engines
@@ -597,6 +600,16 @@ public:
      */
     virtual void SetSvgCoordinatesFormat( unsigned aPrecision ) override;
 
+    /**
+     * Select the compact output mode, to reduce the size of large SVG files.
+     *
+     * In compact mode, consecutive strokes using the same style are coalesced into a single
+     * path element, polygons repeated at different positions (usually pads) are output once
+     * and then referenced by \<use\> elements, and coordinates are written without trailing
+     * zeros.  The rendering is the same as in normal mode.
+     */
+    virtual void SetSvgCompactMode( bool aCompact ) override { m_compactMode = aCompact; }
+
     /**
      * Calling this function allows one to define the beginning of a group
      * of drawing items (used in SVG format to separate components)
@@ -656,6 +669,18 @@ protected:
      */
     void setFillMode( FILL_T fill );
 
+    /**
+     * Close the path element left open in compact mode to coalesce strokes.
+     */
+    void closePath();
+
+    /**
+     * Format a coordinate or size (in device units) using the current precision.
+     *
+     * In compact mode, trailing zeros are removed.
+     */
+    std::string formatCoord( double aValue ) const;
+
     FILL_T     m_fillMode;          // true if the current contour rect, arc, circle, polygon must
                                     // be filled
     uint32_t   m_pen_rgb_color;     // current rgb color value: each color has a value 0 ... 255,
@@ -670,4 +695,10 @@ protected:
                                     // Use 3-6 (3 means um precision, 6 nm precision) in PcbNew
                                     // 3-4 in other modules (avoid values >4 to avoid overflow)
                                     // see also comment for m_useInch.
+    bool       m_compactMode;       // true to coalesce strokes and share repeated polygons
+    bool       m_pathOpen;          // true if a path element is left open (compact mode only)
+
+    /// Polygons already output in compact mode, keyed by a hash of their path relative to their
+    /// first point.  The value is the id of the path element and the position of its first point.
+    std::unordered_map<HASH_128, std::pair<int, VECTOR2D>> m_sharedPolys;
 };
@@ -41,6 +41,7 @@
 #define ARG_GENERATE_TENTING "--generate-tenting"
 #define ARG_MAP_FORMAT "--map-format"
 #define ARG_DRILL_ORIGIN "--drill-origin"
+#define ARG_OPTIMIZE_HOLE_ORDER "--optimize-hole-order"
 
 
 CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() :
@@ -94,6 +95,10 @@ CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() :
             .help( UTF8STDSTR( _( "Generate a file specifically for tenting" ) ) )
             .flag();
 
+    m_argParser.add_argument( ARG_OPTIMIZE_HOLE_ORDER )
+            .help( UTF8STDSTR( _( "Order the holes of each tool to shorten the drilling path" ) ) )
+            .flag();
+
     m_argParser.add_argument( ARG_MAP_FORMAT )
             .default_value( std::string( "pdf" ) )
             .help( UTF8STDSTR( _( "Valid options: pdf,gerberx2,ps,dxf,svg" ) ) )
@@ -246,6 +251,7 @@ int CLI::PCB_EXPORT_DRILL_COMMAND::doPerform( KIWAY& aKiway )
     drillJob->m_excellonCombinePTHNPTH = !m_argParser.get<bool>( ARG_EXCELLON_SEPARATE_TH );
     drillJob->m_generateMap = m_argParser.get<bool>( ARG_GENERATE_MAP );
     drillJob->m_generateTenting = m_argParser.get<bool>( ARG_GENERATE_TENTING );
+    drillJob->m_optimizeHoleOrder = m_argParser.get<bool>( ARG_OPTIMIZE_HOLE_ORDER );
     drillJob->m_gerberPrecision = m_argParser.get<int>( ARG_GERBER_PRECISION );
 
     if( drillJob->m_gerberPrecision != 5 && drillJob->m_gerberPrecision != 6 )
@@ -32,6 +32,7 @@
 #define ARG_EXCLUDE_DRAWING_SHEET "--exclude-drawing-sheet"
 #define ARG_PAGE_SIZE "--page-size-mode"
 #define ARG_FIT_PAGE_TO_BOARD "--fit-page-to-board"
+#define ARG_COMPACT "--compact"
 #define ARG_MODE_SINGLE "--mode-single"
 #define ARG_MODE_MULTI "--mode-multi"
 
@@ -93,6 +94,11 @@ CLI::PCB_EXPORT_SVG_COMMAND::PCB_EXPORT_SVG_COMMAND() :
             .help( UTF8STDSTR( _( "Fit the page to the board" ) ) )
             .flag();
 
+    m_argParser.add_argument( ARG_COMPACT )
+            .help( UTF8STDSTR( _( "Reduce the file size by merging strokes, sharing repeated "
+                                  "shapes and trimming coordinates" ) ) )
+            .flag();
+
     m_argParser.add_argument( ARG_EXCLUDE_DRAWING_SHEET )
             .help( UTF8STDSTR( _( "No drawing sheet" ) ) )
             .flag();
@@ -142,6 +148,7 @@ int CLI::PCB_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
         wxFprintf( stdout, DEPRECATED_ARD_PLOT_INVISIBLE_TEXT_WARNING );
 
     svgJob->m_fitPageToBoard = m_argParser.get<bool>( ARG_FIT_PAGE_TO_BOARD );
+    svgJob->m_compact = m_argParser.get<bool>( ARG_COMPACT );
 
     // legacy compat, should eliminate this arg eventually
     int legacyPageSizeMode = m_argParser.get<int>( ARG_PAGE_SIZE );
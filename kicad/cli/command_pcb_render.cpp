@@ -28,6 +28,7 @@
 #include <wx/crt.h>
 #include <magic_enum.hpp>
 
+#include <algorithm>
 #include <macros.h>
 #include <wx/tokenzr.h>
 #include "../../3d-viewer/3d_viewer/eda_3d_viewer_settings.h"
@@ -42,6 +43,8 @@
 #define ARG_HEIGHT "--height"
 #define ARG_HEIGHT_SHORT "-h"
 
+#define ARG_TILE_SIZE "--tile-size"
+
 #define ARG_SIDE "--side"
 #define ARG_PRESET "--preset"
 #define ARG_PAN "--pan"
@@ -230,11 +233,23 @@ CLI::PCB_RENDER_COMMAND::PCB_RENDER_COMMAND() : COMMAND( "render" )
             .metavar( "HEIGHT" )
             .help( UTF8STDSTR( _( "Image height" ) ) );
 
+    m_argParser.add_argument( ARG_TILE_SIZE )
+            .default_value( 0 )
+            .scan<'i', int>()
+            .metavar( "SIZE" )
+            .help( UTF8STDSTR( _( "Render PNG images in square tiles of this size, written to "
+                                  "the file as they are finished, to limit the memory used by "
+                                  "very large images. 0 renders the image in one pass. "
+                                  "Tiles are at least 320 pixels wide when rendering with "
+                                  "post processing" ) ) );
+
     m_argParser.add_argument( ARG_SIDE )
             .default_value( std::string( "top" ) )
-            .add_choices( enumChoices<JOB_PCB_RENDER::SIDE>() )
             .metavar( "SIDE" )
-            .help( UTF8STDSTR( wxString::Format( _( "Render from side. Options: %s" ),
+            .help( UTF8STDSTR( wxString::Format( _( "Render from side. Options: %s. Several "
+                                                    "comma-separated sides render one image "
+                                                    "per side, with the side appended to the "
+                                                    "file name" ),
                                                  enumString<JOB_PCB_RENDER::SIDE>() ) ) );
 
     m_argParser.add_argument( ARG_BACKGROUND )
@@ -337,13 +352,45 @@ int CLI::PCB_RENDER_COMMAND::doPerform( KIWAY& aKiway )
 
     renderJob->m_width = m_argParser.get<int>( ARG_WIDTH );
     renderJob->m_height = m_argParser.get<int>( ARG_HEIGHT );
+    renderJob->m_tileSize = m_argParser.get<int>( ARG_TILE_SIZE );
     renderJob->m_zoom = m_argParser.get<double>( ARG_ZOOM );
     renderJob->m_perspective = m_argParser.get<bool>( ARG_PERSPECTIVE );
     renderJob->m_floor = m_argParser.get<bool>( ARG_FLOOR );
     renderJob->m_lightSideElevation = m_argParser.get<int>( ARG_LIGHT_SIDE_ELEVATION );
 
     getToEnum( m_argParser.get<std::string>( ARG_QUALITY ), renderJob->m_quality );
-    getToEnum( m_argParser.get<std::string>( ARG_SIDE ), renderJob->m_side );
+
+    wxString      sideArg = From_UTF8( m_argParser.get<std::string>( ARG_SIDE ) );
+    wxArrayString sideNames = wxSplit( sideArg, ',', 0 );
+
+    std::vector<JOB_PCB_RENDER::SIDE> sides;
+
+    for( wxString& sideName : sideNames )
+    {
+        JOB_PCB_RENDER::SIDE side = JOB_PCB_RENDER::SIDE::TOP;
+
+        if( !getToEnum( std::string( sideName.Trim().Trim( false ).ToUTF8() ), side ) )
+        {
+            wxFprintf( stderr, _( "Invalid side\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        // Each side is written to a file named after it, so a repeated side would overwrite
+        // its own image
+        if( std::find( sides.begin(), sides.end(), side ) != sides.end() )
+        {
+            wxFprintf( stderr, _( "Duplicate side\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        sides.push_back( side );
+    }
+
+    if( !sides.empty() )
+    {
+        renderJob->m_side = sides.front();
+        renderJob->m_extraSides.assign( sides.begin() + 1, sides.end() );
+    }
 
     if( !getToEnum( m_argParser.get<std::string>( ARG_BACKGROUND ), renderJob->m_bgStyle ) )
     {
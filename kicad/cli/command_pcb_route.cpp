@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_route.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_route.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+
+#include <macros.h>
+#include <wx/tokenzr.h>
+
+#define ARG_NETS "--nets"
+#define ARG_EXIT_CODE_UNROUTED "--exit-code-unrouted"
+
+CLI::PCB_ROUTE_COMMAND::PCB_ROUTE_COMMAND() : COMMAND( "route" )
+{
+    addCommonArgs( true, true, false, false );
+    addDefineArg();
+
+    m_argParser.add_description( UTF8STDSTR( _( "Routes the unconnected nets of the PCB with "
+                                                "the interactive router in walkaround mode and "
+                                                "saves the result" ) ) );
+
+    m_argParser.add_argument( ARG_NETS )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Comma separated list of net names to route; all nets when "
+                                  "omitted" ) ) )
+            .metavar( "NETS" );
+
+    m_argParser.add_argument( ARG_EXIT_CODE_UNROUTED )
+            .help( UTF8STDSTR( _( "Return a nonzero exit code if some connections could not "
+                                  "be routed" ) ) )
+            .flag();
+}
+
+
+int CLI::PCB_ROUTE_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_ROUTE> routeJob( new JOB_PCB_ROUTE() );
+
+    routeJob->SetConfiguredOutputPath( m_argOutput );
+    routeJob->m_filename = m_argInput;
+    routeJob->SetVarOverrides( m_argDefineVars );
+    routeJob->m_exitCodeUnrouted = m_argParser.get<bool>( ARG_EXIT_CODE_UNROUTED );
+
+    wxString          nets = From_UTF8( m_argParser.get<std::string>( ARG_NETS ).c_str() );
+    wxStringTokenizer tokenizer( nets, "," );
+
+    while( tokenizer.HasMoreTokens() )
+    {
+        wxString net = tokenizer.GetNextToken().Trim().Trim( false );
+
+        if( !net.IsEmpty() )
+            routeJob->m_nets.push_back( net );
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, routeJob.get() );
+
+    return exitCode;
+}
@@ -52,6 +52,7 @@
 #include "cli/command_pcb_export.h"
 #include "cli/command_pcb_drc.h"
 #include "cli/command_pcb_render.h"
+#include "cli/command_pcb_route.h"
 #include "cli/command_pcb_export_3d.h"
 #include "cli/command_pcb_export_drill.h"
 #include "cli/command_pcb_export_dxf.h"
@@ -115,6 +116,7 @@ static CLI::JOBSET_RUN_COMMAND           jobsetRunCmd{};
 static CLI::PCB_COMMAND                  pcbCmd{};
 static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
 static CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
+static CLI::PCB_ROUTE_COMMAND            pcbRouteCmd{};
 static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
 static CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
 static CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
@@ -189,6 +191,9 @@ static std::vector<COMMAND_ENTRY> commandStack = {
             {
                 &pcbRenderCmd
             },
+            {
+                &pcbRouteCmd
+            },
             {
                 &exportPcbCmd,
                 {
@@ -200,6 +200,14 @@ class SHAPE_INDEX
 
         explicit SHAPE_INDEX( int aLayer );
 
+        /**
+         * Create a deep copy of another index.  The shapes themselves are not copied, only
+         * the tree referencing them.
+         */
+        SHAPE_INDEX( const SHAPE_INDEX& aOther );
+
+        SHAPE_INDEX& operator=( const SHAPE_INDEX& ) = delete;
+
         ~SHAPE_INDEX();
 
         /**
@@ -273,6 +281,21 @@ class SHAPE_INDEX
             return this->m_tree->Search( min, max, aVisitor );
         }
 
+        /**
+         * Run a callback on every #SHAPE object whose bounding box overlaps \a aBox.
+         *
+         * @param aBox is the area to search.
+         * @param aVisitor is the object to be invoked on every object found.
+         */
+        template <class V>
+        int Query( const BOX2I& aBox, V& aVisitor ) const
+        {
+            int min[2] = { aBox.GetX(),         aBox.GetY() };
+            int max[2] = { aBox.GetRight(),     aBox.GetBottom() };
+
+            return this->m_tree->Search( min, max, aVisitor );
+        }
+
         /**
          * Create an iterator for the current index object.
          *
@@ -296,6 +319,13 @@ SHAPE_INDEX<T>::SHAPE_INDEX( int aLayer )
     this->m_shapeLayer = aLayer;
 }
 
+template <class T>
+SHAPE_INDEX<T>::SHAPE_INDEX( const SHAPE_INDEX& aOther )
+{
+    this->m_tree = new RTree<T, int, 2, double>( *aOther.m_tree );
+    this->m_shapeLayer = aOther.m_shapeLayer;
+}
+
 template <class T>
 SHAPE_INDEX<T>::~SHAPE_INDEX()
 {
@@ -26,6 +26,7 @@
 #define HASH_128_H_
 
 #include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <sstream>
 
@@ -62,4 +63,20 @@ public:
     };
 };
 
+
+/* STL specializations */
+namespace std
+{
+    // Required to use HASH_128 as an unordered_map key
+    template <>
+    struct hash<HASH_128>
+    {
+        size_t operator()( const HASH_128& aHash ) const
+        {
+            // The value is already a well distributed hash
+            return static_cast<size_t>( aHash.Value64[0] );
+        }
+    };
+}
+
 #endif // HASH_128_H_
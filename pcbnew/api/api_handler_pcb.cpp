@@ -24,6 +24,7 @@
 #include <api/api_pcb_utils.h>
 #include <api/api_enums.h>
 #include <api/api_utils.h>
+#include <autorouter/ar_batch_router.h>
 #include <board_commit.h>
 #include <board_design_settings.h>
 #include <footprint.h>
@@ -90,6 +91,7 @@ API_HANDLER_PCB::API_HANDLER_PCB( PCB_EDIT_FRAME* aFrame ) :
     registerHandler<GetNetClassForNets, NetClassForNetsResponse>(
             &API_HANDLER_PCB::handleGetNetClassForNets );
     registerHandler<RefillZones, Empty>( &API_HANDLER_PCB::handleRefillZones );
+    registerHandler<RouteNets, RouteNetsResponse>( &API_HANDLER_PCB::handleRouteNets );
 
     registerHandler<SaveDocumentToString, SavedDocumentResponse>(
             &API_HANDLER_PCB::handleSaveDocumentToString );
@@ -1234,6 +1236,49 @@ HANDLER_RESULT<Empty> API_HANDLER_PCB::handleRefillZones( const HANDLER_CONTEXT<
 }
 
 
+HANDLER_RESULT<RouteNetsResponse> API_HANDLER_PCB::handleRouteNets(
+        const HANDLER_CONTEXT<RouteNets>& aCtx )
+{
+    if( std::optional<ApiResponseStatus> busy = checkForBusy() )
+        return tl::unexpected( *busy );
+
+    HANDLER_RESULT<bool> documentValidation = validateDocument( aCtx.Request.board() );
+
+    if( !documentValidation )
+        return tl::unexpected( documentValidation.error() );
+
+    BOARD*        board = frame()->GetBoard();
+    std::set<int> netCodes;
+
+    for( const board::types::Net& net : aCtx.Request.nets() )
+    {
+        NETINFO_ITEM* netInfo = board->FindNet( wxString::FromUTF8( net.name() ) );
+
+        if( !netInfo )
+        {
+            ApiResponseStatus e;
+            e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+            e.set_error_message( fmt::format( "net '{}' does not exist", net.name() ) );
+            return tl::unexpected( e );
+        }
+
+        netCodes.insert( netInfo->GetNetCode() );
+    }
+
+    AR_BATCH_ROUTER router( board, frame()->GetToolManager() );
+    router.SetNetFilter( netCodes );
+
+    AR_BATCH_ROUTER::RESULT result = router.Run();
+
+    RouteNetsResponse response;
+    response.set_attempted( result.m_attempted );
+    response.set_routed( result.m_routed );
+    response.set_failed( result.m_failed );
+
+    return response;
+}
+
+
 HANDLER_RESULT<SavedDocumentResponse> API_HANDLER_PCB::handleSaveDocumentToString(
         const HANDLER_CONTEXT<SaveDocumentToString>& aCtx )
 {
@@ -0,0 +1,264 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <base_units.h>
+#include <board.h>
+#include <board_commit.h>
+#include <board_connected_item.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <eda_units.h>
+#include <progress_reporter.h>
+#include <reporter.h>
+
+#include <router/pns_item.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_node.h>
+#include <router/pns_placement_algo.h>
+#include <router/pns_router.h>
+#include <router/pns_routing_settings.h>
+#include <router/pns_sizes_settings.h>
+
+#include "ar_batch_router.h"
+
+
+/**
+ * A router interface without a view.  Changes are pushed as soon as the router commits
+ * them, so that each routed connection becomes part of the board before the next one is
+ * attempted.
+ */
+class AR_BATCH_ROUTER_IFACE : public PNS_KICAD_IFACE
+{
+public:
+    AR_BATCH_ROUTER_IFACE( TOOL_MANAGER* aToolMgr ) :
+            m_toolMgr( aToolMgr )
+    {
+        m_commit = std::make_unique<BOARD_COMMIT>( m_toolMgr );
+    }
+
+    void EraseView() override {}
+    bool IsAnyLayerVisible( const PNS_LAYER_RANGE& aLayer ) const override { return true; }
+    bool IsItemVisible( const PNS::ITEM* aItem ) const override { return true; }
+    void HideItem( PNS::ITEM* aItem ) override {}
+    void DisplayItem( const PNS::ITEM* aItem, int aClearance, bool aEdit = false,
+                      int aFlags = 0 ) override {}
+    void DisplayPathLine( const SHAPE_LINE_CHAIN& aLine, int aImportance ) override {}
+    void DisplayRatline( const SHAPE_LINE_CHAIN& aRatline, PNS::NET_HANDLE aNet ) override {}
+
+    EDA_UNITS GetUnits() const override { return EDA_UNITS::MM; }
+
+    void Commit() override
+    {
+        // Walkaround never drags footprints, so there are no offsets to apply
+        m_fpOffsets.clear();
+
+        m_commit->Push( _( "Autoroute" ), m_commitFlags );
+        m_commit = std::make_unique<BOARD_COMMIT>( m_toolMgr );
+
+        // Keep the whole batch in a single undo entry
+        m_commitFlags |= APPEND_UNDO;
+    }
+
+private:
+    TOOL_MANAGER* m_toolMgr;
+};
+
+
+namespace
+{
+
+/**
+ * An unconnected ratsnest edge.  Earlier connections may delete or replace tracks when they
+ * are committed, so the end items are kept by ID and looked up again when routing.
+ */
+struct CONNECTION
+{
+    int      m_netCode;
+    unsigned m_length;
+    KIID     m_source;
+    VECTOR2I m_sourcePos;
+    KIID     m_target;
+    VECTOR2I m_targetPos;
+};
+
+
+wxString formatPos( const VECTOR2I& aPos )
+{
+    return wxString::Format( wxT( "(%s, %s)" ),
+                             EDA_UNIT_UTILS::UI::MessageTextFromValue( pcbIUScale, EDA_UNITS::MM,
+                                                                       aPos.x ),
+                             EDA_UNIT_UTILS::UI::MessageTextFromValue( pcbIUScale, EDA_UNITS::MM,
+                                                                       aPos.y ) );
+}
+
+} // namespace
+
+
+AR_BATCH_ROUTER::AR_BATCH_ROUTER( BOARD* aBoard, TOOL_MANAGER* aToolMgr ) :
+        m_board( aBoard ),
+        m_toolMgr( aToolMgr ),
+        m_commitFlags( 0 ),
+        m_reporter( nullptr ),
+        m_progressReporter( nullptr )
+{
+}
+
+
+AR_BATCH_ROUTER::RESULT AR_BATCH_ROUTER::Run()
+{
+    RESULT                  result;
+    std::vector<CONNECTION> connections;
+
+    m_board->GetConnectivity()->RunOnUnconnectedEdges(
+            [&]( CN_EDGE& aEdge )
+            {
+                BOARD_CONNECTED_ITEM* source = aEdge.GetSourceNode()->Parent();
+                BOARD_CONNECTED_ITEM* target = aEdge.GetTargetNode()->Parent();
+                int                   netCode = source->GetNetCode();
+
+                if( netCode > 0 && ( m_netFilter.empty() || m_netFilter.count( netCode ) ) )
+                {
+                    connections.push_back( { netCode, aEdge.GetLength(), source->m_Uuid,
+                                             aEdge.GetSourcePos(), target->m_Uuid,
+                                             aEdge.GetTargetPos() } );
+                }
+
+                return true;
+            } );
+
+    // Short connections first: they have the fewest alternatives and block the least
+    std::stable_sort( connections.begin(), connections.end(),
+                      []( const CONNECTION& aA, const CONNECTION& aB )
+                      {
+                          return aA.m_length < aB.m_length;
+                      } );
+
+    // Delete the router before the interface, the NODE dtor needs the rule resolver
+    std::unique_ptr<AR_BATCH_ROUTER_IFACE> iface =
+            std::make_unique<AR_BATCH_ROUTER_IFACE>( m_toolMgr );
+    std::unique_ptr<PNS::ROUTER>           router = std::make_unique<PNS::ROUTER>();
+    PNS::ROUTING_SETTINGS                  settings( nullptr, "" );
+
+    iface->SetBoard( m_board );
+    iface->SetCommitFlags( m_commitFlags );
+
+    router->SetInterface( iface.get() );
+    router->ClearWorld();
+    router->SyncWorld();
+
+    // There is no debug view here, so the walkaround policies can run concurrently
+    settings.SetMode( PNS::RM_Walkaround );
+    settings.SetParallelWalkaround( true );
+    router->LoadSettings( &settings );
+    router->SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( _( "Routing connections..." ) );
+        m_progressReporter->SetMaxProgress( (int) connections.size() );
+    }
+
+    auto findItem =
+            [&]( const KIID& aId ) -> PNS::ITEM*
+            {
+                BOARD_ITEM* item = m_board->GetItem( aId );
+
+                if( !item || !item->IsConnected() )
+                    return nullptr;
+
+                return router->GetWorld()->FindItemByParent( item );
+            };
+
+    for( const CONNECTION& conn : connections )
+    {
+        if( m_progressReporter )
+        {
+            m_progressReporter->AdvanceProgress();
+
+            if( !m_progressReporter->KeepRefreshing( false ) )
+            {
+                result.m_cancelled = true;
+                break;
+            }
+        }
+
+        result.m_attempted++;
+
+        PNS::ITEM* startItem = findItem( conn.m_source );
+        PNS::ITEM* endItem = findItem( conn.m_target );
+        bool       routed = false;
+
+        // Prefer a layer both ends are on: the walkaround router does not place vias
+        PNS_LAYER_RANGE startLayers = startItem ? startItem->Layers() : PNS_LAYER_RANGE( 0 );
+        int             layer = startLayers.Start();
+
+        if( endItem && startLayers.Overlaps( endItem->Layers() ) )
+            layer = std::max( startLayers.Start(), endItem->Layers().Start() );
+
+        PNS::SIZES_SETTINGS sizes( router->Sizes() );
+        iface->SetStartLayerFromPNS( layer );
+        iface->ImportSizes( sizes, startItem, nullptr, conn.m_sourcePos );
+        router->UpdateSizes( sizes );
+
+        // An end removed by an earlier commit can't be connected to
+        if( startItem && endItem && router->StartRouting( conn.m_sourcePos, startItem, layer ) )
+        {
+            router->Move( conn.m_targetPos, endItem );
+
+            if( router->Placer()->CurrentEnd() == conn.m_targetPos
+                    && router->FixRoute( conn.m_targetPos, endItem, true, false ) )
+            {
+                router->CommitRouting();
+                routed = true;
+            }
+        }
+
+        router->StopRouting();
+
+        if( routed )
+        {
+            result.m_routed++;
+        }
+        else
+        {
+            result.m_failed++;
+
+            if( m_reporter )
+            {
+                NETINFO_ITEM* net = m_board->FindNet( conn.m_netCode );
+
+                m_reporter->Report( wxString::Format( _( "Could not route %s from %s to %s." ),
+                                                      net ? net->GetNetname() : wxString(),
+                                                      formatPos( conn.m_sourcePos ),
+                                                      formatPos( conn.m_targetPos ) ),
+                                    RPT_SEVERITY_WARNING );
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,89 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __AR_BATCH_ROUTER_H
+#define __AR_BATCH_ROUTER_H
+
+#include <set>
+
+class BOARD;
+class PROGRESS_REPORTER;
+class REPORTER;
+class TOOL_MANAGER;
+
+
+/**
+ * Route the unconnected ratsnest edges of a board with the push and shove router, without
+ * any user interaction or view.
+ *
+ * Each edge is routed in walkaround mode from its source to its target anchor, shortest
+ * edges first.  Only edges that reach their target are committed; the others are left
+ * unrouted and reported.
+ */
+class AR_BATCH_ROUTER
+{
+public:
+    struct RESULT
+    {
+        int m_attempted = 0;
+        int m_routed = 0;
+        int m_failed = 0;
+        bool m_cancelled = false;
+    };
+
+    /**
+     * @param aToolMgr is used to create the board commits.  Its environment must refer to
+     *                 \a aBoard.
+     */
+    AR_BATCH_ROUTER( BOARD* aBoard, TOOL_MANAGER* aToolMgr );
+
+    /**
+     * Restrict routing to the given net codes.  An empty set routes every net.
+     */
+    void SetNetFilter( const std::set<int>& aNetCodes ) { m_netFilter = aNetCodes; }
+
+    /**
+     * Flags passed to BOARD_COMMIT::Push() for the first connection routed.  Subsequent
+     * connections are appended to the same undo entry.
+     */
+    void SetCommitFlags( int aFlags ) { m_commitFlags = aFlags; }
+
+    void SetReporter( REPORTER* aReporter ) { m_reporter = aReporter; }
+
+    void SetProgressReporter( PROGRESS_REPORTER* aReporter )
+    {
+        m_progressReporter = aReporter;
+    }
+
+    RESULT Run();
+
+private:
+    BOARD*             m_board;
+    TOOL_MANAGER*      m_toolMgr;
+    std::set<int>      m_netFilter;
+    int                m_commitFlags;
+    REPORTER*          m_reporter;
+    PROGRESS_REPORTER* m_progressReporter;
+};
+
+#endif
@@ -1176,6 +1176,8 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectivity
     if( !aSkipConnectivity )
         m_connectivity->Add( aBoardItem );
 
+    m_lengthDelayCalc->InvalidateCache( { aBoardItem } );
+
     if( aMode != ADD_MODE::BULK_INSERT && aMode != ADD_MODE::BULK_APPEND )
         InvokeListeners( &BOARD_LISTENER::OnBoardItemAdded, *this, aBoardItem );
 }
@@ -1318,6 +1320,8 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
 
     m_connectivity->Remove( aBoardItem );
 
+    m_lengthDelayCalc->InvalidateCache( { aBoardItem } );
+
     if( aRemoveMode != REMOVE_MODE::BULK )
         InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
 }
@@ -2144,6 +2148,7 @@ void BOARD::SynchronizeProperties()
 void BOARD::SynchronizeTimeDomainProperties()
 {
     m_lengthDelayCalc->SynchronizeTimeDomainProperties();
+    m_lengthDelayCalc->ClearCache();
 }
 
 
@@ -2156,6 +2161,7 @@ void BOARD::SynchronizeNetsAndNetClasses( bool aResetTrackAndViaSizes )
     const std::shared_ptr<NETCLASS>& defaultNetClass = bds.m_NetSettings->GetDefaultNetclass();
 
     bds.m_NetSettings->ClearAllCaches();
+    m_lengthDelayCalc->ClearCache();
 
     for( NETINFO_ITEM* net : m_NetInfo )
         net->SetNetClass( bds.m_NetSettings->GetEffectiveNetClass( net->GetNetname() ) );
@@ -2387,22 +2393,31 @@ std::tuple<int, double, double, double, double> BOARD::GetTrackLength( const PCB
 {
     auto connectivity = GetBoard()->GetConnectivity();
 
-    std::vector<LENGTH_DELAY_CALCULATION_ITEM> items;
+    std::vector<const BOARD_CONNECTED_ITEM*> items;
 
     for( BOARD_CONNECTED_ITEM* boardItem : connectivity->GetConnectedItems( &aTrack, EXCLUDE_ZONES ) )
     {
-        LENGTH_DELAY_CALCULATION_ITEM item = GetLengthCalculation()->GetLengthCalculationItem( boardItem );
+        switch( boardItem->Type() )
+        {
+        case PCB_TRACE_T:
+        case PCB_ARC_T:
+        case PCB_VIA_T:
+        case PCB_PAD_T:
+            items.push_back( boardItem );
+            break;
 
-        if( item.Type() != LENGTH_DELAY_CALCULATION_ITEM::TYPE::UNKNOWN )
-            items.push_back( item );
+        default:
+            break;
+        }
     }
 
     constexpr PATH_OPTIMISATIONS opts = {
         .OptimiseViaLayers = true, .MergeTracks = true, .OptimiseTracesInPads = true, .InferViaInPad = false
     };
-    LENGTH_DELAY_STATS details = GetLengthCalculation()->CalculateLengthDetails(
-            items, opts, nullptr, nullptr, LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
-            LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL );
+
+    // Cached per net until one of the items changes
+    LENGTH_DELAY_STATS details = GetLengthCalculation()->CalculateNetLengthDetails(
+            items, opts, LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL, LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL );
 
     return std::make_tuple( items.size(), details.TrackLength + details.ViaLength, details.PadToDieLength,
                             details.TrackDelay + details.ViaDelay, details.PadToDieDelay );
@@ -2725,12 +2740,14 @@ void BOARD::RemoveAllListeners()
 
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    m_lengthDelayCalc->InvalidateCache( { aItem } );
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
 void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 {
+    m_lengthDelayCalc->InvalidateCache( aItems );
     InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *this, aItems );
 }
 
@@ -2739,6 +2756,10 @@ void BOARD::OnItemsCompositeUpdate( std::vector<BOARD_ITEM*>& aAddedItems,
                                     std::vector<BOARD_ITEM*>& aRemovedItems,
                                     std::vector<BOARD_ITEM*>& aChangedItems )
 {
+    m_lengthDelayCalc->InvalidateCache( aAddedItems );
+    m_lengthDelayCalc->InvalidateCache( aRemovedItems );
+    m_lengthDelayCalc->InvalidateCache( aChangedItems );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardCompositeUpdate, *this, aAddedItems, aRemovedItems,
                      aChangedItems );
 }
@@ -31,10 +31,15 @@
 #include <map>
 #include <set>
 #include <cctype>
+#include <atomic>
+#include <future>
 
+#include <core/wx_stl_compat.h>
+#include <hash.h>
 #include <pad.h>
 #include <footprint.h>
 #include <refdes_utils.h>
+#include <thread_pool.h>
 #include <wx/string.h>
 #include <wx/log.h>
 
@@ -118,47 +123,24 @@ bool PIN::IsIsomorphic( const PIN& b ) const
 }
 
 
-// fixme: terrible performance, but computers are fast these days, ain't they? :D
 bool checkIfPadNetsMatch( const BACKTRACK_STAGE& aMatches, CONNECTION_GRAPH* aRefGraph,
                           COMPONENT* aRef, COMPONENT* aTgt )
 {
-    std::map<PIN*, PIN*> pairs;
-    std::vector<PIN*>    pref, ptgt;
-
-    // GetMatchingComponentPairs() returns target->reference map
-    for( auto& m : aMatches.GetMatchingComponentPairs() )
-    {
-        for( PIN* p : m.second->Pins() )
-        {
-            pref.push_back( p );
-        }
-
-        for( PIN* p : m.first->Pins() )
-        {
-            ptgt.push_back( p );
-        }
-    }
+    if( aRef->GetPinCount() != aTgt->GetPinCount() )
+        return false;
 
-    for( PIN* p : aRef->Pins() )
-    {
-        pref.push_back( p );
-    }
+    // GetMatchingComponentPairs() returns target->reference map, we need reference->target
+    std::unordered_map<COMPONENT*, COMPONENT*> refToTgt;
+    refToTgt.reserve( aMatches.GetMatchingComponentPairs().size() + 1 );
 
-    for( PIN* p : aTgt->Pins() )
-    {
-        ptgt.push_back( p );
-    }
-
-    if( pref.size() != ptgt.size() )
-    {
-        return false;
-    }
+    for( const auto& [tgtCmp, refCmp] : aMatches.GetMatchingComponentPairs() )
+        refToTgt[refCmp] = tgtCmp;
 
-    for( unsigned int i = 0; i < pref.size(); i++ )
-    {
-        pairs[pref[i]] = ptgt[i];
-    }
+    refToTgt[aRef] = aTgt;
 
+    // Every pin sharing a net with a pin of aRef must map onto the same target net.  Matched
+    // components have the same pin count and pins are sorted by name, so a reference pin maps
+    // onto the target pin at the same index.
     for( PIN* refPin : aRef->Pins() )
     {
         wxLogTrace( traceTopoMatch, wxT( "pad %s-%s: " ),
@@ -166,32 +148,26 @@ bool checkIfPadNetsMatch( const BACKTRACK_STAGE& aMatches, CONNECTION_GRAPH* aRe
 
         std::optional<int> prevNet;
 
-        for( COMPONENT* refCmp : aRefGraph->Components() )
+        for( PIN* ppin : aRefGraph->NetPins( refPin->GetNetCode() ) )
         {
-            for( PIN* ppin : refCmp->Pins() )
-            {
-                if ( ppin->GetNetCode() != refPin->GetNetCode() )
-                    continue;
+            auto tcmp = refToTgt.find( ppin->GetParent() );
 
-                wxLogTrace( traceTopoMatch, wxT( "{ref %s-%s:%d} " ),
-                            ppin->GetParent()->GetParent()->GetReferenceAsString(),
-                            ppin->GetReference(), ppin->GetNetCode() );
+            if( tcmp == refToTgt.end() )
+                continue;
 
-                auto tpin = pairs.find( ppin );
+            wxLogTrace( traceTopoMatch, wxT( "{ref %s-%s:%d} " ),
+                        ppin->GetParent()->GetParent()->GetReferenceAsString(),
+                        ppin->GetReference(), ppin->GetNetCode() );
 
-                if( tpin != pairs.end() )
-                {
-                    int nc = tpin->second->GetNetCode();
+            int nc = tcmp->second->Pins()[ppin->GetIndex()]->GetNetCode();
 
-                    if( prevNet && ( *prevNet != nc ) )
-                    {
-                        wxLogTrace( traceTopoMatch, wxT( "nets inconsistent\n" ) );
-                        return false;
-                    }
-
-                    prevNet = nc;
-                }
+            if( prevNet && ( *prevNet != nc ) )
+            {
+                wxLogTrace( traceTopoMatch, wxT( "nets inconsistent\n" ) );
+                return false;
             }
+
+            prevNet = nc;
         }
     }
 
@@ -215,6 +191,13 @@ CONNECTION_GRAPH::findMatchingComponents( CONNECTION_GRAPH* aRefGraph, COMPONENT
         wxLogTrace( traceTopoMatch, wxT( "Check '%s'/'%s' " ), aRef->m_reference,
                     cmpTarget->m_reference );
 
+        // components with different refined colours can never be part of the same match
+        if( aRef->m_signature != cmpTarget->m_signature )
+        {
+            wxLogTrace( traceTopoMatch, wxT("reject [signature]\n") );
+            continue;
+        }
+
         // first, a basic heuristic (reference prefix, pin count & footprint) followed by a pin
         // connection topology check
         if( aRef->MatchesWith( cmpTarget ) )
@@ -279,12 +262,19 @@ void CONNECTION_GRAPH::BuildConnectivity()
 
     sortByPinCount();
 
+    m_netPins.clear();
+
     for( auto c : m_components )
     {
         c->sortPinsByName();
 
-        for( auto p : c->Pins() )
+        for( size_t i = 0; i < c->m_pins.size(); i++ )
         {
+            PIN* p = c->m_pins[i];
+
+            p->m_index = i;
+            m_netPins[p->GetNetCode()].push_back( p );
+
             if( p->GetNetCode() > 0 )
                 nets[p->GetNetCode()].push_back( p );
         }
@@ -307,6 +297,8 @@ void CONNECTION_GRAPH::BuildConnectivity()
         }
     }
 
+    computeSignatures();
+
 /*    for( auto c : m_components )
         for( auto p : c->Pins() )
         {
@@ -320,25 +312,72 @@ void CONNECTION_GRAPH::BuildConnectivity()
 }
 
 
-CONNECTION_GRAPH::STATUS CONNECTION_GRAPH::FindIsomorphism( CONNECTION_GRAPH* aTarget,
-                                                            COMPONENT_MATCHES&  aResult )
+void CONNECTION_GRAPH::computeSignatures()
 {
-    std::vector<BACKTRACK_STAGE> stack;
-    BACKTRACK_STAGE              top;
+    // Colour refinement (one-dimensional Weisfeiler-Lehman): start from the component kind and
+    // repeatedly fold in the colours of the components connected to each pin.  A match pairs
+    // pins by index and preserves both kinds and nets, so matched components always end up with
+    // the same colour and components of different colours can be rejected without any further
+    // checks.
+    for( COMPONENT* c : m_components )
+    {
+        c->m_signature = hash_val( c->m_prefix, c->m_parentFootprint->GetFPID().GetUniStringLibId(),
+                                   c->m_pins.size() );
+    }
 
-    if( m_components.empty()|| aTarget->m_components.empty() )
-        return ST_EMPTY;
+    std::vector<size_t> next( m_components.size() );
+    std::vector<size_t> neighbours;
 
-    if( m_components.size() != aTarget->m_components.size() )
-        return ST_COMPONENT_COUNT_MISMATCH;
+    for( int round = 0; round < c_SIGNATURE_ROUNDS; round++ )
+    {
+        for( size_t i = 0; i < m_components.size(); i++ )
+        {
+            size_t seed = m_components[i]->m_signature;
 
-    top.m_ref = m_components.front();
-    top.m_refIndex = 0;
+            for( PIN* p : m_components[i]->m_pins )
+            {
+                neighbours.clear();
+
+                for( PIN* n : p->m_conns )
+                    neighbours.push_back( hash_val( n->m_parent->m_signature, n->m_index ) );
+
+                std::sort( neighbours.begin(), neighbours.end() );
+
+                hash_combine( seed, neighbours.size() );
+
+                for( size_t h : neighbours )
+                    hash_combine( seed, h );
+            }
+
+            next[i] = seed;
+        }
+
+        for( size_t i = 0; i < m_components.size(); i++ )
+            m_components[i]->m_signature = next[i];
+    }
+}
+
+
+const std::vector<PIN*>& CONNECTION_GRAPH::NetPins( int aNetCode ) const
+{
+    static const std::vector<PIN*> empty;
+
+    auto it = m_netPins.find( aNetCode );
 
-    stack.push_back( top );
+    return it != m_netPins.end() ? it->second : empty;
+}
 
-    bool matchFound = false;
-    int  nloops = 0;
+
+CONNECTION_GRAPH::STATUS CONNECTION_GRAPH::searchBranch( CONNECTION_GRAPH*            aTarget,
+                                                         const BACKTRACK_STAGE&       aRoot,
+                                                         const std::function<bool()>& aAbort,
+                                                         COMPONENT_MATCHES&           aResult )
+{
+    std::vector<BACKTRACK_STAGE> stack;
+
+    stack.push_back( aRoot );
+
+    int nloops = 0;
 
     while( !stack.empty() )
     {
@@ -356,6 +395,12 @@ CONNECTION_GRAPH::STATUS CONNECTION_GRAPH::FindIsomorphism( CONNECTION_GRAPH* aT
             }
         }
 
+        if( aAbort && aAbort() )
+        {
+            wxLogTrace( traceTopoMatch, wxT( "stk: Aborted\n" ) );
+            return ST_TOPOLOGY_MISMATCH;
+        }
+
         if( nloops >= c_ITER_LIMIT )
         {
             wxLogTrace( traceTopoMatch, wxT( "stk: Iter cnt exceeded\n" ) );
@@ -487,6 +532,103 @@ CONNECTION_GRAPH::STATUS CONNECTION_GRAPH::FindIsomorphism( CONNECTION_GRAPH* aT
 }
 
 
+CONNECTION_GRAPH::STATUS CONNECTION_GRAPH::FindIsomorphism( CONNECTION_GRAPH* aTarget,
+                                                            COMPONENT_MATCHES& aResult,
+                                                            bool               aParallel )
+{
+    BACKTRACK_STAGE top;
+
+    if( m_components.empty()|| aTarget->m_components.empty() )
+        return ST_EMPTY;
+
+    if( m_components.size() != aTarget->m_components.size() )
+        return ST_COMPONENT_COUNT_MISMATCH;
+
+    // Isomorphic graphs have the same colour histogram
+    std::vector<size_t> refSignatures, tgtSignatures;
+
+    for( COMPONENT* c : m_components )
+        refSignatures.push_back( c->m_signature );
+
+    for( COMPONENT* c : aTarget->m_components )
+        tgtSignatures.push_back( c->m_signature );
+
+    std::sort( refSignatures.begin(), refSignatures.end() );
+    std::sort( tgtSignatures.begin(), tgtSignatures.end() );
+
+    if( refSignatures != tgtSignatures )
+    {
+        wxLogTrace( traceTopoMatch, wxT( "stk: Signature mismatch\n" ) );
+        return ST_TOPOLOGY_MISMATCH;
+    }
+
+    top.m_ref = m_components.front();
+    top.m_refIndex = 0;
+    top.m_matches = aTarget->findMatchingComponents( this, top.m_ref, top );
+    top.m_currentMatch = 0;
+
+    if( !aParallel || top.m_matches.size() < 2 )
+        return searchBranch( aTarget, top, nullptr, aResult );
+
+    // Explore each candidate for the first component in its own task, each with its own
+    // iteration budget.  The lowest candidate leading to a full match wins, which is the match
+    // the sequential search would have returned; higher candidates are abandoned once it is found.
+    const size_t                   count = top.m_matches.size();
+    std::vector<STATUS>            statuses( count, ST_TOPOLOGY_MISMATCH );
+    std::vector<COMPONENT_MATCHES> results( count );
+    std::atomic<size_t>            firstFound( count );
+    std::vector<std::future<void>> returns;
+    thread_pool&                   tp = GetKiCadThreadPool();
+
+    returns.reserve( count );
+
+    for( size_t ii = 0; ii < count; ii++ )
+    {
+        returns.emplace_back( tp.submit(
+                [&, ii]()
+                {
+                    auto abort = [&]()
+                                 {
+                                     return firstFound.load() < ii;
+                                 };
+
+                    if( abort() )
+                        return;
+
+                    BACKTRACK_STAGE root( top );
+                    root.m_matches = { top.m_matches[ii] };
+
+                    statuses[ii] = searchBranch( aTarget, root, abort, results[ii] );
+
+                    if( statuses[ii] == ST_OK )
+                    {
+                        size_t prev = firstFound.load();
+
+                        while( ii < prev && !firstFound.compare_exchange_weak( prev, ii ) )
+                            ;
+                    }
+                } ) );
+    }
+
+    for( const std::future<void>& ret : returns )
+        ret.wait();
+
+    if( firstFound < count )
+    {
+        aResult = std::move( results[firstFound] );
+        return ST_OK;
+    }
+
+    for( STATUS status : statuses )
+    {
+        if( status == ST_ITERATION_COUNT_EXCEEDED )
+            return ST_ITERATION_COUNT_EXCEEDED;
+    }
+
+    return ST_TOPOLOGY_MISMATCH;
+}
+
+
 #if 0
 int main()
 {
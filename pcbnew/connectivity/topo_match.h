@@ -24,9 +24,11 @@
 #ifndef __TOPO_MATCH_H
 #define __TOPO_MATCH_H
 
+#include <functional>
 #include <vector>
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 #include <wx/string.h>
 
@@ -70,6 +72,9 @@ private:
     wxString          m_prefix;
     FOOTPRINT*        m_parentFootprint = nullptr;
     std::vector<PIN*> m_pins;
+
+    /// Refined colour of the component in its connection graph, see CONNECTION_GRAPH::computeSignatures()
+    size_t            m_signature = 0;
 };
 
 class PIN
@@ -77,7 +82,7 @@ class PIN
     friend class CONNECTION_GRAPH;
 
 public:
-    PIN() : m_netcode( 0 ), m_parent( nullptr ) {}
+    PIN() : m_netcode( 0 ), m_index( 0 ), m_parent( nullptr ) {}
     ~PIN() {}
 
     void SetParent( COMPONENT* parent ) { m_parent = parent; }
@@ -102,12 +107,16 @@ public:
 
     const wxString& GetReference() const { return m_ref; }
 
+    /// Position of the pin in its (name-sorted) parent component
+    int GetIndex() const { return m_index; }
+
     COMPONENT* GetParent() const { return m_parent; }
 
 private:
 
     wxString          m_ref;
     int               m_netcode;
+    int               m_index;
     COMPONENT*        m_parent;
     std::vector<PIN*> m_conns;
 };
@@ -153,6 +162,9 @@ class CONNECTION_GRAPH
 public:
     const int c_ITER_LIMIT = 10000;
 
+    /// Number of colour refinement rounds used to compute the component signatures
+    static constexpr int c_SIGNATURE_ROUNDS = 3;
+
     enum STATUS
     {
         ST_TOPOLOGY_MISMATCH = -10,
@@ -167,10 +179,22 @@ public:
 
     void   BuildConnectivity();
     void   AddFootprint( FOOTPRINT* aFp, const VECTOR2I& aOffset );
-    STATUS FindIsomorphism( CONNECTION_GRAPH* target, COMPONENT_MATCHES& result );
+
+    /**
+     * Find a mapping of the components of this graph onto the components of \a aTarget.
+     *
+     * @param aParallel explores the candidates for the first component on the thread pool.  Pass
+     *                  false when calling from a thread pool task.
+     */
+    STATUS FindIsomorphism( CONNECTION_GRAPH* aTarget, COMPONENT_MATCHES& aResult,
+                            bool aParallel = true );
+
     static std::unique_ptr<CONNECTION_GRAPH> BuildFromFootprintSet( const std::set<FOOTPRINT*>& aFps );
     std::vector<COMPONENT*> &Components() { return m_components; }
 
+    /// All pins of the graph on the given net (including unconnected pins for net codes <= 0)
+    const std::vector<PIN*>& NetPins( int aNetCode ) const;
+
 private:
     void sortByPinCount()
     {
@@ -186,7 +210,18 @@ private:
                                                     COMPONENT*             ref,
                                                     const BACKTRACK_STAGE& partialMatches );
 
-    std::vector<COMPONENT*> m_components;
+    void computeSignatures();
+
+    /**
+     * Run the backtracking search from \a aRoot, whose candidate list must already be filled in.
+     *
+     * @param aAbort is polled on every iteration, the search gives up when it returns true.
+     */
+    STATUS searchBranch( CONNECTION_GRAPH* aTarget, const BACKTRACK_STAGE& aRoot,
+                         const std::function<bool()>& aAbort, COMPONENT_MATCHES& aResult );
+
+    std::vector<COMPONENT*>                    m_components;
+    std::unordered_map<int, std::vector<PIN*>> m_netPins;
 
 };
 
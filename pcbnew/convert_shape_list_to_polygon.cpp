@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include <trigo.h>
@@ -36,6 +37,7 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/rtree.h>
 #include <convert_shape_list_to_polygon.h>
 #include <board.h>
 #include <collectors.h>
@@ -97,57 +99,134 @@ static bool closer_to_first( VECTOR2I aRef, VECTOR2I aFirst, VECTOR2I aSecond )
 
 
 /**
- * Search for a #PCB_SHAPE matching a given end point or start point in a list.
- *
- * @param aShape The starting shape.
- * @param aPoint The starting or ending point to search for.
- * @param aList The list to remove from.
- * @param aLimit is the distance from \a aPoint that still constitutes a valid find.
- * @return The first #PCB_SHAPE that has a start or end point matching aPoint, otherwise nullptr.
+ * An index of the start and end points of a list of shapes, so that chaining an outline doesn't
+ * have to scan the whole list for every shape it adds.
  */
-static PCB_SHAPE* findNext( PCB_SHAPE* aShape, const VECTOR2I& aPoint,
-                            const std::vector<PCB_SHAPE*>& aList, unsigned aLimit )
+class SHAPE_ENDPOINT_INDEX
 {
-    // Look for an unused, exact hit
-    for( PCB_SHAPE* graphic : aList )
+public:
+    /**
+     * @param aList is the list of shapes to index; it must outlive the index.
+     * @param aLimit is the largest distance searched for by FindNear().
+     */
+    SHAPE_ENDPOINT_INDEX( const std::vector<PCB_SHAPE*>& aList, unsigned aLimit ) :
+            m_list( aList ),
+            m_cellSize( std::max<int64_t>( aLimit, 1 ) )
     {
-        if( graphic == aShape || ( graphic->GetFlags() & SKIP_STRUCT ) != 0 )
-            continue;
+        for( int ii = 0; ii < (int) aList.size(); ++ii )
+        {
+            for( const VECTOR2I& pt : { aList[ii]->GetStart(), aList[ii]->GetEnd() } )
+            {
+                m_exact[pt].push_back( ii );
 
-        if( aPoint == graphic->GetStart() || aPoint == graphic->GetEnd() )
-            return graphic;
+                if( aLimit > 0 )
+                    m_cells[cellKey( cellOf( pt.x ), cellOf( pt.y ) )].emplace_back( pt, ii );
+            }
+        }
     }
 
-    // Search again for anything that's close, even something already used.  (The latter is
-    // important for error reporting.)
-    VECTOR2I    pt( aPoint );
-    SEG::ecoord closest_dist_sq = SEG::Square( aLimit );
-    PCB_SHAPE*  closest_graphic = nullptr;
-    SEG::ecoord d_sq;
-
-    for( PCB_SHAPE* graphic : aList )
+    /**
+     * @return the first shape in the list, other than \a aShape, that hasn't been used yet and
+     *         starts or ends exactly at \a aPoint.
+     */
+    PCB_SHAPE* FindExact( PCB_SHAPE* aShape, const VECTOR2I& aPoint ) const
     {
-        if( graphic == aShape )
-            continue;
+        auto it = m_exact.find( aPoint );
 
-        d_sq = ( pt - graphic->GetStart() ).SquaredEuclideanNorm();
+        if( it == m_exact.end() )
+            return nullptr;
 
-        if( d_sq < closest_dist_sq )
+        // Indices were added in list order
+        for( int ii : it->second )
         {
-            closest_dist_sq = d_sq;
-            closest_graphic = graphic;
+            PCB_SHAPE* graphic = m_list[ii];
+
+            if( graphic != aShape && ( graphic->GetFlags() & SKIP_STRUCT ) == 0 )
+                return graphic;
         }
 
-        d_sq = ( pt - graphic->GetEnd() ).SquaredEuclideanNorm();
+        return nullptr;
+    }
 
-        if( d_sq < closest_dist_sq )
+    /**
+     * @return the shape other than \a aShape with the start or end point closest to \a aPoint
+     *         and less than \a aLimit away, used or not.  Ties go to the shape first in the list.
+     */
+    PCB_SHAPE* FindNear( PCB_SHAPE* aShape, const VECTOR2I& aPoint, unsigned aLimit ) const
+    {
+        SEG::ecoord closest_dist_sq = SEG::Square( aLimit );
+        int         closest_idx = -1;
+        int64_t     cx = cellOf( aPoint.x );
+        int64_t     cy = cellOf( aPoint.y );
+
+        // The cells are at least aLimit wide, so any hit is in a neighbouring cell
+        for( int64_t x = cx - 1; x <= cx + 1; ++x )
         {
-            closest_dist_sq = d_sq;
-            closest_graphic = graphic;
+            for( int64_t y = cy - 1; y <= cy + 1; ++y )
+            {
+                auto it = m_cells.find( cellKey( x, y ) );
+
+                if( it == m_cells.end() )
+                    continue;
+
+                for( const auto& [pt, ii] : it->second )
+                {
+                    if( m_list[ii] == aShape )
+                        continue;
+
+                    SEG::ecoord d_sq = ( aPoint - pt ).SquaredEuclideanNorm();
+
+                    if( d_sq < closest_dist_sq
+                            || ( d_sq == closest_dist_sq && closest_idx >= 0 && ii < closest_idx ) )
+                    {
+                        closest_dist_sq = d_sq;
+                        closest_idx = ii;
+                    }
+                }
+            }
         }
+
+        return closest_idx >= 0 ? m_list[closest_idx] : nullptr;
+    }
+
+private:
+    int64_t cellOf( int aCoord ) const
+    {
+        // Round towards negative infinity so that cells don't straddle the origin
+        return aCoord >= 0 ? aCoord / m_cellSize : ( aCoord - m_cellSize + 1 ) / m_cellSize;
+    }
+
+    static int64_t cellKey( int64_t aX, int64_t aY )
+    {
+        return ( aX << 32 ) ^ ( aY & 0xFFFFFFFF );
     }
 
-    return closest_graphic;     // Note: will be nullptr if nothing within aLimit
+    const std::vector<PCB_SHAPE*>&                                       m_list;
+    int64_t                                                              m_cellSize;
+    std::map<VECTOR2I, std::vector<int>>                                 m_exact;
+    std::unordered_map<int64_t, std::vector<std::pair<VECTOR2I, int>>>  m_cells;
+};
+
+
+/**
+ * Search for a #PCB_SHAPE matching a given end point or start point in a list.
+ *
+ * @param aShape The starting shape.
+ * @param aPoint The starting or ending point to search for.
+ * @param aIndex The endpoint index of the list to search.
+ * @param aLimit is the distance from \a aPoint that still constitutes a valid find.
+ * @return The first #PCB_SHAPE that has a start or end point matching aPoint, otherwise nullptr.
+ */
+static PCB_SHAPE* findNext( PCB_SHAPE* aShape, const VECTOR2I& aPoint,
+                            const SHAPE_ENDPOINT_INDEX& aIndex, unsigned aLimit )
+{
+    // Look for an unused, exact hit
+    if( PCB_SHAPE* graphic = aIndex.FindExact( aShape, aPoint ) )
+        return graphic;
+
+    // Search again for anything that's close, even something already used.  (The latter is
+    // important for error reporting.)
+    return aIndex.FindNear( aShape, aPoint, aLimit );   // Note: nullptr if nothing within aLimit
 }
 
 
@@ -217,6 +296,7 @@ bool doConvertOutlineToPolygon( std::vector<PCB_SHAPE*>& aShapeList, SHAPE_POLY_
     VECTOR2I   prevPt;
 
     std::vector<SHAPE_LINE_CHAIN> contours;
+    SHAPE_ENDPOINT_INDEX          endpoints( aShapeList, aChainingEpsilon );
 
     for( PCB_SHAPE* shape : startCandidates )
         shape->ClearFlags( SKIP_STRUCT );
@@ -437,7 +517,7 @@ bool doConvertOutlineToPolygon( std::vector<PCB_SHAPE*>& aShapeList, SHAPE_POLY_
                 }
 
                 // Get next closest segment.
-                PCB_SHAPE* nextGraphic = findNext( graphic, prevPt, aShapeList, aChainingEpsilon );
+                PCB_SHAPE* nextGraphic = findNext( graphic, prevPt, endpoints, aChainingEpsilon );
 
                 if( nextGraphic && !( nextGraphic->GetFlags() & SKIP_STRUCT ) )
                 {
@@ -521,25 +601,38 @@ bool doConvertOutlineToPolygon( std::vector<PCB_SHAPE*>& aShapeList, SHAPE_POLY_
             return false;
     }
 
-    // First, collect the parents of each contour
+    // First, collect the parents of each contour.  Only contours whose bounding box contains
+    // the first point can be parents, so look those up in an R-tree.
     std::map<int, std::vector<int>> contourToParentIndexesMap;
+    RTree<int, int, 2, double>      contourTree;
+
+    for( size_t ii = 0; ii < contours.size(); ++ii )
+    {
+        BOX2I     bbox = contours[ii].BBox();
+        const int mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        contourTree.Insert( mmin, mmax, (int) ii );
+    }
 
     for( size_t ii = 0; ii < contours.size(); ++ii )
     {
         VECTOR2I         firstPt = contours[ii].GetPoint( 0 );
+        const int        pt[2] = { firstPt.x, firstPt.y };
         std::vector<int> parents;
 
-        for( size_t jj = 0; jj < contours.size(); ++jj )
-        {
-            if( jj == ii )
-                continue;
+        auto visitor =
+                [&]( const int& jj ) -> bool
+                {
+                    if( jj != (int) ii && contours[jj].PointInside( firstPt ) )
+                        parents.push_back( jj );
 
-            const SHAPE_LINE_CHAIN& parentCandidate = contours[jj];
+                    return true;
+                };
 
-            if( parentCandidate.PointInside( firstPt ) )
-                parents.push_back( jj );
-        }
+        contourTree.Search( pt, pt, visitor );
 
+        std::sort( parents.begin(), parents.end() );
         contourToParentIndexesMap[ii] = std::move( parents );
     }
 
@@ -594,34 +687,67 @@ bool doConvertOutlineToPolygon( std::vector<PCB_SHAPE*>& aShapeList, SHAPE_POLY_
         }
     }
 
-    // All of the silliness that follows is to work around the segment iterator while checking
-    // for collisions.
-    // TODO: Implement proper segment and point iterators that follow std
-    for( auto seg1 = aPolygons.IterateSegmentsWithHoles(); seg1; seg1++ )
+    // Check every pair of segments whose bounding boxes overlap for collisions, in the order a
+    // pairwise test of all segments would report them.
+    std::vector<SEG>           segments;
+    RTree<int, int, 2, double> segmentTree;
+
+    for( auto seg = aPolygons.IterateSegmentsWithHoles(); seg; seg++ )
+        segments.push_back( *seg );
+
+    for( int ii = 0; ii < (int) segments.size(); ++ii )
     {
-        auto seg2 = seg1;
+        const SEG& seg = segments[ii];
+        const int  mmin[2] = { std::min( seg.A.x, seg.B.x ), std::min( seg.A.y, seg.B.y ) };
+        const int  mmax[2] = { std::max( seg.A.x, seg.B.x ), std::max( seg.A.y, seg.B.y ) };
 
-        for( ++seg2; seg2; seg2++ )
+        segmentTree.Insert( mmin, mmax, ii );
+    }
+
+    std::vector<int> candidates;
+
+    for( int ii = 0; ii < (int) segments.size(); ++ii )
+    {
+        const SEG& seg1 = segments[ii];
+        const int  mmin[2] = { std::min( seg1.A.x, seg1.B.x ), std::min( seg1.A.y, seg1.B.y ) };
+        const int  mmax[2] = { std::max( seg1.A.x, seg1.B.x ), std::max( seg1.A.y, seg1.B.y ) };
+
+        auto visitor =
+                [&]( const int& jj ) -> bool
+                {
+                    if( jj > ii )
+                        candidates.push_back( jj );
+
+                    return true;
+                };
+
+        candidates.clear();
+        segmentTree.Search( mmin, mmax, visitor );
+        std::sort( candidates.begin(), candidates.end() );
+
+        for( int jj : candidates )
         {
+            const SEG& seg2 = segments[jj];
+
             // Check for exact overlapping segments.
-            if( *seg1 == *seg2 || ( ( *seg1 ).A == ( *seg2 ).B && ( *seg1 ).B == ( *seg2 ).A ) )
+            if( seg1 == seg2 || ( seg1.A == seg2.B && seg1.B == seg2.A ) )
             {
                 if( aErrorHandler )
                 {
-                    BOARD_ITEM* a = fetchOwner( *seg1 );
-                    BOARD_ITEM* b = fetchOwner( *seg2 );
-                    (*aErrorHandler)( _( "(self-intersecting)" ), a, b, ( *seg1 ).A );
+                    BOARD_ITEM* a = fetchOwner( seg1 );
+                    BOARD_ITEM* b = fetchOwner( seg2 );
+                    (*aErrorHandler)( _( "(self-intersecting)" ), a, b, seg1.A );
                 }
 
                 selfIntersecting = true;
             }
 
-            if( OPT_VECTOR2I pt = seg1.Get().Intersect( seg2.Get(), true ) )
+            if( OPT_VECTOR2I pt = seg1.Intersect( seg2, true ) )
             {
                 if( aErrorHandler )
                 {
-                    BOARD_ITEM* a = fetchOwner( *seg1 );
-                    BOARD_ITEM* b = fetchOwner( *seg2 );
+                    BOARD_ITEM* a = fetchOwner( seg1 );
+                    BOARD_ITEM* b = fetchOwner( seg2 );
                     (*aErrorHandler)( _( "(self-intersecting)" ), a, b, *pt );
                 }
 
@@ -23,6 +23,7 @@
 
 #include <drc/drc_creepage_utils.h>
 #include <geometry/intersection.h>
+#include <geometry/rtree.h>
 #include <thread_pool.h>
 
 
@@ -2041,41 +2042,48 @@ double CREEPAGE_GRAPH::Solve(
     if( aFrom == aTo )
         return 0;
 
-    // Dijkstra's algorithm for shortest path
-    std::unordered_map<GRAPH_NODE*, double>     distances;
-    std::unordered_map<GRAPH_NODE*, GRAPH_NODE*> previous;
+    const double infinity = std::numeric_limits<double>::infinity();
 
-    auto cmp = [&distances]( GRAPH_NODE* left, GRAPH_NODE* right )
-    {
-        if( distances[left] == distances[right] )
-            return left > right; // Compare addresses to avoid ties.
-        return distances[left] > distances[right];
-    };
-    std::priority_queue<GRAPH_NODE*, std::vector<GRAPH_NODE*>, decltype( cmp )> pq( cmp );
+    // Dijkstra's algorithm for shortest path.  Queue entries carry their distance, so entries
+    // made stale by a shorter path are simply skipped when popped.
+    using QUEUE_ENTRY = std::pair<double, GRAPH_NODE*>;
+
+    std::unordered_map<GRAPH_NODE*, double>                                distances;
+    std::unordered_map<GRAPH_NODE*, const std::shared_ptr<GRAPH_CONNECTION>*> previous;
+    std::priority_queue<QUEUE_ENTRY, std::vector<QUEUE_ENTRY>, std::greater<QUEUE_ENTRY>> pq;
+
+    distances.reserve( m_nodes.size() );
+    previous.reserve( m_nodes.size() );
+
+    auto distanceTo =
+            [&]( GRAPH_NODE* aNode ) -> double
+            {
+                auto it = distances.find( aNode );
+                return it != distances.end() ? it->second : infinity;
+            };
 
-    // Initialize distances to infinity for all nodes except the starting node
-    for( std::shared_ptr<GRAPH_NODE> node : m_nodes )
-    {
-        if( node != nullptr )
-            distances[node.get()] = std::numeric_limits<double>::infinity(); // Set to infinity
-    }
     distances[aFrom.get()] = 0.0;
-    distances[aTo.get()] = std::numeric_limits<double>::infinity();
-    pq.push( aFrom.get() );
+    pq.emplace( 0.0, aFrom.get() );
 
     // Dijkstra's main loop
     while( !pq.empty() )
     {
-        GRAPH_NODE* current = pq.top();
+        auto [dist, current] = pq.top();
         pq.pop();
 
         if( current == aTo.get() )
-        {
             break; // Shortest path found
-        }
+
+        if( dist > distanceTo( current ) )
+            continue; // Stale entry
+
+        // Paths longer than the creepage target are never violations, there is no need to
+        // explore any further
+        if( m_creepageTarget > 0 && dist > m_creepageTarget )
+            break;
 
         // Traverse neighbors
-        for( std::shared_ptr<GRAPH_CONNECTION> connection : current->m_node_conns )
+        for( const std::shared_ptr<GRAPH_CONNECTION>& connection : current->m_node_conns )
         {
             GRAPH_NODE* neighbor = ( connection->n1 ).get() == current ? ( connection->n2 ).get()
                                                                       : ( connection->n1 ).get();
@@ -2083,43 +2091,32 @@ double CREEPAGE_GRAPH::Solve(
             if( !neighbor )
                 continue;
 
-            double alt = distances[current]
-                         + connection->m_path.weight; // Calculate alternative path cost
+            double alt = dist + connection->m_path.weight; // Calculate alternative path cost
 
-            if( alt < distances[neighbor] )
+            if( alt < distanceTo( neighbor ) )
             {
                 distances[neighbor] = alt;
-                previous[neighbor] = current;
-                pq.push( neighbor );
+                previous[neighbor] = &connection;
+                pq.emplace( alt, neighbor );
             }
         }
     }
 
-    double pathWeight = distances[aTo.get()];
+    double pathWeight = distanceTo( aTo.get() );
 
     // If aTo is unreachable, return infinity
-    if( pathWeight == std::numeric_limits<double>::infinity() )
-    {
-        return std::numeric_limits<double>::infinity();
-    }
+    if( pathWeight == infinity )
+        return infinity;
 
     // Trace back the path from aTo to aFrom
     GRAPH_NODE* step = aTo.get();
 
     while( step != aFrom.get() )
     {
-        GRAPH_NODE* prevNode = previous[step];
+        const std::shared_ptr<GRAPH_CONNECTION>& node_conn = *previous[step];
 
-        for( std::shared_ptr<GRAPH_CONNECTION> node_conn : step->m_node_conns )
-        {
-            if( ( ( node_conn->n1 ).get() == prevNode && ( node_conn->n2 ).get() == step )
-                || ( ( node_conn->n1 ).get() == step && ( node_conn->n2 ).get() == prevNode ) )
-            {
-                aResult.push_back( node_conn );
-                break;
-            }
-        }
-        step = prevNode;
+        aResult.push_back( node_conn );
+        step = ( node_conn->n1 ).get() == step ? ( node_conn->n2 ).get() : ( node_conn->n1 ).get();
     }
 
     return pathWeight;
@@ -2288,13 +2285,53 @@ void CREEPAGE_GRAPH::GeneratePaths( double aMaxWeight, PCB_LAYER_ID aLayer, bool
                                                                 && gn1->m_net < gn2->m_net );
               } );
 
+    // Two shapes can only be connected by a path if their boxes are no further than aMaxWeight
+    // apart.  Index the boxes, grown by half that distance, so each node is only tested against
+    // the nodes near it rather than against every other node.
+    RTree<size_t, int, 2, double> nodeTree;
+    std::vector<BOX2I>            nodeBoxes;
+    const int                     halfReach = KiROUND( aMaxWeight / 2 ) + 1;
+
+    nodeBoxes.reserve( nodes.size() );
+
+    for( size_t ii = 0; ii < nodes.size(); ii++ )
+    {
+        nodeBoxes.push_back( nodes[ii]->m_parent->GetBBox().Inflate( halfReach ) );
+
+        const BOX2I& box = nodeBoxes.back();
+        const int    mmin[2] = { box.GetX(), box.GetY() };
+        const int    mmax[2] = { box.GetRight(), box.GetBottom() };
+
+        nodeTree.Insert( mmin, mmax, ii );
+    }
+
     auto processNodes = [&]( size_t i, size_t j ) -> bool
     {
+            std::vector<size_t> candidates;
+
             for( size_t ii = i; ii < j; ii++ )
             {
                 std::shared_ptr<GRAPH_NODE> gn1 = nodes[ii];
+                const BOX2I&                box = nodeBoxes[ii];
+                const int                   mmin[2] = { box.GetX(), box.GetY() };
+                const int                   mmax[2] = { box.GetRight(), box.GetBottom() };
+
+                candidates.clear();
+
+                auto visitor =
+                        [&]( const size_t& aIndex ) -> bool
+                        {
+                            if( aIndex > ii )
+                                candidates.push_back( aIndex );
+
+                            return true;
+                        };
+
+                nodeTree.Search( mmin, mmax, visitor );
 
-                for( size_t jj = ii + 1; jj < nodes.size(); jj++ )
+                std::sort( candidates.begin(), candidates.end() );
+
+                for( size_t jj : candidates )
                 {
                     std::shared_ptr<GRAPH_NODE> gn2 = nodes[jj];
 
@@ -2440,6 +2477,38 @@ void CREEPAGE_GRAPH::RemoveConnection( std::shared_ptr<GRAPH_CONNECTION> aGc, bo
 }
 
 
+void CREEPAGE_GRAPH::Truncate( size_t aNodeCount, size_t aConnectionCount )
+{
+    for( size_t i = aConnectionCount; i < m_connections.size(); i++ )
+    {
+        // We need to remove the connection from its endpoints' lists.
+        RemoveConnection( m_connections[i], false );
+    }
+
+    if( m_connections.size() > aConnectionCount )
+        m_connections.resize( aConnectionCount );
+
+    for( size_t i = aNodeCount; i < m_nodes.size(); i++ )
+    {
+        std::shared_ptr<GRAPH_NODE>& gn = m_nodes[i];
+
+        if( !gn )
+            continue;
+
+        // Only forget the node itself, not an equivalent one kept by the remaining graph
+        auto it = m_nodeset.find( gn );
+
+        if( it != m_nodeset.end() && *it == gn )
+            m_nodeset.erase( it );
+
+        gn->m_node_conns.clear();
+    }
+
+    if( m_nodes.size() > aNodeCount )
+        m_nodes.resize( aNodeCount );
+}
+
+
 std::shared_ptr<GRAPH_NODE> CREEPAGE_GRAPH::AddNode( GRAPH_NODE::TYPE aType, CREEP_SHAPE* parent,
                                                    VECTOR2I pos )
 {
@@ -2498,7 +2567,11 @@ std::shared_ptr<GRAPH_CONNECTION> CREEPAGE_GRAPH::AddConnection( std::shared_ptr
 std::shared_ptr<GRAPH_NODE> CREEPAGE_GRAPH::FindNode( GRAPH_NODE::TYPE aType, CREEP_SHAPE* aParent,
                                                     VECTOR2I aPos )
 {
-    auto it = m_nodeset.find( std::make_shared<GRAPH_NODE>( aType, aParent, aPos ) );
+    // Look up through a non-owning pointer to a stack node rather than allocating a new one
+    GRAPH_NODE                        key( aType, aParent, aPos );
+    const std::shared_ptr<GRAPH_NODE> keyPtr( std::shared_ptr<GRAPH_NODE>(), &key );
+
+    auto it = m_nodeset.find( keyPtr );
 
     if( it != m_nodeset.end() )
         return *it;
@@ -188,6 +188,10 @@ public:
     virtual VECTOR2I  GetEndPoint() const { return VECTOR2I( 0, 0 ); };
     VECTOR2I          GetPos() const { return m_pos; };
     CREEP_SHAPE::TYPE GetType() const { return m_type; };
+
+    /// A box containing every point a path to or from this shape can start from
+    virtual BOX2I     GetBBox() const { return BOX2I( m_pos ); };
+
     const BOARD_ITEM* GetParent() const { return m_parent; };
     void              SetParent( BOARD_ITEM* aParent ) { m_parent = aParent; };
 
@@ -307,6 +311,11 @@ public:
     VECTOR2I GetEnd() const { return m_end; };
     double   GetWidth() const { return m_width; };
 
+    BOX2I GetBBox() const override
+    {
+        return BOX2I::ByCorners( m_start, m_end ).Inflate( KiROUND( m_width / 2 ) + 1 );
+    };
+
     std::vector<PATH_CONNECTION> Paths( const BE_SHAPE_POINT& aS2, double aMaxWeight,
                                         double aMaxSquaredWeight ) const override;
     std::vector<PATH_CONNECTION> Paths( const BE_SHAPE_CIRCLE& aS2, double aMaxWeight,
@@ -343,6 +352,11 @@ public:
     VECTOR2I GetPos() const { return m_pos; };
     int      GetRadius() const override { return m_radius; };
 
+    BOX2I GetBBox() const override
+    {
+        return BOX2I( m_pos ).Inflate( KiROUND( m_radius ) + 1 );
+    };
+
     std::vector<PATH_CONNECTION> Paths( const BE_SHAPE_POINT& aS2, double aMaxWeight,
                                         double aMaxSquaredWeight ) const override;
     std::vector<PATH_CONNECTION> Paths( const BE_SHAPE_CIRCLE& aS2, double aMaxWeight,
@@ -431,6 +445,11 @@ public:
     double GetWidth() const { return m_width; };
     void   SetWidth( double aW ) { m_width = aW; };
 
+    BOX2I GetBBox() const override
+    {
+        return BOX2I( m_pos ).Inflate( KiROUND( m_radius + m_width / 2.0 ) + 1 );
+    };
+
 private:
     int       m_width;
     EDA_ANGLE m_startAngle;
@@ -589,6 +608,8 @@ public:
 
     int  GetRadius() const override { return m_radius; }
 
+    BOX2I GetBBox() const override { return BOX2I( m_pos ).Inflate( m_radius + 1 ); };
+
     void ConnectChildren( std::shared_ptr<GRAPH_NODE>& a1, std::shared_ptr<GRAPH_NODE>& a2,
                           CREEPAGE_GRAPH& aG ) const override;
 
@@ -745,6 +766,12 @@ public:
 
     void RemoveConnection( std::shared_ptr<GRAPH_CONNECTION>, bool aDelete = false );
 
+    /**
+     * Drop the nodes and connections added after the graph had \a aNodeCount nodes and
+     * \a aConnectionCount connections, so that the board edge part of the graph can be reused.
+     */
+    void Truncate( size_t aNodeCount, size_t aConnectionCount );
+
     void Trim( double aWeightLimit );
 
     void Addshape( const SHAPE& aShape, std::shared_ptr<GRAPH_NODE>& aConnectTo,
@@ -394,19 +394,7 @@ int DRC_TEST_PROVIDER_CREEPAGE::testCreepage()
                                 reportProgress( current++, total );
 
                                 if ( prevTestChangedGraph )
-                                {
-                                    size_t vectorSize = graph.m_connections.size();
-
-                                    for( size_t i = beConnectionsSize; i < vectorSize; i++ )
-                                    {
-                                        // We need to remove the connection from its endpoints' lists.
-                                        graph.RemoveConnection( graph.m_connections[i], false );
-                                    }
-                                    graph.m_connections.resize( beConnectionsSize, nullptr );
-
-                                    vectorSize = graph.m_nodes.size();
-                                    graph.m_nodes.resize( beNodeSize, nullptr );
-                                }
+                                    graph.Truncate( beNodeSize, beConnectionsSize );
 
                                 prevTestChangedGraph = testCreepage( graph, aNet1, aNet2, layer );
                             }
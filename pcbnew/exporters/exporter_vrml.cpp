@@ -1116,6 +1116,10 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             dstFile.SetName( srcFile.GetName() );
             dstFile.SetExt( wxT( "wrl" ) );
 
+            // Each model file is copied once, then shared by all the footprints using it
+            auto defIt = m_linkedModelDefs.find( dstFile.GetFullPath() );
+            bool firstUse = defIt == m_linkedModelDefs.end();
+
             // copy the file if necessary
             wxDateTime srcModTime = srcFile.GetModificationTime();
             wxDateTime destModTime = srcModTime;
@@ -1125,7 +1129,7 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             if( dstFile.FileExists() )
                 destModTime = dstFile.GetModificationTime();
 
-            if( srcModTime != destModTime )
+            if( firstUse && srcModTime != destModTime )
             {
                 wxString fileExt = srcFile.GetExt();
                 fileExt.LowerCase();
@@ -1172,6 +1176,14 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
                 }
             }
 
+            if( firstUse )
+            {
+                defIt = m_linkedModelDefs.emplace( dstFile.GetFullPath(),
+                                                   wxString::Format( wxT( "FP_MODEL_%zu" ),
+                                                                     m_linkedModelDefs.size() ) )
+                                .first;
+            }
+
             (*aOutputFile) << "Transform {\n";
 
             // only write a rotation if it is >= 0.1 deg
@@ -1191,21 +1203,35 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             (*aOutputFile) << sM->m_Scale.y << " ";
             (*aOutputFile) << sM->m_Scale.z << "\n";
 
-            (*aOutputFile) << "  children [\n    Inline {\n      url \"";
-
-            if( m_UseRelPathIn3DModelFilename )
+            if( m_ReuseDef && !firstUse )
             {
-                wxFileName tmp = dstFile;
-                tmp.SetExt( wxT( "" ) );
-                tmp.SetName( wxT( "" ) );
-                tmp.RemoveLastDir();
-                dstFile.MakeRelativeTo( tmp.GetPath() );
+                // Instance the Inline node written for the first footprint using this model
+                (*aOutputFile) << "  children [\n    USE " << TO_UTF8( defIt->second ) << " ]\n";
+                (*aOutputFile) << "  }\n";
             }
+            else
+            {
+                (*aOutputFile) << "  children [\n    ";
 
-            wxString fn = dstFile.GetFullPath();
-            fn.Replace( wxT( "\\" ), wxT( "/" ) );
-            (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
-            (*aOutputFile) << "  }\n";
+                if( m_ReuseDef )
+                    (*aOutputFile) << "DEF " << TO_UTF8( defIt->second ) << " ";
+
+                (*aOutputFile) << "Inline {\n      url \"";
+
+                if( m_UseRelPathIn3DModelFilename )
+                {
+                    wxFileName tmp = dstFile;
+                    tmp.SetExt( wxT( "" ) );
+                    tmp.SetName( wxT( "" ) );
+                    tmp.RemoveLastDir();
+                    dstFile.MakeRelativeTo( tmp.GetPath() );
+                }
+
+                wxString fn = dstFile.GetFullPath();
+                fn.Replace( wxT( "\\" ), wxT( "/" ) );
+                (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
+                (*aOutputFile) << "  }\n";
+            }
 
             aOutputFile->precision( old_precision );
         }
@@ -244,6 +244,10 @@ private:
     // used only if m_UseInlineModelsInBrdfile = true
     bool     m_UseRelPathIn3DModelFilename;
 
+    // DEF names of the footprint 3D model files already copied to m_Subdir3DFpModels,
+    // keyed by their full path.  Used only if m_UseInlineModelsInBrdfile = true
+    std::map<wxString, wxString> m_linkedModelDefs;
+
     // true to reuse component definitions
     bool     m_ReuseDef;
 
@@ -30,6 +30,7 @@
 #include <collectors.h>
 #include <reporter.h>
 #include <richio.h>
+#include <thread_pool.h>
 
 #include <gendrill_file_writer_base.h>
 
@@ -74,15 +75,31 @@ void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
 
     wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
 
-    // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
+    // Group vias by layer pair once, instead of scanning all tracks for each layer pair
+    if( !m_viasByLayerPairValid )
     {
-        for( auto track : m_pcb->Tracks() )
+        m_viasByLayerPair.clear();
+
+        for( PCB_TRACK* track : m_pcb->Tracks() )
         {
             if( track->Type() != PCB_VIA_T )
                 continue;
 
-            PCB_VIA* via = static_cast<PCB_VIA*>( track );
+            PCB_VIA*         via = static_cast<PCB_VIA*>( track );
+            DRILL_LAYER_PAIR via_pair;
+
+            via->LayerPair( &via_pair.first, &via_pair.second );
+            m_viasByLayerPair[via_pair].push_back( via );
+        }
+
+        m_viasByLayerPairValid = true;
+    }
+
+    // build hole list for vias
+    if( ! aGenerateNPTH_list && m_viasByLayerPair.count( aLayerPair ) )  // vias are always plated !
+    {
+        for( PCB_VIA* via : m_viasByLayerPair.at( aLayerPair ) )
+        {
             int      hole_sz = via->GetDrillValue();
 
             if( hole_sz == 0 )   // Should not occur.
@@ -187,6 +204,9 @@ void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
     // Sort holes per increasing diameter value (and for each dimater, by position)
     sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), cmpHoleSorting );
 
+    if( m_optimizeHoleOrder )
+        optimizeHolesOrder();
+
     // build the tool list
     int last_hole = -1;     // Set to not initialized (this is a value not used
                             // for m_holeListBuffer[ii].m_Hole_Diameter)
@@ -229,6 +249,150 @@ void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
 }
 
 
+/* Helper function for hole path optimization.
+ * Return the distance along a Hilbert curve of order 16 of the cell (x, y),
+ * x and y being in range 0 ... 0xFFFF
+ */
+static uint64_t hilbertIndex( uint32_t x, uint32_t y )
+{
+    uint64_t d = 0;
+
+    for( uint32_t s = 1 << 15; s > 0; s >>= 1 )
+    {
+        uint32_t rx = ( x & s ) > 0;
+        uint32_t ry = ( y & s ) > 0;
+
+        d += uint64_t( s ) * s * ( ( 3 * rx ) ^ ry );
+
+        // Rotate the quadrant
+        if( ry == 0 )
+        {
+            if( rx == 1 )
+            {
+                x = s - 1 - ( x & ( s - 1 ) );
+                y = s - 1 - ( y & ( s - 1 ) );
+            }
+
+            std::swap( x, y );
+        }
+
+        x &= s - 1;
+        y &= s - 1;
+    }
+
+    return d;
+}
+
+
+/* Helper function for hole path optimization.
+ * Order the holes in range aFirst ... aLast (all using the same tool) to shorten the path
+ * of the drilling machine: holes are first sorted along a Hilbert curve, that keeps close
+ * holes close in the list, and the path is then improved by a nearest neighbour pass
+ * restricted to a small window of the next holes.
+ */
+static void optimizeToolHolesOrder( std::vector<HOLE_INFO>::iterator aFirst,
+                                    std::vector<HOLE_INFO>::iterator aLast )
+{
+    const int count = aLast - aFirst;
+
+    if( count < 3 )
+        return;
+
+    BOX2I bbox( aFirst->m_Hole_Pos, VECTOR2I( 0, 0 ) );
+
+    for( auto it = aFirst; it != aLast; ++it )
+        bbox.Merge( it->m_Hole_Pos );
+
+    double scale = 65535.0 / std::max<int64_t>( { bbox.GetWidth(), bbox.GetHeight(), 1 } );
+
+    std::vector<std::pair<uint64_t, HOLE_INFO>> curve;
+    curve.reserve( count );
+
+    for( auto it = aFirst; it != aLast; ++it )
+    {
+        VECTOR2I rel = it->m_Hole_Pos - bbox.GetOrigin();
+        curve.emplace_back( hilbertIndex( KiROUND( rel.x * scale ), KiROUND( rel.y * scale ) ),
+                            *it );
+    }
+
+    // Ties are resolved by position, to keep the output reproducible
+    std::sort( curve.begin(), curve.end(),
+               []( const std::pair<uint64_t, HOLE_INFO>& a,
+                   const std::pair<uint64_t, HOLE_INFO>& b )
+               {
+                   if( a.first != b.first )
+                       return a.first < b.first;
+
+                   return cmpHoleSorting( a.second, b.second );
+               } );
+
+    for( int ii = 0; ii < count; ii++ )
+        aFirst[ii] = std::move( curve[ii].second );
+
+    const int window = 32;
+
+    for( int ii = 0; ii < count - 2; ii++ )
+    {
+        const VECTOR2I& current = aFirst[ii].m_Hole_Pos;
+        int             best = ii + 1;
+        int64_t         bestDist = ( aFirst[best].m_Hole_Pos - current ).SquaredEuclideanNorm();
+
+        for( int jj = ii + 2; jj < std::min( count, ii + 1 + window ); jj++ )
+        {
+            int64_t dist = ( aFirst[jj].m_Hole_Pos - current ).SquaredEuclideanNorm();
+
+            if( dist < bestDist )
+            {
+                best = jj;
+                bestDist = dist;
+            }
+        }
+
+        if( best != ii + 1 )
+            std::rotate( aFirst + ii + 1, aFirst + best, aFirst + best + 1 );
+    }
+}
+
+
+void GENDRILL_WRITER_BASE::optimizeHolesOrder()
+{
+    // Find the ranges of holes using the same tool (same plated option, diameter and
+    // attribute, see cmpHoleSorting()).  Each range is optimized independently.
+    std::vector<std::pair<size_t, size_t>> ranges;
+
+    for( size_t ii = 0; ii < m_holeListBuffer.size(); )
+    {
+        const HOLE_INFO& first = m_holeListBuffer[ii];
+        size_t           jj = ii + 1;
+
+        while( jj < m_holeListBuffer.size()
+                && m_holeListBuffer[jj].m_Hole_NotPlated == first.m_Hole_NotPlated
+                && m_holeListBuffer[jj].m_Hole_Diameter == first.m_Hole_Diameter
+                && m_holeListBuffer[jj].m_HoleAttribute == first.m_HoleAttribute )
+        {
+            jj++;
+        }
+
+        ranges.emplace_back( ii, jj );
+        ii = jj;
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.parallelize_loop( ranges.size(),
+                            [&]( const int a, const int b )
+                            {
+                                for( int ii = a; ii < b; ++ii )
+                                {
+                                    optimizeToolHolesOrder(
+                                            m_holeListBuffer.begin() + ranges[ii].first,
+                                            m_holeListBuffer.begin() + ranges[ii].second );
+                                }
+                            } );
+    results.wait();
+}
+
+
 std::vector<DRILL_LAYER_PAIR> GENDRILL_WRITER_BASE::getUniqueLayerPairs() const
 {
     wxASSERT( m_pcb );
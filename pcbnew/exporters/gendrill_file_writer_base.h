@@ -35,9 +35,11 @@
 // Set to 1 to add these comments and 0 to not use these comments
 #define USE_ATTRIB_FOR_HOLES 1
 
+#include <map>
 #include <vector>
 
 class BOARD_ITEM;
+class PCB_VIA;
 
 // hole attribute, mainly to identify vias and pads and add this info as comment
 // in NC drill files
@@ -206,6 +208,17 @@ public:
      */
     void SetMergeOption( bool aMerge ) { m_merge_PTH_NPTH = aMerge; }
 
+    /**
+     * Set the option to optimize the order of holes inside each tool.
+     *
+     * By default, holes using the same tool are sorted by X then Y position.  When optimized,
+     * they are ordered along a space filling curve refined by a nearest neighbour pass, to
+     * shorten the path of the drilling machine.  Tools are ordered concurrently.
+     *
+     * @param aOptimize set to true to optimize the drilling path.
+     */
+    void SetOptimizeHoleOrder( bool aOptimize ) { m_optimizeHoleOrder = aOptimize; }
+
     /**
      * Return the plot offset (usually the position of the drill/place origin).
      */
@@ -326,6 +339,13 @@ protected:
      */
     void buildHolesList( DRILL_LAYER_PAIR aLayerPair, bool aGenerateNPTH_list );
 
+    /**
+     * Reorder the holes of each tool in m_holeListBuffer to shorten the drilling path.
+     *
+     * m_holeListBuffer must be already sorted by tool.
+     */
+    void optimizeHolesOrder();
+
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
     /**
@@ -412,7 +432,9 @@ protected:
         m_mapFileFmt      = PLOT_FORMAT::PDF;
         m_pageInfo        = nullptr;
         m_merge_PTH_NPTH  = false;
+        m_optimizeHoleOrder = false;
         m_zeroFormat      = DECIMAL_FORMAT;
+        m_viasByLayerPairValid = false;
     }
 
     BOARD*                   m_pcb;
@@ -426,9 +448,15 @@ protected:
                                                         // inches or mm)
     VECTOR2I                 m_offset;                  // Drill offset coordinates
     bool                     m_merge_PTH_NPTH;          // True to generate only one drill file
+    bool                     m_optimizeHoleOrder;       // True to optimize the drilling path
     std::vector<HOLE_INFO>   m_holeListBuffer;          // Buffer containing holes
     std::vector<DRILL_TOOL>  m_toolListBuffer;          // Buffer containing tools
 
+    // Vias of the board, grouped by layer pair.  Built once, when the first hole list
+    // is created, to avoid scanning all the tracks for each layer pair.
+    std::map<DRILL_LAYER_PAIR, std::vector<PCB_VIA*>> m_viasByLayerPair;
+    bool                     m_viasByLayerPairValid;
+
     PLOT_FORMAT m_mapFileFmt;                           // the format of the map drill file,
                                                         // if this map is needed
     const PAGE_INFO*         m_pageInfo;                // the page info used to plot drill maps
@@ -0,0 +1,201 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "png_stream_writer.h"
+
+#include <cstring>
+
+#include <wx/filefn.h>
+
+
+/// Size of the IDAT chunks written.
+static constexpr size_t IDAT_CHUNK_SIZE = 256 * 1024;
+
+
+static void putUint32( uint8_t* aDest, uint32_t aValue )
+{
+    aDest[0] = ( aValue >> 24 ) & 0xFF;
+    aDest[1] = ( aValue >> 16 ) & 0xFF;
+    aDest[2] = ( aValue >> 8 ) & 0xFF;
+    aDest[3] = aValue & 0xFF;
+}
+
+
+PNG_STREAM_WRITER::PNG_STREAM_WRITER() :
+        m_file( nullptr ),
+        m_stream(),
+        m_streamOpen( false ),
+        m_width( 0 ),
+        m_height( 0 ),
+        m_rowsWritten( 0 )
+{
+}
+
+
+PNG_STREAM_WRITER::~PNG_STREAM_WRITER()
+{
+    if( m_streamOpen )
+        deflateEnd( &m_stream );
+
+    if( m_file )
+        fclose( m_file );
+}
+
+
+bool PNG_STREAM_WRITER::Open( const wxString& aPath, unsigned int aWidth, unsigned int aHeight )
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    if( m_file || aWidth == 0 || aHeight == 0 )
+        return false;
+
+    m_file = wxFopen( aPath, wxT( "wb" ) );
+
+    if( !m_file )
+        return false;
+
+    if( deflateInit( &m_stream, Z_DEFAULT_COMPRESSION ) != Z_OK )
+        return false;
+
+    m_streamOpen = true;
+    m_width = aWidth;
+    m_height = aHeight;
+    m_rowsWritten = 0;
+
+    // One filter type byte in front of each row
+    m_filteredRow.resize( (size_t) aWidth * 4 + 1 );
+    m_idat.resize( IDAT_CHUNK_SIZE );
+
+    m_stream.next_out = m_idat.data();
+    m_stream.avail_out = (uInt) m_idat.size();
+
+    uint8_t header[13];
+
+    putUint32( header, aWidth );
+    putUint32( header + 4, aHeight );
+    header[8] = 8;      // Bit depth
+    header[9] = 6;      // Truecolor with alpha
+    header[10] = 0;     // Deflate
+    header[11] = 0;     // Adaptive filtering
+    header[12] = 0;     // No interlace
+
+    return fwrite( signature, 1, sizeof( signature ), m_file ) == sizeof( signature )
+           && writeChunk( "IHDR", header, sizeof( header ) );
+}
+
+
+bool PNG_STREAM_WRITER::WriteRows( const uint8_t* aRows, unsigned int aCount )
+{
+    if( !m_streamOpen || m_rowsWritten + aCount > m_height )
+        return false;
+
+    const size_t rowSize = (size_t) m_width * 4;
+
+    for( unsigned int ii = 0; ii < aCount; ++ii )
+    {
+        if( !deflateRow( aRows + ii * rowSize, Z_NO_FLUSH ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+bool PNG_STREAM_WRITER::Close()
+{
+    if( !m_streamOpen || m_rowsWritten != m_height )
+        return false;
+
+    bool ok = deflateRow( nullptr, Z_FINISH ) && writeChunk( "IEND", nullptr, 0 );
+
+    deflateEnd( &m_stream );
+    m_streamOpen = false;
+
+    ok = ( fclose( m_file ) == 0 ) && ok;
+    m_file = nullptr;
+
+    return ok;
+}
+
+
+bool PNG_STREAM_WRITER::deflateRow( const uint8_t* aRow, int aFlush )
+{
+    if( aRow )
+    {
+        // The "sub" filter: each byte is stored as the difference with the same channel of
+        // the pixel on its left, which compresses the smooth gradients of renders well
+        uint8_t* out = m_filteredRow.data();
+        size_t   rowSize = (size_t) m_width * 4;
+
+        out[0] = 1;
+        memcpy( out + 1, aRow, 4 );
+
+        for( size_t ii = 4; ii < rowSize; ++ii )
+            out[ii + 1] = aRow[ii] - aRow[ii - 4];
+
+        m_stream.next_in = out;
+        m_stream.avail_in = (uInt) m_filteredRow.size();
+        m_rowsWritten++;
+    }
+
+    while( true )
+    {
+        int ret = deflate( &m_stream, aFlush );
+
+        if( ret == Z_STREAM_ERROR )
+            return false;
+
+        if( m_stream.avail_out == 0 || ( aFlush == Z_FINISH && ret == Z_STREAM_END ) )
+        {
+            if( !writeChunk( "IDAT", m_idat.data(), m_idat.size() - m_stream.avail_out ) )
+                return false;
+
+            m_stream.next_out = m_idat.data();
+            m_stream.avail_out = (uInt) m_idat.size();
+        }
+
+        if( aFlush == Z_FINISH ? ret == Z_STREAM_END : m_stream.avail_in == 0 )
+            return true;
+    }
+}
+
+
+bool PNG_STREAM_WRITER::writeChunk( const char* aType, const uint8_t* aData, size_t aLength )
+{
+    uint8_t header[8];
+    uint8_t footer[4];
+
+    putUint32( header, (uint32_t) aLength );
+    memcpy( header + 4, aType, 4 );
+
+    uLong crc = crc32( 0L, header + 4, 4 );
+
+    if( aLength )
+        crc = crc32( crc, aData, (uInt) aLength );
+
+    putUint32( footer, (uint32_t) crc );
+
+    return fwrite( header, 1, sizeof( header ), m_file ) == sizeof( header )
+           && ( aLength == 0 || fwrite( aData, 1, aLength, m_file ) == aLength )
+           && fwrite( footer, 1, sizeof( footer ), m_file ) == sizeof( footer );
+}
@@ -0,0 +1,77 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PNG_STREAM_WRITER_H
+#define PNG_STREAM_WRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <wx/string.h>
+#include <zlib.h>
+
+
+/**
+ * Write a RGBA PNG image row by row, top row first.
+ *
+ * Unlike wxImage, the image is never held in memory: the rows are compressed and written as
+ * they come, so the size of the image is only limited by the disk.
+ */
+class PNG_STREAM_WRITER
+{
+public:
+    PNG_STREAM_WRITER();
+    ~PNG_STREAM_WRITER();
+
+    /**
+     * Create the file and write the image header.
+     */
+    bool Open( const wxString& aPath, unsigned int aWidth, unsigned int aHeight );
+
+    /**
+     * Append \a aCount rows of 8 bit RGBA pixels.
+     */
+    bool WriteRows( const uint8_t* aRows, unsigned int aCount );
+
+    /**
+     * Flush the compressed data and close the file.  All the rows of the image must have
+     * been written.
+     */
+    bool Close();
+
+private:
+    bool deflateRow( const uint8_t* aRow, int aFlush );
+    bool writeChunk( const char* aType, const uint8_t* aData, size_t aLength );
+
+    FILE*                m_file;
+    z_stream             m_stream;
+    bool                 m_streamOpen;
+    unsigned int         m_width;
+    unsigned int         m_height;
+    unsigned int         m_rowsWritten;
+    std::vector<uint8_t> m_filteredRow;
+    std::vector<uint8_t> m_idat;
+};
+
+#endif // PNG_STREAM_WRITER_H
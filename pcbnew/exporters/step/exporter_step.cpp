@@ -359,36 +359,51 @@ bool EXPORTER_STEP::buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOri
             continue;
         }
 
-        std::string fname( mname.ToUTF8() );
-        std::string refName( aFootprint->GetReference().ToUTF8() );
+        // the rotation is stored in degrees but opencascade wants radians
+        VECTOR3D modelRot = fp_model.m_Rotation;
+        modelRot *= M_PI;
+        modelRot /= 180.0;
+
+        // The model is added by buildComponents3DShapes(), once all model files have been read
+        m_componentModels.push_back( { std::string( mname.ToUTF8() ),
+                                       std::string( aFootprint->GetReference().ToUTF8() ),
+                                       aFootprint->GetLayer() == B_Cu, newpos,
+                                       aFootprint->GetOrientation().AsRadians(),
+                                       fp_model.m_Offset, modelRot, fp_model.m_Scale } );
+        hasdata = true;
+    }
+
+    return hasdata;
+}
+
+
+void EXPORTER_STEP::buildComponents3DShapes()
+{
+    std::vector<std::string> fileNames;
+
+    for( const COMPONENT_MODEL& model : m_componentModels )
+        fileNames.push_back( model.m_fileName );
+
+    m_pcbModel->LoadModels( fileNames );
+
+    for( const COMPONENT_MODEL& model : m_componentModels )
+    {
         try
         {
-            bool bottomSide = aFootprint->GetLayer() == B_Cu;
-
-            // the rotation is stored in degrees but opencascade wants radians
-            VECTOR3D modelRot = fp_model.m_Rotation;
-            modelRot *= M_PI;
-            modelRot /= 180.0;
-
-            if( m_pcbModel->AddComponent( fname, refName, bottomSide,
-                                          newpos,
-                                          aFootprint->GetOrientation().AsRadians(),
-                                          fp_model.m_Offset, modelRot,
-                                          fp_model.m_Scale, m_params.m_SubstModels ) )
-            {
-                hasdata = true;
-            }
+            m_pcbModel->AddComponent( model.m_fileName, model.m_refName, model.m_bottomSide,
+                                      model.m_position, model.m_rotation, model.m_offset,
+                                      model.m_orientation, model.m_scale, m_params.m_SubstModels );
         }
         catch( const Standard_Failure& e )
         {
             ReportMessage( wxString::Format( wxT( "Could not add 3D model to %s.\n"
                                                   "OpenCASCADE error: %s\n" ),
-                                             aFootprint->GetReference(), e.GetMessageString() ) );
+                                             wxString::FromUTF8( model.m_refName ),
+                                             e.GetMessageString() ) );
         }
-
     }
 
-    return hasdata;
+    m_componentModels.clear();
 }
 
 
@@ -670,6 +685,8 @@ bool EXPORTER_STEP::buildBoard3DShapes()
     for( FOOTPRINT* fp : m_board->Footprints() )
         buildFootprint3DShapes( fp, origin, &pcbOutlinesNoArcs );
 
+    buildComponents3DShapes();
+
     for( PCB_TRACK* track : m_board->Tracks() )
         buildTrack3DShape( track, origin );
 
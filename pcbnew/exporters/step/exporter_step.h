@@ -31,6 +31,7 @@
 #include <jobs/job_export_pcb_3d.h>     // For EXPORTER_STEP_PARAMS
 #include <layer_ids.h>
 #include <lset.h>
+#include <math/vector3.h>
 
 
 class PCBMODEL;
@@ -62,6 +63,7 @@ private:
     bool buildTrack3DShape( PCB_TRACK* aTrack, VECTOR2D aOrigin );
     void buildZones3DShape( VECTOR2D aOrigin );
     bool buildGraphic3DShape( BOARD_ITEM* aItem, VECTOR2D aOrigin );
+    void buildComponents3DShapes();
     void initOutputVariant();
 
     EXPORTER_STEP_PARAMS m_params;
@@ -79,6 +81,21 @@ private:
     /// used to identify items in step file
     wxString        m_pcbBaseName;
 
+    /// A footprint 3D model to add once all the model files have been read
+    struct COMPONENT_MODEL
+    {
+        std::string m_fileName;
+        std::string m_refName;
+        bool        m_bottomSide;
+        VECTOR2D    m_position;
+        double      m_rotation;
+        VECTOR3D    m_offset;
+        VECTOR3D    m_orientation;
+        VECTOR3D    m_scale;
+    };
+
+    std::vector<COMPONENT_MODEL> m_componentModels;
+
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_poly_shapes;
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_poly_holes;
 
@@ -25,6 +25,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -34,15 +36,23 @@
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
 #include <wx/stdstream.h>
+#include <wx/utils.h>
+#include <wx/dir.h>
 
 #include <decompress.hpp>
 
+#include <advanced_config.h>
 #include <footprint.h>
+#include <mmh3_hash.h>
 #include <pad.h>
+#include <paths.h>
+#include <pgm_base.h>
+#include <settings/common_settings.h>
 #include <pcb_track.h>
 #include <kiplatform/io.h>
 #include <string_utils.h>
 #include <build_version.h>
+#include <thread_pool.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_circle.h>
 #include <board_stackup_manager/board_stackup.h>
@@ -58,6 +68,8 @@
 #include <IGESData_IGESModel.hxx>
 #include <Interface_Static.hxx>
 #include <Quantity_Color.hxx>
+#include <BinXCAFDrivers.hxx>
+#include <STEPCAFControl_Controller.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
@@ -236,6 +248,125 @@ MODEL3D_FORMAT_TYPE fileType( const char* aFileName )
 }
 
 
+/**
+ * Delete the converted models which were not used for \a aNumDaysOld days.  Cache hits touch
+ * their file, so the modification time is the last use.
+ */
+static void cleanModelCacheDir( const wxString& aCacheDir, int aNumDaysOld )
+{
+    wxArrayString fileList;
+    wxDateTime    lastUse;
+    wxDateTime    thresholdDate = wxDateTime::Now() - wxDateSpan::Days( aNumDaysOld );
+
+    wxDir::GetAllFiles( aCacheDir, &fileList, wxT( "*.xbf" ), wxDIR_FILES );
+
+    for( const wxString& file : fileList )
+    {
+        wxFileName fn( file );
+
+        if( fn.GetTimes( nullptr, &lastUse, nullptr ) && lastUse.IsEarlierThan( thresholdDate ) )
+            wxRemoveFile( file );
+    }
+}
+
+
+/**
+ * @return the directory of the converted model cache, or an empty string if it is disabled.
+ */
+static wxString modelCacheDir()
+{
+    if( ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache )
+        return wxEmptyString;
+
+    wxFileName cacheDir;
+    cacheDir.AssignDir( PATHS::GetUserCachePath() );
+    cacheDir.AppendDir( wxT( "step" ) );
+
+    if( !PATHS::EnsurePathExists( cacheDir.GetPath() ) )
+        return wxEmptyString;
+
+    // Expire old entries once per session, with the same interval as the 3D model cache.  An
+    // interval of zero means the user doesn't want to ever clear the cache.
+    static std::once_flag cleaned;
+
+    std::call_once( cleaned,
+                    [&]()
+                    {
+                        PGM_BASE* pgm = PgmOrNull();
+                        int       interval = 0;
+
+                        if( pgm && pgm->GetCommonSettings() )
+                            interval = pgm->GetCommonSettings()->m_System.clear_3d_cache_interval;
+
+                        if( interval > 0 )
+                            cleanModelCacheDir( cacheDir.GetPath(), interval );
+                    } );
+
+    return cacheDir.GetPathWithSep();
+}
+
+
+/**
+ * @return the cache file name for the contents of a model file, or an empty string if the
+ *         cache is disabled or the file cannot be read.  Safe to call from worker threads.
+ */
+static wxString modelCacheFile( const wxString& aCacheDir, const std::string& aFileNameUTF8 )
+{
+    if( aCacheDir.IsEmpty() )
+        return wxEmptyString;
+
+    FILE* fp = wxFopen( wxString::FromUTF8( aFileNameUTF8.c_str() ), wxT( "rb" ) );
+
+    if( !fp )
+        return wxEmptyString;
+
+    MMH3_HASH         hash( 0x5354E950 );
+    std::vector<char> block( 65536 );
+    size_t            size = 0;
+
+    while( ( size = fread( block.data(), 1, block.size(), fp ) ) > 0 )
+        hash.addData( reinterpret_cast<const uint8_t*>( block.data() ), size );
+
+    fclose( fp );
+
+    return aCacheDir + hash.digest().ToString() + wxT( ".xbf" );
+}
+
+
+/**
+ * Register the binary XCAF format used by the model cache with the (singleton) application.
+ */
+static void defineModelCacheFormat( const Handle( XCAFApp_Application )& aApp )
+{
+    static std::once_flag formatDefined;
+    std::call_once( formatDefined, [&]() { BinXCAFDrivers::DefineFormat( aApp ); } );
+}
+
+
+/**
+ * Set the precision used when reading models.  This writes global reader parameters, so it
+ * must not be called while models are read on other threads.
+ */
+static bool setReadPrecision()
+{
+    // Enable user-defined shape precision
+    if( Interface_Static::IVal( "read.precision.mode" ) != 1
+            && !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+    {
+        return false;
+    }
+
+    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
+    if( Interface_Static::RVal( "read.precision.val" ) != USER_PREC
+            && !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
 static VECTOR2D CircleCenterFrom3Points( const VECTOR2D& p1, const VECTOR2D& p2,
                                          const VECTOR2D& p3 )
 {
@@ -779,6 +910,16 @@ STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName )
 
 STEP_PCB_MODEL::~STEP_PCB_MODEL()
 {
+    // Release the model documents, so that cached models can be opened again by a later export.
+    // Files with identical contents share a document.
+    std::set<TDocStd_Document*> closed;
+
+    for( auto& [fileName, doc] : m_modelDocs )
+    {
+        if( !doc.IsNull() && closed.insert( doc.get() ).second && doc->CanClose() == CDM_CCS_OK )
+            doc->Close();
+    }
+
     if( m_doc->CanClose() == CDM_CCS_OK )
         m_doc->Close();
 }
@@ -1189,6 +1330,132 @@ bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LA
 }
 
 
+void STEP_PCB_MODEL::LoadModels( const std::vector<std::string>& aFileNamesUTF8 )
+{
+    struct MODEL_READ
+    {
+        std::string                fileName;
+        wxString                   cacheFile;
+        Handle( TDocStd_Document ) doc;
+        bool                       cached = false;
+        bool                       success = false;
+    };
+
+    std::vector<MODEL_READ> reads;
+    std::set<std::string>   seen;
+
+    for( const std::string& fileName : aFileNamesUTF8 )
+    {
+        if( m_modelDocs.count( fileName ) || !seen.insert( fileName ).second )
+            continue;
+
+        // The IGES reader is not reentrant, and compressed and VRML models need more work to
+        // find the data to read.  These are read when the component is added.
+        if( fileType( fileName.c_str() ) == FMT_STEP )
+            reads.push_back( { fileName } );
+    }
+
+    if( reads.empty() )
+        return;
+
+    thread_pool& tp = GetKiCadThreadPool();
+    wxString     cacheDir = modelCacheDir();
+
+    auto hashResults = tp.parallelize_loop( reads.size(),
+                            [&]( const int a, const int b )
+                            {
+                                for( int ii = a; ii < b; ++ii )
+                                {
+                                    reads[ii].cacheFile = modelCacheFile( cacheDir,
+                                                                          reads[ii].fileName );
+                                }
+                            } );
+    hashResults.wait();
+
+    // Documents are owned by the application, which is not thread safe, so create or retrieve
+    // them here.  Files with identical contents share the first one's document.
+    std::map<wxString, size_t> readsByCacheFile;
+    std::vector<size_t>        toRead;
+
+    for( size_t ii = 0; ii < reads.size(); ++ii )
+    {
+        MODEL_READ& read = reads[ii];
+
+        if( !read.cacheFile.IsEmpty() )
+        {
+            auto [it, inserted] = readsByCacheFile.emplace( read.cacheFile, ii );
+
+            if( !inserted )
+                continue;
+
+            read.cached = readModelCache( read.cacheFile, read.doc );
+        }
+
+        if( read.cached )
+        {
+            read.success = true;
+        }
+        else
+        {
+            m_app->NewDocument( "MDTV-XCAF", read.doc );
+            toRead.push_back( ii );
+        }
+    }
+
+    if( !toRead.empty() )
+    {
+        ReportMessage( wxString::Format( wxT( "Reading %d 3D model files.\n" ),
+                                         static_cast<int>( toRead.size() ) ) );
+
+        // Register the reader parameters before the readers run concurrently
+        STEPCAFControl_Controller::Init();
+        bool precisionSet = setReadPrecision();
+
+        auto readResults = tp.parallelize_loop( toRead.size(),
+                                [&]( const int a, const int b )
+                                {
+                                    for( int ii = a; ii < b && precisionSet; ++ii )
+                                    {
+                                        MODEL_READ& read = reads[toRead[ii]];
+                                        read.success = transferSTEP( read.doc,
+                                                                     read.fileName.c_str() );
+                                    }
+                                } );
+        readResults.wait();
+
+        // Closing a document changes the application, so it is only done here
+        for( size_t ii : toRead )
+        {
+            MODEL_READ& read = reads[ii];
+
+            if( !read.success && read.doc->CanClose() == CDM_CCS_OK )
+                read.doc->Close();
+        }
+    }
+
+    for( MODEL_READ& read : reads )
+    {
+        if( !read.cacheFile.IsEmpty() )
+        {
+            const MODEL_READ& first = reads[readsByCacheFile[read.cacheFile]];
+
+            if( &first != &read )
+            {
+                read.doc = first.doc;
+                read.success = first.success;
+            }
+            else if( read.success && !read.cached )
+            {
+                writeModelCache( read.cacheFile, read.doc );
+            }
+        }
+
+        // Failures are reported when the component is added
+        m_modelDocs[read.fileName] = read.success ? read.doc : Handle( TDocStd_Document )();
+    }
+}
+
+
 bool STEP_PCB_MODEL::AddComponent( const std::string& aFileNameUTF8, const std::string& aRefDes,
                              bool aBottom, VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
                              VECTOR3D aOrientation, VECTOR3D aScale, bool aSubstituteModels )
@@ -1472,8 +1739,13 @@ static wxString formatBBox( const BOX2I& aBBox )
 }
 
 
+/**
+ * Problems are appended to \a aMessages rather than reported, as this runs on the thread
+ * pool when building large polygon sets.
+ */
 static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN& aChain,
-                               double aMergeOCCMaxDist, double aZposition, const VECTOR2D& aOrigin )
+                               double aMergeOCCMaxDist, double aZposition, const VECTOR2D& aOrigin,
+                               wxString& aMessages )
 {
     auto toPoint = [&]( const VECTOR2D& aKiCoords ) -> gp_Pnt
     {
@@ -1495,9 +1767,9 @@ static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN
 
             if( !mkEdge.IsDone() || mkEdge.Edge().IsNull() )
             {
-                ReportMessage( wxString::Format( wxT( "failed to make segment edge at (%d "
-                                                      "%d) -> (%d %d), skipping\n" ),
-                                                 aPt0.x, aPt0.y, aPt1.x, aPt1.y ) );
+                aMessages.Append( wxString::Format( wxT( "failed to make segment edge at (%d "
+                                                         "%d) -> (%d %d), skipping\n" ),
+                                                    aPt0.x, aPt0.y, aPt1.x, aPt1.y ) );
             }
             else
             {
@@ -1505,9 +1777,9 @@ static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN
 
                 if( aMkWire.Error() != BRepLib_WireDone )
                 {
-                    ReportMessage( wxString::Format( wxT( "failed to add segment edge "
-                                                          "at (%d %d) -> (%d %d)\n" ),
-                                                     aPt0.x, aPt0.y, aPt1.x, aPt1.y ) );
+                    aMessages.Append( wxString::Format( wxT( "failed to add segment edge "
+                                                             "at (%d %d) -> (%d %d)\n" ),
+                                                        aPt0.x, aPt0.y, aPt1.x, aPt1.y ) );
                     return false;
                 }
             }
@@ -1541,11 +1813,11 @@ static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN
 
             if( !aMkWire.IsDone() )
             {
-                ReportMessage( wxString::Format(
-                        wxT( "failed to add arc curve from (%d %d), arc p0 "
-                             "(%d %d), mid (%d %d), p1 (%d %d)\n" ),
-                        aPt0.x, aPt0.y, aArc.GetP0().x, aArc.GetP0().y, aArc.GetArcMid().x,
-                        aArc.GetArcMid().y, aArc.GetP1().x, aArc.GetP1().y ) );
+                aMessages.Append( wxString::Format(
+                           wxT( "failed to add arc curve from (%d %d), arc p0 "
+                                "(%d %d), mid (%d %d), p1 (%d %d)\n" ),
+                           aPt0.x, aPt0.y, aArc.GetP0().x, aArc.GetP0().y, aArc.GetArcMid().x,
+                           aArc.GetArcMid().y, aArc.GetP1().x, aArc.GetP1().y ) );
                 return false;
             }
 
@@ -1615,7 +1887,7 @@ static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN
 
         if( lastPt != firstPt && !addSegment( lastPt, firstPt ) )
         {
-            ReportMessage(
+            aMessages.Append(
                     wxString::Format( wxT( "** Failed to close wire at %d, %d -> %d, %d **\n" ),
                                       lastPt.x, lastPt.y, firstPt.x, firstPt.y ) );
 
@@ -1624,8 +1896,8 @@ static bool makeWireFromChain( BRepLib_MakeWire& aMkWire, const SHAPE_LINE_CHAIN
     }
     catch( const Standard_Failure& e )
     {
-        ReportMessage( wxString::Format( wxT( "makeWireFromChain: OCC exception: %s\n" ),
-                                         e.GetMessageString() ) );
+        aMessages.Append( wxString::Format( wxT( "makeWireFromChain: OCC exception: %s\n" ),
+                                            e.GetMessageString() ) );
         return false;
     }
 
@@ -1687,17 +1959,20 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
     gp_Pln basePlane( gp_Pnt( 0.0, 0.0, aZposition ),
                       std::signbit( aThickness ) ? -gp::DZ() : gp::DZ() );
 
-    for( size_t polyId = 0; polyId < workingPoly.CPolygons().size(); polyId++ )
+    // Build the shape of a single polygon.  Returns false on a fatal error, and leaves aShape
+    // null if the polygon was skipped.
+    auto makePolygonShape = [&]( size_t polyId, TopoDS_Shape& aShape ) -> bool
     {
-        SHAPE_POLY_SET::POLYGON& polygon = workingPoly.Polygon( polyId );
+        const SHAPE_POLY_SET::POLYGON& polygon = workingPoly.CPolygon( polyId );
 
-        auto tryMakeWire = [this, &aZposition,
-                            &aOrigin]( const SHAPE_LINE_CHAIN& aContour ) -> TopoDS_Wire
+        auto tryMakeWire = [this, &aZposition, &aOrigin,
+                            &aMessages]( const SHAPE_LINE_CHAIN& aContour ) -> TopoDS_Wire
         {
             TopoDS_Wire      wire;
             BRepLib_MakeWire mkWire;
 
-            makeWireFromChain( mkWire, aContour, m_mergeOCCMaxDist, aZposition, aOrigin );
+            makeWireFromChain( mkWire, aContour, m_mergeOCCMaxDist, aZposition, aOrigin,
+                               aMessages );
 
             if( mkWire.IsDone() )
             {
@@ -1705,13 +1980,13 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
             }
             else
             {
-                ReportMessage(
+                aMessages.Append(
                         wxString::Format( _( "Wire not done (contour points %d): OCC error %d\n" ),
                                           static_cast<int>( aContour.PointCount() ),
                                           static_cast<int>( mkWire.Error() ) ) );
 
-                ReportMessage( wxString::Format( _( "z: %g; bounding box: %s\n" ), aZposition,
-                                                 formatBBox( aContour.BBox() ) ) );
+                aMessages.Append( wxString::Format( _( "z: %g; bounding box: %s\n" ), aZposition,
+                                                    formatBBox( aContour.BBox() ) ) );
             }
 
             if( !wire.IsNull() )
@@ -1720,11 +1995,12 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 
                 if( !check.IsValid() )
                 {
-                    ReportMessage( wxString::Format( _( "\nWire self-interference check "
-                                                        "failed\n" ) ) );
+                    aMessages.Append( wxString::Format( _( "\nWire self-interference check "
+                                                           "failed\n" ) ) );
 
-                    ReportMessage( wxString::Format( _( "z: %g; bounding box: %s\n" ), aZposition,
-                                                     formatBBox( aContour.BBox() ) ) );
+                    aMessages.Append( wxString::Format( _( "z: %g; bounding box: %s\n" ),
+                                                        aZposition,
+                                                        formatBBox( aContour.BBox() ) ) );
 
                     wire.Nullify();
                 }
@@ -1743,7 +2019,7 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 
                 if( aConvertToArcs && wire.IsNull() )
                 {
-                    ReportMessage( wxString::Format( _( "Using non-simplified polygon.\n" ) ) );
+                    aMessages.Append( wxString::Format( _( "Using non-simplified polygon.\n" ) ) );
 
                     // Fall back to original shape
                     wire = tryMakeWire( fallbackPoly.CPolygon( polyId )[contId] );
@@ -1760,11 +2036,12 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
                     }
                     else
                     {
-                        ReportMessage( wxString::Format( wxT( "\n** Outline skipped **\n" ) ) );
+                        aMessages.Append( wxString::Format( wxT( "\n** Outline skipped **\n" ) ) );
 
-                        ReportMessage( wxString::Format( wxT( "z: %g; bounding box: %s\n" ),
-                                                         aZposition,
-                                                         formatBBox( polygon[contId].BBox() ) ) );
+                        aMessages.Append( wxString::Format( wxT( "z: %g; bounding box: %s\n" ),
+                                                            aZposition,
+                                                            formatBBox(
+                                                                    polygon[contId].BBox() ) ) );
 
                         break;
                     }
@@ -1780,17 +2057,18 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
                     }
                     else
                     {
-                        ReportMessage( wxString::Format( wxT( "\n** Hole skipped **\n" ) ) );
+                        aMessages.Append( wxString::Format( wxT( "\n** Hole skipped **\n" ) ) );
 
-                        ReportMessage( wxString::Format( wxT( "z: %g; bounding box: %s\n" ),
-                                                         aZposition,
-                                                         formatBBox( polygon[contId].BBox() ) ) );
+                        aMessages.Append( wxString::Format( wxT( "z: %g; bounding box: %s\n" ),
+                                                            aZposition,
+                                                            formatBBox(
+                                                                    polygon[contId].BBox() ) ) );
                     }
                 }
             }
             catch( const Standard_Failure& e )
             {
-                ReportMessage(
+                aMessages.Append(
                         wxString::Format( wxT( "MakeShapes (contour %d): OCC exception: %s\n" ),
                                           static_cast<int>( contId ), e.GetMessageString() ) );
                 return false;
@@ -1804,24 +2082,73 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
             if( aThickness != 0.0 )
             {
                 TopoDS_Shape prism = BRepPrimAPI_MakePrism( faceShape, gp_Vec( 0, 0, aThickness ) );
-                aShapes.push_back( prism );
+                aShape = prism;
 
                 if( prism.IsNull() )
                 {
-                    ReportMessage( _( "Failed to create a prismatic shape\n" ) );
+                    aMessages.Append( _( "Failed to create a prismatic shape\n" ) );
                     return false;
                 }
             }
             else
             {
-                aShapes.push_back( faceShape );
+                aShape = faceShape;
             }
         }
         else
         {
-            ReportMessage( wxString::Format( _( "** Face skipped **\n" ) ) );
+            aMessages.Append( wxString::Format( _( "** Face skipped **\n" ) ) );
+        }
+
+        return true;
+    };
+
+    // Polygons are independent of each other, so large sets (copper zones and tracks of a
+    // whole layer) are built concurrently.  The shapes are still appended in polygon order.
+    size_t                    polyCount = workingPoly.OutlineCount();
+    std::vector<TopoDS_Shape> polyShapes( polyCount );
+    std::vector<char>         polyResults( polyCount, 1 );
+    std::vector<wxString>     polyMessages( polyCount );
+
+    if( polyCount < 16 )
+    {
+        for( size_t polyId = 0; polyId < polyCount; polyId++ )
+        {
+            polyResults[polyId] = makePolygonShape( polyId, polyShapes[polyId],
+                                                    polyMessages[polyId] );
+
+            if( !polyResults[polyId] )
+                break;
         }
     }
+    else
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+
+        auto results = tp.parallelize_loop( polyCount,
+                                [&]( const int a, const int b )
+                                {
+                                    for( int ii = a; ii < b; ++ii )
+                                    {
+                                        polyResults[ii] = makePolygonShape( ii, polyShapes[ii],
+                                                                            polyMessages[ii] );
+                                    }
+                                } );
+        results.wait();
+    }
+
+    // Report from this thread, in polygon order
+    for( size_t polyId = 0; polyId < polyCount; polyId++ )
+    {
+        if( !polyMessages[polyId].IsEmpty() )
+            ReportMessage( polyMessages[polyId] );
+
+        if( !polyResults[polyId] )
+            return false;
+
+        if( !polyShapes[polyId].IsNull() )
+            aShapes.push_back( polyShapes[polyId] );
+    }
 
     return true;
 }
@@ -2559,8 +2886,9 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
 
     aLabel.Nullify();
 
+    // STEP and IGES documents come from loadModelDoc(); the other formats that read into a
+    // document create it themselves, so that no unused document is left open in m_app
     Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
 
     wxString fileName( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
     MODEL3D_FORMAT_TYPE modelFmt = fileType( aFileNameUTF8.c_str() );
@@ -2568,7 +2896,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     switch( modelFmt )
     {
     case FMT_IGES:
-        if( !readIGES( doc, aFileNameUTF8.c_str() ) )
+        if( !loadModelDoc( aFileNameUTF8, true, doc ) )
         {
             ReportMessage( wxString::Format( wxT( "readIGES() failed on filename '%s'.\n" ),
                                              fileName ) );
@@ -2577,7 +2905,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
         break;
 
     case FMT_STEP:
-        if( !readSTEP( doc, aFileNameUTF8.c_str() ) )
+        if( !loadModelDoc( aFileNameUTF8, false, doc ) )
         {
             ReportMessage( wxString::Format( wxT( "readSTEP() failed on filename '%s'.\n" ),
                                              fileName ) );
@@ -2725,6 +3053,8 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
                 }
             }
 
+            m_app->NewDocument( "MDTV-XCAF", doc );
+
             // VRML models only work when exporting to glTF
             // Also OCCT < 7.9.0 fail to load most VRML 2.0 models because of Switch nodes
             if( m_outFmt == OUTPUT_FORMAT::FMT_OUT_GLTF )
@@ -2857,6 +3187,96 @@ bool STEP_PCB_MODEL::getModelLocation( bool aBottom, VECTOR2D aPosition, double
 }
 
 
+bool STEP_PCB_MODEL::loadModelDoc( const std::string& aFileNameUTF8, bool aIges,
+                                   Handle( TDocStd_Document ) & aDoc )
+{
+    auto it = m_modelDocs.find( aFileNameUTF8 );
+
+    if( it != m_modelDocs.end() )
+    {
+        aDoc = it->second;
+        return !aDoc.IsNull();
+    }
+
+    wxString cacheFile = modelCacheFile( modelCacheDir(), aFileNameUTF8 );
+    bool     success = !cacheFile.IsEmpty() && readModelCache( cacheFile, aDoc );
+
+    if( !success )
+    {
+        m_app->NewDocument( "MDTV-XCAF", aDoc );
+
+        if( aIges )
+            success = readIGES( aDoc, aFileNameUTF8.c_str() );
+        else
+            success = readSTEP( aDoc, aFileNameUTF8.c_str() );
+
+        if( success && !cacheFile.IsEmpty() )
+            writeModelCache( cacheFile, aDoc );
+    }
+
+    m_modelDocs[aFileNameUTF8] = success ? aDoc : Handle( TDocStd_Document )();
+    return success;
+}
+
+
+bool STEP_PCB_MODEL::readModelCache( const wxString& aCacheFile,
+                                     Handle( TDocStd_Document ) & aDoc )
+{
+    defineModelCacheFormat( m_app );
+
+    if( !wxFileName::FileExists( aCacheFile ) )
+        return false;
+
+    try
+    {
+        if( m_app->Open( TCollection_ExtendedString( aCacheFile.utf8_str(), true ), aDoc )
+                == PCDM_RS_OK )
+        {
+            // Keep the entry from expiring while it is in use
+            wxFileName( aCacheFile ).Touch();
+            return true;
+        }
+    }
+    catch( const Standard_Failure& e )
+    {
+        ReportMessage( wxString::Format( wxT( "Could not read model cache file '%s': %s\n" ),
+                                         aCacheFile, e.GetMessageString() ) );
+    }
+
+    aDoc.Nullify();
+    return false;
+}
+
+
+void STEP_PCB_MODEL::writeModelCache( const wxString& aCacheFile,
+                                      Handle( TDocStd_Document ) & aDoc )
+{
+    defineModelCacheFormat( m_app );
+
+    // Write to a temporary file first, so that another export never reads a partial file
+    wxString tmpFile = wxString::Format( wxT( "%s.%lu.tmp" ), aCacheFile, wxGetProcessId() );
+
+    try
+    {
+        aDoc->ChangeStorageFormat( "BinXCAF" );
+
+        if( m_app->SaveAs( aDoc, TCollection_ExtendedString( tmpFile.utf8_str(), true ) )
+                == PCDM_SS_OK )
+        {
+            wxRenameFile( tmpFile, aCacheFile, true );
+        }
+    }
+    catch( const Standard_Failure& e )
+    {
+        ReportMessage( wxString::Format( wxT( "Could not write model cache file '%s': %s\n" ),
+                                         aCacheFile, e.GetMessageString() ) );
+    }
+
+    if( wxFileName::FileExists( tmpFile ) )
+        wxRemoveFile( tmpFile );
+}
+
+
 bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 {
     IGESControl_Controller::Init();
@@ -2866,12 +3286,7 @@ bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fnam
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    if( !setReadPrecision() )
         return false;
 
     // set other translation options
@@ -2900,37 +3315,38 @@ bool STEP_PCB_MODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fnam
 }
 
 
-bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fname )
+/**
+ * Read a STEP file into \a aDoc.  Touches neither the application nor the global reader
+ * parameters, so several files can be read concurrently once setReadPrecision() was called.
+ * On failure the document is left open for the caller to close.
+ */
+static bool transferSTEP( Handle( TDocStd_Document ) & aDoc, const char* aFileName )
 {
     STEPCAFControl_Reader reader;
-    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
+    IFSelect_ReturnStatus stat  = reader.ReadFile( aFileName );
 
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
     // set other translation options
     reader.SetColorMode( true );  // use model colors
     reader.SetNameMode( true );  // use label names
     reader.SetLayerMode( false ); // ignore LAYER data
 
-    if( !reader.Transfer( doc ) )
-    {
-        if( doc->CanClose() == CDM_CCS_OK )
-            doc->Close();
-
+    if( !reader.Transfer( aDoc ) )
         return false;
-    }
 
     // are there any shapes to translate?
-    if( reader.NbRootsForTransfer() < 1 )
+    return reader.NbRootsForTransfer() >= 1;
+}
+
+
+bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fname )
+{
+    if( !setReadPrecision() )
+        return false;
+
+    if( !transferSTEP( doc, fname ) )
     {
         if( doc->CanClose() == CDM_CCS_OK )
             doc->Close();
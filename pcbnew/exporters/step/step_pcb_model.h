@@ -115,6 +115,15 @@ public:
     bool AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
                            const VECTOR2D& aOrigin );
 
+    /**
+     * Read the given 3D model files ahead of AddComponent(), so that a board with many
+     * different models doesn't read them one at a time.
+     *
+     * STEP files are read concurrently.  Models already converted by a previous export are
+     * taken from the user's model cache instead, which is keyed by the file contents.
+     */
+    void LoadModels( const std::vector<std::string>& aFileNamesUTF8 );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes, bool aBottom,
                        VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
@@ -219,6 +228,8 @@ public:
     bool WriteSTL( const wxString& aFileName );
 
 private:
+    friend struct STEP_MODEL_CACHE_FIXTURE; // inspects m_modelDocs
+
     /**
      * @return true if the board(s) outline is valid. False otherwise
      */
@@ -248,6 +259,16 @@ private:
     bool getModelLocation( bool aBottom, VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
                            VECTOR3D aOrientation, TopLoc_Location& aLocation );
 
+    /**
+     * Read a STEP or IGES model file into a document of its own, or find the document it was
+     * already read into.  Uses the model cache when enabled.
+     */
+    bool loadModelDoc( const std::string& aFileNameUTF8, bool aIges,
+                       Handle( TDocStd_Document ) & aDoc );
+
+    bool readModelCache( const wxString& aCacheFile, Handle( TDocStd_Document ) & aDoc );
+    void writeModelCache( const wxString& aCacheFile, Handle( TDocStd_Document ) & aDoc );
+
     bool readIGES( Handle( TDocStd_Document ) & aDoc, const char* aFname );
     bool readSTEP( Handle( TDocStd_Document ) & aDoc, const char* aFname );
     bool readVRML( Handle( TDocStd_Document ) & aDoc, const char* aFname );
@@ -266,6 +287,7 @@ private:
     bool                            m_fuseShapes;       // fuse geometry together
     std::vector<TDF_Label>          m_pcb_labels;       // labels for the PCB model (one by main outline)
     MODEL_MAP                       m_models;           // map of file names to model labels
+    std::map<std::string, Handle( TDocStd_Document )> m_modelDocs; // model files already read
     int                             m_components;       // number of successfully loaded components;
     double                          m_precision;        // model (length unit) numeric precision
     double                          m_angleprec;        // angle numeric precision
@@ -2327,7 +2327,8 @@ void PCB_TUNING_PATTERN::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame,
     std::shared_ptr<DRC_ENGINE>& drcEngine = board->GetDesignSettings().m_DRCEngine;
     DRC_CONSTRAINT               constraint;
 
-    // Display full track length (in Pcbnew)
+    // Display full track length (in Pcbnew).  GetTrackLength() results are cached per net, so
+    // refreshing the panel while dragging only measures nets changed since the last refresh.
     if( board && primaryItem && primaryItem->GetNetCode() > 0 )
     {
         int    count = 0;
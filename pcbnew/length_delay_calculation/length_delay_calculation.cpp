@@ -23,11 +23,40 @@
 
 #include <length_delay_calculation/length_delay_calculation.h>
 
+#include <algorithm>
+
 #include <board.h>
 #include <board_design_settings.h>
 #include <geometry/geometry_utils.h>
 
 
+/// Number of distinct item sets (e.g. whole net and connected clusters) cached per net
+static constexpr size_t MAX_CACHED_SETS_PER_NET = 4;
+
+
+LENGTH_DELAY_STATS LENGTH_DELAY_STATS::Clone() const
+{
+    LENGTH_DELAY_STATS copy;
+
+    copy.NumPads = NumPads;
+    copy.NumVias = NumVias;
+    copy.ViaLength = ViaLength;
+    copy.TrackLength = TrackLength;
+    copy.PadToDieLength = PadToDieLength;
+    copy.ViaDelay = ViaDelay;
+    copy.TrackDelay = TrackDelay;
+    copy.PadToDieDelay = PadToDieDelay;
+
+    if( LayerLengths )
+        copy.LayerLengths = std::make_unique<std::map<PCB_LAYER_ID, int64_t>>( *LayerLengths );
+
+    if( LayerDelays )
+        copy.LayerDelays = std::make_unique<std::map<PCB_LAYER_ID, int64_t>>( *LayerDelays );
+
+    return copy;
+}
+
+
 void LENGTH_DELAY_CALCULATION_ITEM::CalculateViaLayers( const BOARD* aBoard )
 {
     static std::initializer_list<KICAD_T> traceAndPadTypes = { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T };
@@ -114,7 +143,7 @@ LENGTH_DELAY_STATS LENGTH_DELAY_CALCULATION::CalculateLengthDetails( std::vector
                                                                      const LENGTH_DELAY_DOMAIN_OPT aDomain ) const
 {
     // If this set of items has not been optimised, optimise for shortest electrical path
-    if( aOptimisations.OptimiseViaLayers || aOptimisations.MergeTracks || aOptimisations.MergeTracks )
+    if( aOptimisations.OptimiseViaLayers || aOptimisations.MergeTracks || aOptimisations.OptimiseTracesInPads )
     {
         std::vector<LENGTH_DELAY_CALCULATION_ITEM*> pads;
         std::vector<LENGTH_DELAY_CALCULATION_ITEM*> lines;
@@ -171,7 +200,7 @@ LENGTH_DELAY_STATS LENGTH_DELAY_CALCULATION::CalculateLengthDetails( std::vector
     // If this is a contiguous set of items, check if we have an inferred fanout via at either end. Note that this
     // condition only arises as a result of how PNS assembles tuning paths - for DRC / net inspector calculations these
     // fanout vias will be present in the object set and therefore do not need to be inferred
-    if( aOptimisations.InferViaInPad && useHeight )
+    if( aOptimisations.InferViaInPad && useHeight && !aItems.empty() )
     {
         inferViaInPad( aStartPad, aItems.front(), details );
         inferViaInPad( aEndPad, aItems.back(), details );
@@ -211,7 +240,7 @@ LENGTH_DELAY_STATS LENGTH_DELAY_CALCULATION::CalculateLengthDetails( std::vector
     }
 
     // Calculate the time domain statistics if required
-    if( aDomain == LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL )
+    if( aDomain == LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL && !aItems.empty() )
     {
         // TODO(JJ): Populate this
         TIME_DOMAIN_GEOMETRY_CONTEXT ctx;
@@ -422,16 +451,34 @@ void LENGTH_DELAY_CALCULATION::mergeShapeLineChains( SHAPE_LINE_CHAIN& aPrimary,
 void LENGTH_DELAY_CALCULATION::optimiseTracesInPads( const std::vector<LENGTH_DELAY_CALCULATION_ITEM*>& aPads,
                                                      const std::vector<LENGTH_DELAY_CALCULATION_ITEM*>& aLines )
 {
+    // Only lines ending at a pad position can be optimised, so index the (merged) lines by their endpoints rather
+    // than testing every line against every pad
+    std::map<VECTOR2I, std::vector<LENGTH_DELAY_CALCULATION_ITEM*>> linesByEndpoint;
+
+    for( LENGTH_DELAY_CALCULATION_ITEM* lineItem : aLines )
+    {
+        // Ignore merged lines
+        if( lineItem->GetMergeStatus() != LENGTH_DELAY_CALCULATION_ITEM::MERGE_STATUS::MERGED_IN_USE )
+            continue;
+
+        const SHAPE_LINE_CHAIN& line = lineItem->GetLine();
+
+        linesByEndpoint[line.CPoint( 0 )].push_back( lineItem );
+
+        if( line.CLastPoint() != line.CPoint( 0 ) )
+            linesByEndpoint[line.CLastPoint()].push_back( lineItem );
+    }
+
     for( LENGTH_DELAY_CALCULATION_ITEM* padItem : aPads )
     {
         const PAD* pad = padItem->GetPad();
+        auto       it = linesByEndpoint.find( pad->GetPosition() );
 
-        for( LENGTH_DELAY_CALCULATION_ITEM* lineItem : aLines )
-        {
-            // Ignore merged lines
-            if( lineItem->GetMergeStatus() != LENGTH_DELAY_CALCULATION_ITEM::MERGE_STATUS::MERGED_IN_USE )
-                continue;
+        if( it == linesByEndpoint.end() )
+            continue;
 
+        for( LENGTH_DELAY_CALCULATION_ITEM* lineItem : it->second )
+        {
             const PCB_LAYER_ID pcbLayer = lineItem->GetStartLayer();
             SHAPE_LINE_CHAIN&  line = lineItem->GetLine();
 
@@ -553,9 +600,37 @@ LENGTH_DELAY_CALCULATION::GetLengthCalculationItem( const BOARD_CONNECTED_ITEM*
 
             LENGTH_DELAY_CALCULATION_ITEM item;
             item.SetVia( via );
-            item.CalculateViaLayers( m_board );
             item.SetEffectiveNetClass( via->GetEffectiveNetClass() );
 
+            // Finding the connected layer span queries connectivity on every copper layer, so remember it until
+            // the net changes
+            {
+                std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+                auto netIt = m_netCache.find( via->GetNetCode() );
+
+                if( netIt != m_netCache.end() )
+                {
+                    auto viaIt = netIt->second.ViaLayers.find( via );
+
+                    if( viaIt != netIt->second.ViaLayers.end() )
+                    {
+                        item.SetLayers( viaIt->second.first, viaIt->second.second );
+                        return item;
+                    }
+                }
+            }
+
+            item.CalculateViaLayers( m_board );
+
+            {
+                std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+                const auto [layerStart, layerEnd] = item.GetLayers();
+                m_netCache[via->GetNetCode()].ViaLayers[via] = { layerStart, layerEnd };
+                m_cachedItemNets[via] = via->GetNetCode();
+            }
+
             return item;
         }
 
@@ -614,6 +689,124 @@ LENGTH_DELAY_CALCULATION::GetLengthCalculationItem( const BOARD_CONNECTED_ITEM*
 }
 
 
+LENGTH_DELAY_STATS
+LENGTH_DELAY_CALCULATION::CalculateNetLengthDetails( const std::vector<const BOARD_CONNECTED_ITEM*>& aBoardItems,
+                                                     const PATH_OPTIMISATIONS                         aOptimisations,
+                                                     const LENGTH_DELAY_LAYER_OPT                     aLayerOpt,
+                                                     const LENGTH_DELAY_DOMAIN_OPT                    aDomain ) const
+{
+    if( aBoardItems.empty() )
+        return {};
+
+    const int netCode = aBoardItems.front()->GetNetCode();
+
+    std::vector<const BOARD_CONNECTED_ITEM*> key( aBoardItems );
+    std::sort( key.begin(), key.end() );
+
+    auto matches = [&]( const NET_CACHE_ENTRY& aEntry )
+    {
+        return aEntry.LayerOpt == aLayerOpt && aEntry.Domain == aDomain
+               && aEntry.Optimisations.OptimiseViaLayers == aOptimisations.OptimiseViaLayers
+               && aEntry.Optimisations.MergeTracks == aOptimisations.MergeTracks
+               && aEntry.Optimisations.OptimiseTracesInPads == aOptimisations.OptimiseTracesInPads
+               && aEntry.Optimisations.InferViaInPad == aOptimisations.InferViaInPad
+               && aEntry.Items == key;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+        auto netIt = m_netCache.find( netCode );
+
+        if( netIt != m_netCache.end() )
+        {
+            for( const NET_CACHE_ENTRY& entry : netIt->second.Entries )
+            {
+                if( matches( entry ) )
+                    return entry.Stats.Clone();
+            }
+        }
+    }
+
+    std::vector<LENGTH_DELAY_CALCULATION_ITEM> items;
+    items.reserve( aBoardItems.size() );
+
+    for( const BOARD_CONNECTED_ITEM* boardItem : aBoardItems )
+    {
+        LENGTH_DELAY_CALCULATION_ITEM item = GetLengthCalculationItem( boardItem );
+
+        if( item.Type() != LENGTH_DELAY_CALCULATION_ITEM::TYPE::UNKNOWN )
+            items.emplace_back( std::move( item ) );
+    }
+
+    LENGTH_DELAY_STATS stats = CalculateLengthDetails( items, aOptimisations, nullptr, nullptr, aLayerOpt, aDomain );
+
+    {
+        std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+        std::vector<NET_CACHE_ENTRY>& entries = m_netCache[netCode].Entries;
+
+        if( entries.size() >= MAX_CACHED_SETS_PER_NET )
+            entries.erase( entries.begin() );
+
+        for( const BOARD_CONNECTED_ITEM* boardItem : key )
+            m_cachedItemNets[boardItem] = netCode;
+
+        entries.push_back( { std::move( key ), aOptimisations, aLayerOpt, aDomain, stats.Clone() } );
+    }
+
+    return stats;
+}
+
+
+void LENGTH_DELAY_CALCULATION::invalidateItem( const BOARD_ITEM* aItem )
+{
+    if( const BOARD_CONNECTED_ITEM* item = dynamic_cast<const BOARD_CONNECTED_ITEM*>( aItem ) )
+    {
+        m_netCache.erase( item->GetNetCode() );
+
+        // The item may have been measured under another net before being changed
+        auto it = m_cachedItemNets.find( item );
+
+        if( it != m_cachedItemNets.end() )
+        {
+            m_netCache.erase( it->second );
+            m_cachedItemNets.erase( it );
+        }
+    }
+}
+
+
+void LENGTH_DELAY_CALCULATION::InvalidateCache( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+    if( m_netCache.empty() )
+        return;
+
+    for( const BOARD_ITEM* item : aItems )
+    {
+        invalidateItem( item );
+
+        item->RunOnChildren(
+                [this]( BOARD_ITEM* aChild )
+                {
+                    invalidateItem( aChild );
+                },
+                RECURSE_MODE::RECURSE );
+    }
+}
+
+
+void LENGTH_DELAY_CALCULATION::ClearCache()
+{
+    std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+    m_netCache.clear();
+    m_cachedItemNets.clear();
+}
+
+
 void LENGTH_DELAY_CALCULATION::SetTimeDomainParametersProvider(
         std::unique_ptr<TIME_DOMAIN_PARAMETERS_IFACE>&& aProvider )
 {
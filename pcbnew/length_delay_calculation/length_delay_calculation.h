@@ -30,9 +30,12 @@
 #include <board_design_settings.h>
 #include <connectivity/connectivity_data.h>
 #include <length_delay_calculation/length_delay_calculation_item.h>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 class BOARD;
+class BOARD_ITEM;
 
 /**
 * Holds length measurement result details and statistics
@@ -60,6 +63,9 @@ struct LENGTH_DELAY_STATS
 
     /// Calculates the total electrical propagation delay for this set of statistics
     int64_t TotalDelay() const { return ViaDelay + TrackDelay + PadToDieDelay; }
+
+    /// Returns a deep copy of these statistics, including the layer detail maps
+    LENGTH_DELAY_STATS Clone() const;
 };
 
 
@@ -170,6 +176,32 @@ public:
                             LENGTH_DELAY_LAYER_OPT  aLayerOpt = LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
                             LENGTH_DELAY_DOMAIN_OPT aDomain = LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL ) const;
 
+    /**
+     * @brief Calculates the electrical length of a set of board items belonging to a single net
+     *
+     * This is intended for callers which repeatedly measure whole nets or connected clusters of committed board
+     * items: the net inspector, and BOARD::GetTrackLength() (used by the track and tuning pattern message panels).
+     * The result is cached per net and returned without recomputing until an item of that net is changed (see
+     * InvalidateCache()).  The items must not be mixed with items which are not yet part of the board, so the
+     * router's measurement of the line being tuned is not cached.
+     *
+     * @param aBoardItems are the board items making up the net (or cluster)
+     * @param aOptimisations details the electrical path optimisations that should be applied to the board items
+     * @param aLayerOpt determines whether the layer details map is populated
+     * @param aDomain determines whether calculations include time domain (delay) details
+     */
+    LENGTH_DELAY_STATS
+    CalculateNetLengthDetails( const std::vector<const BOARD_CONNECTED_ITEM*>& aBoardItems,
+                               PATH_OPTIMISATIONS                               aOptimisations,
+                               LENGTH_DELAY_LAYER_OPT  aLayerOpt = LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
+                               LENGTH_DELAY_DOMAIN_OPT aDomain = LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL ) const;
+
+    /// Drops the cached net results and via layers for the nets of the given items (and their children)
+    void InvalidateCache( const std::vector<BOARD_ITEM*>& aItems );
+
+    /// Drops all cached net results and via layers
+    void ClearCache();
+
     /**
   * Gets the propagation delay for the given shape line chain
   *
@@ -213,6 +245,33 @@ protected:
     /// The active provider of time domain parameters
     std::unique_ptr<TIME_DOMAIN_PARAMETERS_IFACE> m_timeDomainParameters;
 
+    /// A cached CalculateNetLengthDetails() result
+    struct NET_CACHE_ENTRY
+    {
+        std::vector<const BOARD_CONNECTED_ITEM*> Items; ///< Sorted, identifies the measured item set
+        PATH_OPTIMISATIONS                       Optimisations;
+        LENGTH_DELAY_LAYER_OPT                   LayerOpt;
+        LENGTH_DELAY_DOMAIN_OPT                  Domain;
+        LENGTH_DELAY_STATS                       Stats;
+    };
+
+    /// Cached results for one net
+    struct NET_CACHE
+    {
+        std::vector<NET_CACHE_ENTRY>                                              Entries;
+        std::unordered_map<const PCB_VIA*, std::pair<PCB_LAYER_ID, PCB_LAYER_ID>> ViaLayers;
+    };
+
+    /// Cached results by net code.  Guarded by m_cacheMutex, as nets are measured in parallel.
+    mutable std::unordered_map<int, NET_CACHE> m_netCache;
+
+    /// The net each cached item was measured under, so that items which change net invalidate their old net
+    mutable std::unordered_map<const BOARD_CONNECTED_ITEM*, int> m_cachedItemNets;
+
+    mutable std::mutex m_cacheMutex;
+
+    void invalidateItem( const BOARD_ITEM* aItem );
+
     /// Enum to describe whether track merging is attempted from the start or end of a track segment
     enum class MERGE_POINT
     {
@@ -36,6 +36,8 @@
 #include <pgm_base.h>
 #include <progress_reporter.h>
 #include <settings/settings_manager.h>
+#include <string_utils.h>
+#include <thread_pool.h>
 #include <wx_fstream_progress.h>
 
 #include <geometry/shape_line_chain.h>
@@ -46,6 +48,8 @@
 #include <wx/numformatter.h>
 #include <wx/xml/xml.h>
 
+#include <mutex>
+
 
 /**
  * Flag to enable IPC-2581 debugging output.
@@ -55,6 +59,149 @@
 static const wxChar traceIpc2581[] = wxT( "KICAD_IPC_2581" );
 
 
+/*
+ * The XML writer below produces the same text as wxXmlDocument::Save() with the default indent
+ * step of 2: each element starts on its own line, indented by its depth, while text nodes are
+ * written inline.  Only text and element nodes are handled, as the exporter creates no other
+ * kind of node.
+ */
+
+static void formatXmlEscaped( std::string& aOut, const wxString& aText, bool aAttribute )
+{
+    wxScopedCharBuffer utf8 = aText.utf8_str();
+
+    for( const char* c = utf8.data(); *c; ++c )
+    {
+        switch( *c )
+        {
+        case '&':  aOut += "&amp;"; break;
+        case '<':  aOut += "&lt;";  break;
+        case '>':  aOut += "&gt;";  break;
+        case '\r': aOut += "&#xD;"; break;
+        case '"':  aOut += aAttribute ? "&quot;" : "\""; break;
+        case '\t': aOut += aAttribute ? "&#x9;" : "\t";  break;
+        case '\n': aOut += aAttribute ? "&#xA;" : "\n";  break;
+        default:   aOut += *c;      break;
+        }
+    }
+}
+
+
+static void formatXmlIndent( std::string& aOut, int aDepth )
+{
+    aOut += '\n';
+    aOut.append( 2 * aDepth, ' ' );
+}
+
+
+static void formatXmlStartTag( std::string& aOut, const wxXmlNode* aNode, bool aEmpty )
+{
+    aOut += '<';
+    aOut += TO_UTF8( aNode->GetName() );
+
+    for( const wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aOut += ' ';
+        aOut += TO_UTF8( attr->GetName() );
+        aOut += "=\"";
+        formatXmlEscaped( aOut, attr->GetValue(), true );
+        aOut += '"';
+    }
+
+    aOut += aEmpty ? "/>" : ">";
+}
+
+
+static void formatXmlEndTag( std::string& aOut, const wxXmlNode* aNode, int aDepth,
+                             bool aLastChildIsText )
+{
+    if( !aLastChildIsText )
+        formatXmlIndent( aOut, aDepth );
+
+    aOut += "</";
+    aOut += TO_UTF8( aNode->GetName() );
+    aOut += '>';
+}
+
+
+static void formatXmlNode( std::string& aOut, const wxXmlNode* aNode, int aDepth );
+
+
+/**
+ * Format a child node at \a aDepth, on its own line unless it is a text node.
+ */
+static void formatXmlChild( std::string& aOut, const wxXmlNode* aNode, int aDepth )
+{
+    if( aNode->GetType() != wxXML_TEXT_NODE )
+        formatXmlIndent( aOut, aDepth );
+
+    formatXmlNode( aOut, aNode, aDepth );
+}
+
+
+static void formatXmlNode( std::string& aOut, const wxXmlNode* aNode, int aDepth )
+{
+    if( aNode->GetType() != wxXML_ELEMENT_NODE )
+    {
+        formatXmlEscaped( aOut, aNode->GetContent(), false );
+        return;
+    }
+
+    if( !aNode->GetChildren() )
+    {
+        formatXmlStartTag( aOut, aNode, true );
+        return;
+    }
+
+    formatXmlStartTag( aOut, aNode, false );
+
+    const wxXmlNode* last = nullptr;
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        formatXmlChild( aOut, child, aDepth + 1 );
+        last = child;
+    }
+
+    formatXmlEndTag( aOut, aNode, aDepth, last->GetType() == wxXML_TEXT_NODE );
+}
+
+
+/**
+ * A list of sibling nodes detached from the document and the XML text they format to.
+ *
+ * The text is built either by a thread pool task or, if the task has not started by the time
+ * the file is written, by the writer itself.
+ */
+struct PCB_IO_IPC2581::STREAMED_NODES
+{
+    wxXmlNode*     m_children = nullptr;
+    int            m_depth = 0;         ///< Depth of the children in the document
+    bool           m_lastIsText = false;
+    std::once_flag m_formatted;
+    std::string    m_text;
+
+    void Format()
+    {
+        std::call_once( m_formatted,
+                [this]()
+                {
+                    for( wxXmlNode* node = m_children; node; )
+                    {
+                        wxXmlNode* next = node->GetNext();
+
+                        formatXmlChild( m_text, node, m_depth );
+                        m_lastIsText = node->GetType() == wxXML_TEXT_NODE;
+                        delete node;
+                        node = next;
+                    }
+
+                    m_children = nullptr;
+                } );
+    }
+};
+
+
 PCB_IO_IPC2581::~PCB_IO_IPC2581()
 {
     clearLoadedFootprints();
@@ -123,19 +270,18 @@ void PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, wxXmlNode* aNode )
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
-
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_lastAppendedNode && m_lastAppendedNode->GetParent() == aParent
+        && m_lastAppendedNode->GetNext() == nullptr )
     {
         aNode->SetParent( aParent );
-        lastNode->SetNext( aNode );
+        m_lastAppendedNode->SetNext( aNode );
     }
     else
     {
         aParent->AddChild( aNode );
     }
 
-    lastNode = aNode;
+    m_lastAppendedNode = aNode;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aNode->GetName().size() + 5;
@@ -322,6 +468,98 @@ wxXmlNode* PCB_IO_IPC2581::generateXmlHeader()
 }
 
 
+void PCB_IO_IPC2581::streamNodeChildren( wxXmlNode* aNode )
+{
+    if( !aNode->GetChildren() )
+        return;
+
+    std::shared_ptr<STREAMED_NODES> nodes = std::make_shared<STREAMED_NODES>();
+    nodes->m_children = aNode->GetChildren();
+
+    // The root is at depth 0.  Stop there: its parent is the document node.
+    nodes->m_depth = 1;
+
+    for( const wxXmlNode* parent = aNode; parent && parent != m_xml_root;
+         parent = parent->GetParent() )
+    {
+        nodes->m_depth++;
+    }
+
+    aNode->SetChildren( nullptr );
+
+    // The last appended node may be one of the detached children
+    m_lastAppendedNode = nullptr;
+
+    m_streamedNodes[aNode] = nodes;
+
+    GetKiCadThreadPool().push_task( [nodes]() { nodes->Format(); } );
+}
+
+
+bool PCB_IO_IPC2581::writeXml( wxOutputStream& aStream )
+{
+    std::string buffer = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+    writeXmlNode( aStream, buffer, m_xml_root, 0 );
+    buffer += '\n';
+    aStream.Write( buffer.data(), buffer.size() );
+
+    m_streamedNodes.clear();
+
+    return aStream.IsOk();
+}
+
+
+void PCB_IO_IPC2581::writeXmlNode( wxOutputStream& aStream, std::string& aBuffer,
+                                   const wxXmlNode* aNode, int aDepth )
+{
+    auto streamed = m_streamedNodes.find( aNode );
+
+    if( streamed == m_streamedNodes.end() && !aNode->GetChildren() )
+    {
+        formatXmlNode( aBuffer, aNode, aDepth );
+    }
+    else
+    {
+        bool lastIsText = false;
+
+        formatXmlStartTag( aBuffer, aNode, false );
+
+        if( streamed != m_streamedNodes.end() )
+        {
+            STREAMED_NODES& nodes = *streamed->second;
+
+            nodes.Format();
+            lastIsText = nodes.m_lastIsText;
+
+            aStream.Write( aBuffer.data(), aBuffer.size() );
+            aStream.Write( nodes.m_text.data(), nodes.m_text.size() );
+            aBuffer.clear();
+
+            // Release the text as soon as it is written
+            std::string().swap( nodes.m_text );
+        }
+
+        for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+        {
+            if( child->GetType() != wxXML_TEXT_NODE )
+                formatXmlIndent( aBuffer, aDepth + 1 );
+
+            writeXmlNode( aStream, aBuffer, child, aDepth + 1 );
+            lastIsText = child->GetType() == wxXML_TEXT_NODE;
+        }
+
+        formatXmlEndTag( aBuffer, aNode, aDepth, lastIsText );
+    }
+
+    if( aBuffer.size() > 1024 * 1024 )
+    {
+        aStream.Write( aBuffer.data(), aBuffer.size() );
+        aBuffer.clear();
+    }
+}
+
+
 wxXmlNode* PCB_IO_IPC2581::generateContentSection()
 {
     if( m_progressReporter )
@@ -2791,6 +3029,10 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
             aStepNode->RemoveChild( layerNode );
             delete layerNode;
         }
+        else
+        {
+            streamNodeChildren( layerNode );
+        }
     }
 }
 
@@ -3437,7 +3679,7 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
+    if( !writeXml( out_stream ) )
     {
         wxLogError( _( "Failed to save file to buffer" ) );
         return;
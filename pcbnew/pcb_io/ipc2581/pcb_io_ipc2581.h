@@ -48,6 +48,7 @@ class PCB_TEXT;
 class PROGRESS_REPORTER;
 class SHAPE_POLY_SET;
 class SHAPE_SEGMENT;
+class wxOutputStream;
 
 class PCB_IO_IPC2581 : public PCB_IO
 {
@@ -68,6 +69,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_lastAppendedNode = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -273,6 +275,26 @@ private:
     void addLayerAttributes( wxXmlNode* aNode, PCB_LAYER_ID aLayer );
 
     bool isValidLayerFor2581( PCB_LAYER_ID aLayer );
+
+    /**
+     * Detach the children of \a aNode and format them as XML text on the thread pool.
+     *
+     * The detached nodes are freed as soon as they are formatted, so large sections such as
+     * the layer features do not have to be held as a DOM until the file is saved.  The text
+     * is spliced back in place by writeXml().
+     */
+    void streamNodeChildren( wxXmlNode* aNode );
+
+    /**
+     * Write the document to \a aStream, splicing in the text of the streamed nodes.
+     */
+    bool writeXml( wxOutputStream& aStream );
+
+    void writeXmlNode( wxOutputStream& aStream, std::string& aBuffer, const wxXmlNode* aNode,
+                       int aDepth );
+
+    struct STREAMED_NODES;
+
 private:
 
     size_t                  m_total_bytes;  //<! Total number of bytes to be written
@@ -341,6 +363,10 @@ private:
 
     wxXmlDocument*          m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_lastAppendedNode;     //<! Last node added by appendNode()
+
+    std::map<const wxXmlNode*, std::shared_ptr<STREAMED_NODES>>
+            m_streamedNodes; //<! Formatted children of the nodes detached by streamNodeChildren()
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
@@ -40,6 +40,7 @@
 #include <pgm_base.h>
 #include <progress_reporter.h>
 #include <settings/settings_manager.h>
+#include <thread_pool.h>
 #include <wx_fstream_progress.h>
 
 #include <geometry/shape_circle.h>
@@ -51,6 +52,9 @@
 #include <wx/numformatter.h>
 #include <wx/mstream.h>
 
+#include <atomic>
+#include <future>
+
 #include "odb_attribute.h"
 #include "odb_entity.h"
 #include "odb_defines.h"
@@ -808,11 +812,8 @@ void ODB_STEP_ENTITY::InitEntityData()
 
     InitEdaData();
 
-    // Init Layer Entity Data
-    for( const auto& [layerName, layer_entity_ptr] : m_layerEntityMap )
-    {
-        layer_entity_ptr->InitEntityData();
-    }
+    // Layer entity data is built in GenerateLayerFiles() so that the layers can be built in
+    // parallel and released as soon as they are written.
 }
 
 
@@ -834,6 +835,20 @@ void ODB_LAYER_ENTITY::GenerateFiles( ODB_TREE_WRITER& writer )
 }
 
 
+void ODB_LAYER_ENTITY::FlushSubnetFeatureIDs()
+{
+    if( m_featuresMgr )
+        m_featuresMgr->FlushSubnetFeatureIDs();
+}
+
+
+void ODB_LAYER_ENTITY::ReleaseFeatures()
+{
+    m_featuresMgr.reset();
+    m_layerItems.clear();
+}
+
+
 void ODB_LAYER_ENTITY::GenComponents( ODB_TREE_WRITER& writer )
 {
     auto fileproxy = writer.CreateFileProxy( "components" );
@@ -1051,11 +1066,84 @@ void ODB_STEP_ENTITY::GenerateLayerFiles( ODB_TREE_WRITER& writer )
 {
     wxString layers_root = writer.GetCurrentPath();
 
+    std::vector<std::pair<wxString, ODB_LAYER_ENTITY*>> layers;
+
     for( auto& [layerName, layerEntity] : m_layerEntityMap )
+        layers.emplace_back( layerName, layerEntity.get() );
+
+    // Features are built on the thread pool, but only one batch of layers is held in memory
+    // at a time.  The tree writer is not thread safe, so files are written from this thread
+    // in the original layer order.
+    //
+    // The export itself may be running on a pool thread, so this thread claims layers too
+    // and only waits for the layers another thread has already claimed, rather than blocking
+    // on tasks which might never get a free thread.
+    //
+    // Queued tasks may start after the batch is finished, so they only see the shared state.
+    // Exceptions are handed over through the promises and rethrown here once every claimed
+    // layer is done.
+    struct BATCH_STATE
     {
-        writer.CreateEntityDirectory( layers_root, layerName );
+        std::vector<ODB_LAYER_ENTITY*>  entities;
+        std::vector<std::promise<void>> done;
+        std::atomic<size_t>             next{ 0 };
+    };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       batchSize = std::max<size_t>( 1, tp.get_thread_count() );
+
+    for( size_t first = 0; first < layers.size(); first += batchSize )
+    {
+        size_t                         last = std::min( layers.size(), first + batchSize );
+        std::shared_ptr<BATCH_STATE>   state = std::make_shared<BATCH_STATE>();
+        std::vector<std::future<void>> results;
+
+        for( size_t ii = first; ii < last; ++ii )
+            state->entities.push_back( layers[ii].second );
+
+        state->done.resize( last - first );
 
-        layerEntity->GenerateFiles( writer );
+        for( std::promise<void>& done : state->done )
+            results.push_back( done.get_future() );
+
+        auto buildLayers = [state]()
+        {
+            for( size_t ii = state->next++; ii < state->entities.size(); ii = state->next++ )
+            {
+                try
+                {
+                    state->entities[ii]->InitEntityData();
+                    state->done[ii].set_value();
+                }
+                catch( ... )
+                {
+                    state->done[ii].set_exception( std::current_exception() );
+                }
+            }
+        };
+
+        for( size_t ii = first + 1; ii < last; ++ii )
+            tp.push_task( buildLayers );
+
+        buildLayers();
+
+        for( std::future<void>& result : results )
+            result.wait();
+
+        for( std::future<void>& result : results )
+            result.get();
+
+        for( size_t ii = first; ii < last; ++ii )
+        {
+            auto& [layerName, layerEntity] = layers[ii];
+
+            layerEntity->FlushSubnetFeatureIDs();
+
+            writer.CreateEntityDirectory( layers_root, layerName );
+            layerEntity->GenerateFiles( writer );
+
+            layerEntity->ReleaseFeatures();
+        }
     }
 }
 
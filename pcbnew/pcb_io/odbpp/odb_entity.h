@@ -193,6 +193,11 @@ public:
 
     void AddLayerFeatures();
 
+    /// Apply the deferred subnet links of this layer; see FEATURES_MANAGER::FlushSubnetFeatureIDs.
+    void FlushSubnetFeatureIDs();
+
+    /// Free the feature list once the layer files have been written.
+    void ReleaseFeatures();
 
     void GenAttrList( ODB_TREE_WRITER& writer );
     void GenComponents( ODB_TREE_WRITER& writer );
@@ -366,6 +366,17 @@ void FEATURES_MANAGER::AddPadShape( const PAD& aPad, PCB_LAYER_ID aLayer )
 
 void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_ITEM*>& aItems )
 {
+    // Subnets and the EDA layer table are shared by every layer, and layers may be built
+    // concurrently.  Record the links here and apply them in FlushSubnetFeatureIDs().
+    auto add_feature_id = [&]( EDA_DATA::SUB_NET* aSubnet, EDA_DATA::FEATURE_ID::TYPE aType )
+    {
+        m_pendingFeatureIDs.emplace_back(
+                [aSubnet, aType, layerName = m_layerName, id = m_featuresList.size() - 1]()
+                {
+                    aSubnet->AddFeatureID( aType, layerName, id );
+                } );
+    };
+
     auto add_track = [&]( PCB_TRACK* track )
     {
         auto iter = GetODBPlugin()->GetViaTraceSubnetMap().find( track );
@@ -386,8 +397,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             shape.SetWidth( track->GetWidth() );
 
             AddShape( shape );
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            add_feature_id( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
         }
         else if( track->Type() == PCB_ARC_T )
         {
@@ -398,8 +408,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddShape( shape );
 
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            add_feature_id( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
         }
         else
         {
@@ -421,8 +430,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             if( hole )
             {
                 AddViaDrillHole( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                      m_featuresList.size() - 1 );
+                add_feature_id( subnet, EDA_DATA::FEATURE_ID::TYPE::HOLE );
 
                 // TODO: confirm TOOLING_HOLE
                 // AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOOLING_HOLE );
@@ -440,8 +448,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             {
                 // to draw via copper shape on copper layer
                 AddVia( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                      m_featuresList.size() - 1 );
+                add_feature_id( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
 
                 if( !m_featuresList.empty() )
                 {
@@ -471,8 +478,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 return;
             }
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            add_feature_id( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER );
 
             if( zone->IsTeardropArea() && !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::TEAR_DROP{ true } );
@@ -696,8 +702,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddPadShape( *pad, aLayer );
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            add_feature_id( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER );
             if( !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOEPRINT );
 
@@ -727,8 +732,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 if( pad->GetAttribute() == PAD_ATTRIB::PTH )
                 {
                     // only plated holes link to subnet
-                    iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                                m_featuresList.size() - 1 );
+                    add_feature_id( iter->second, EDA_DATA::FEATURE_ID::TYPE::HOLE );
 
                     if( !m_featuresList.empty() )
                         AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::DRILL::PLATED );
@@ -837,6 +841,15 @@ void FEATURES_MANAGER::GenerateProfileFeatures( std::ostream& ost ) const
 }
 
 
+void FEATURES_MANAGER::FlushSubnetFeatureIDs()
+{
+    for( const std::function<void()>& addFeatureID : m_pendingFeatureIDs )
+        addFeatureID();
+
+    m_pendingFeatureIDs.clear();
+}
+
+
 void FEATURES_MANAGER::GenerateFeatureFile( std::ostream& ost ) const
 {
     ost << "UNITS=" << PCB_IO_ODBPP::m_unitsStr << std::endl;
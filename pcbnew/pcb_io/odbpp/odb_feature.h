@@ -26,6 +26,7 @@
 #include "pad.h"
 #include "convert_basic_shapes_to_polygon.h"
 #include "footprint.h"
+#include <functional>
 #include <list>
 #include "math/vector2d.h"
 #include "odb_defines.h"
@@ -87,6 +88,13 @@ public:
 
     bool AddPolygonCutouts( const SHAPE_POLY_SET::POLYGON& aPolygon );
 
+    /**
+     * Link the features built by InitFeatureList() to their EDA subnets.
+     *
+     * Must be called from a single thread, in layer order, to keep the EDA data deterministic.
+     */
+    void FlushSubnetFeatureIDs();
+
     void GenerateFeatureFile( std::ostream& ost ) const;
 
     void GenerateProfileFeatures( std::ostream& ost ) const;
@@ -196,6 +204,7 @@ private:
 
     std::list<std::unique_ptr<ODB_FEATURE>>      m_featuresList;
     std::map<BOARD_ITEM*, std::vector<uint32_t>> m_featureIDMap;
+    std::vector<std::function<void()>>           m_pendingFeatureIDs;
 };
 
 
@@ -104,6 +104,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
     // we used 0.1mils for SVG step before, but nm precision is more accurate, so we use nm
     m_svgPrecision               = SVG_PRECISION_DEFAULT;
     m_svgFitPageToBoard          = false;
+    m_svgCompact                 = false;
     m_plotDrawingSheet           = false;
     m_plotMode                   = FILLED;
     m_DXFPolygonMode             = true;
@@ -205,6 +206,10 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter ) const
     // SVG options
     aFormatter->Print( "(svgprecision %d)", m_svgPrecision );
 
+    // save this option only if it is set, to avoid cluttering files with the default value
+    if( m_svgCompact )
+        KICAD_FORMAT::FormatBool( aFormatter, getTokenName( T_svgcompact ), m_svgCompact );
+
     KICAD_FORMAT::FormatBool( aFormatter, "plotframeref", m_plotDrawingSheet );
     aFormatter->Print( "(mode %d)", GetPlotMode() == SKETCH ? 2 : 1 );
     KICAD_FORMAT::FormatBool( aFormatter, "useauxorigin", m_useAuxOrigin );
@@ -302,6 +307,9 @@ bool PCB_PLOT_PARAMS::IsSameAs( const PCB_PLOT_PARAMS &aPcbPlotParams ) const
     if( m_svgPrecision != aPcbPlotParams.m_svgPrecision )
         return false;
 
+    if( m_svgCompact != aPcbPlotParams.m_svgCompact )
+        return false;
+
     if( m_useAuxOrigin != aPcbPlotParams.m_useAuxOrigin )
         return false;
 
@@ -719,6 +727,10 @@ void PCB_PLOT_PARAMS_PARSER::Parse( PCB_PLOT_PARAMS* aPcbPlotParams )
             aPcbPlotParams->m_svgPrecision = parseInt( SVG_PRECISION_MIN, SVG_PRECISION_MAX );
             break;
 
+        case T_svgcompact:
+            aPcbPlotParams->m_svgCompact = parseBool();
+            break;
+
         case T_svguseinch:
             parseBool();    // Unused. For compatibility
             break;
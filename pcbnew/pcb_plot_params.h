@@ -157,6 +157,9 @@ public:
     void        SetSvgFitPageToBoard( int aSvgFitPageToBoard ) { m_svgFitPageToBoard = aSvgFitPageToBoard; }
     bool        GetSvgFitPagetoBoard() const { return m_svgFitPageToBoard; }
 
+    void        SetSvgCompact( bool aCompact ) { m_svgCompact = aCompact; }
+    bool        GetSvgCompact() const { return m_svgCompact; }
+
     void        SetBlackAndWhite( bool blackAndWhite ) { m_blackAndWhite = blackAndWhite; }
     unsigned    GetBlackAndWhite() const { return m_blackAndWhite; }
 
@@ -261,6 +264,7 @@ private:
     /// Precision of coordinates in SVG: accepted 3 - 6; 6 is the internal resolution of Pcbnew
     unsigned   m_svgPrecision;
     bool        m_svgFitPageToBoard;
+    bool        m_svgCompact;           ///< Use the compact SVG output mode
 
     bool       m_useAuxOrigin;          ///< Plot gerbers using auxiliary (drill) origin instead
                                         ///<   of absolute coordinates
@@ -379,6 +379,7 @@ void PCB_PLOTTER::PlotJobToPlotOpts( PCB_PLOT_PARAMS& aOpts, JOB_EXPORT_PCB_PLOT
         JOB_EXPORT_PCB_SVG* svgJob = static_cast<JOB_EXPORT_PCB_SVG*>( aJob );
         aOpts.SetSvgPrecision( svgJob->m_precision );
         aOpts.SetSvgFitPageToBoard( svgJob->m_fitPageToBoard );
+        aOpts.SetSvgCompact( svgJob->m_compact );
     }
 
     if( aJob->m_plotFormat == JOB_EXPORT_PCB_PLOT::PLOT_FORMAT::DXF )
@@ -42,9 +42,12 @@
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_route.h>
 #include <lset.h>
 #include <cli/exit_codes.h>
+#include <autorouter/ar_batch_router.h>
 #include <exporters/place_file_exporter.h>
+#include <exporters/png_stream_writer.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
 #include <plotters/plotter_gerber.h>
@@ -273,6 +276,12 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
               {
                   return true;
               } );
+    Register( "route",
+              std::bind( &PCBNEW_JOBS_HANDLER::JobRoute, this, std::placeholders::_1 ),
+              []( JOB* job, wxWindow* aParent ) -> bool
+              {
+                  return true;
+              } );
     Register( "odb",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportOdb, this, std::placeholders::_1 ),
               [aKiway]( JOB* job, wxWindow* aParent ) -> bool
@@ -562,7 +571,9 @@ int PCBNEW_JOBS_HANDLER::JobExportRender( JOB* aJob )
         // set the name to board name + "side", its lazy but its hard to generate anything truely unique
         // incase someone is doing this in a jobset with multiple jobs, they should be setting the output themselves
         // or we do a hash based on all the options
-        fn.SetName( wxString::Format( "%s-%d", fn.GetName(), static_cast<int>( aRenderJob->m_side ) ) );
+        // (when rendering several sides, the side names are appended below instead)
+        if( aRenderJob->m_extraSides.empty() )
+            fn.SetName( wxString::Format( "%s-%d", fn.GetName(), static_cast<int>( aRenderJob->m_side ) ) );
 
         aRenderJob->SetWorkingOutputPath( fn.GetFullName() );
     }
@@ -684,6 +695,18 @@ int PCBNEW_JOBS_HANDLER::JobExportRender( JOB* aJob )
         { JOB_PCB_RENDER::SIDE::BACK, VIEW3D_TYPE::VIEW3D_BACK },
     };
 
+    static std::map<JOB_PCB_RENDER::SIDE, wxString> s_sideNameMap = {
+        { JOB_PCB_RENDER::SIDE::TOP, wxS( "top" ) },
+        { JOB_PCB_RENDER::SIDE::BOTTOM, wxS( "bottom" ) },
+        { JOB_PCB_RENDER::SIDE::LEFT, wxS( "left" ) },
+        { JOB_PCB_RENDER::SIDE::RIGHT, wxS( "right" ) },
+        { JOB_PCB_RENDER::SIDE::FRONT, wxS( "front" ) },
+        { JOB_PCB_RENDER::SIDE::BACK, wxS( "back" ) },
+    };
+
+    std::vector<JOB_PCB_RENDER::SIDE> sides = { aRenderJob->m_side };
+    sides.insert( sides.end(), aRenderJob->m_extraSides.begin(), aRenderJob->m_extraSides.end() );
+
     PROJECTION_TYPE projection =  aRenderJob->m_perspective ? PROJECTION_TYPE::PERSPECTIVE
                                                             : PROJECTION_TYPE::ORTHO;
 
@@ -696,71 +719,140 @@ int PCBNEW_JOBS_HANDLER::JobExportRender( JOB* aJob )
     RENDER_3D_RAYTRACE_RAM raytrace( boardAdapter, camera );
     raytrace.SetCurWindowSize( windowSize );
 
-    for( bool first = true; raytrace.Redraw( false, m_reporter, m_reporter ); first = false )
-    {
-        if( first )
-        {
-            const float cmTo3D = boardAdapter.BiuTo3dUnits() * pcbIUScale.mmToIU( 10.0 );
+    // The scene is built once and shared by all the views
+    raytrace.LoadScene( m_reporter, m_reporter );
 
-            // First redraw resets lookat point to the board center, so set up the camera here
-            camera.ViewCommand_T1( s_viewCmdMap[aRenderJob->m_side] );
+    auto saveImage =
+            [&]( const wxString& aPath ) -> bool
+            {
+                uint8_t* rgbaBuffer = raytrace.GetBuffer();
+                wxSize   realSize = raytrace.GetRealBufferSize();
 
-            camera.SetLookAtPos_T1( camera.GetLookAtPos_T1() + SFVEC3F( aRenderJob->m_pivot.x,
-                                                                        aRenderJob->m_pivot.y,
-                                                                        aRenderJob->m_pivot.z ) * cmTo3D );
+                if( !rgbaBuffer )
+                    return false;
 
-            camera.Pan_T1( SFVEC3F( aRenderJob->m_pan.x, aRenderJob->m_pan.y, aRenderJob->m_pan.z ) );
+                const unsigned int wxh = realSize.x * realSize.y;
 
-            camera.Zoom_T1( aRenderJob->m_zoom );
+                unsigned char* rgbBuffer = (unsigned char*) malloc( wxh * 3 );
+                unsigned char* alphaBuffer = (unsigned char*) malloc( wxh );
 
-            camera.RotateX_T1( DEG2RAD( aRenderJob->m_rotation.x ) );
-            camera.RotateY_T1( DEG2RAD( aRenderJob->m_rotation.y ) );
-            camera.RotateZ_T1( DEG2RAD( aRenderJob->m_rotation.z ) );
+                unsigned char* rgbaPtr = rgbaBuffer;
+                unsigned char* rgbPtr = rgbBuffer;
+                unsigned char* alphaPtr = alphaBuffer;
 
-            camera.Interpolate( 1.0f );
-            camera.SetT0_and_T1_current_T();
-            camera.ParametersChanged();
-        }
+                for( int y = 0; y < realSize.y; y++ )
+                {
+                    for( int x = 0; x < realSize.x; x++ )
+                    {
+                        rgbPtr[0] = rgbaPtr[0];
+                        rgbPtr[1] = rgbaPtr[1];
+                        rgbPtr[2] = rgbaPtr[2];
+                        alphaPtr[0] = rgbaPtr[3];
+
+                        rgbaPtr += 4;
+                        rgbPtr += 3;
+                        alphaPtr += 1;
+                    }
+                }
+
+                wxImage image( realSize );
+                image.SetData( rgbBuffer );
+                image.SetAlpha( alphaBuffer );
+                image = image.Mirror( false );
+
+                image.SetOption( wxIMAGE_OPTION_QUALITY, 90 );
+                image.SaveFile( aPath, aRenderJob->m_format == JOB_PCB_RENDER::FORMAT::PNG
+                                               ? wxBITMAP_TYPE_PNG
+                                               : wxBITMAP_TYPE_JPEG );
+                return true;
+            };
+
+    // Tiles are streamed straight to the file, the whole image is never in memory
+    auto renderTiledImage =
+            [&]( const wxString& aPath ) -> bool
+            {
+                PNG_STREAM_WRITER writer;
+                wxSize            tiledSize = raytrace.GetTiledImageSize();
+
+                if( !writer.Open( aPath, tiledSize.x, tiledSize.y ) )
+                    return false;
+
+                bool ok = raytrace.RenderViewTiled( aRenderJob->m_tileSize,
+                        [&]( const uint8_t* aBand, unsigned int aRows )
+                        {
+                            return writer.WriteRows( aBand, aRows );
+                        },
+                        m_reporter );
+
+                return writer.Close() && ok;
+            };
+
+    const bool tiled = aRenderJob->m_tileSize > 0
+                       && aRenderJob->m_format == JOB_PCB_RENDER::FORMAT::PNG;
+
+    if( aRenderJob->m_tileSize > 0 && !tiled )
+    {
+        m_reporter->Report( _( "Tiled rendering is only available for PNG images, rendering "
+                               "in one pass\n" ),
+                            RPT_SEVERITY_WARNING );
+    }
+    else if( tiled && (unsigned int) aRenderJob->m_tileSize < raytrace.GetMinTileSize() )
+    {
+        m_reporter->Report( wxString::Format( _( "Tile size %d is too small, using %u pixel "
+                                                 "tiles\n" ),
+                                              aRenderJob->m_tileSize,
+                                              raytrace.GetMinTileSize() ),
+                            RPT_SEVERITY_WARNING );
     }
 
-    uint8_t* rgbaBuffer = raytrace.GetBuffer();
-    wxSize   realSize = raytrace.GetRealBufferSize();
-    bool     success = !!rgbaBuffer;
+    const float cmTo3D = boardAdapter.BiuTo3dUnits() * pcbIUScale.mmToIU( 10.0 );
+    bool        success = true;
 
-    if( rgbaBuffer )
+    for( JOB_PCB_RENDER::SIDE side : sides )
     {
-        const unsigned int wxh = realSize.x * realSize.y;
+        // Each view starts from the board center set up when loading the scene
+        camera.Reset();
+        camera.ViewCommand_T1( s_viewCmdMap[side] );
 
-        unsigned char* rgbBuffer = (unsigned char*) malloc( wxh * 3 );
-        unsigned char* alphaBuffer = (unsigned char*) malloc( wxh );
+        camera.SetLookAtPos_T1( camera.GetLookAtPos_T1() + SFVEC3F( aRenderJob->m_pivot.x,
+                                                                    aRenderJob->m_pivot.y,
+                                                                    aRenderJob->m_pivot.z ) * cmTo3D );
+
+        camera.Pan_T1( SFVEC3F( aRenderJob->m_pan.x, aRenderJob->m_pan.y, aRenderJob->m_pan.z ) );
+
+        camera.Zoom_T1( aRenderJob->m_zoom );
+
+        camera.RotateX_T1( DEG2RAD( aRenderJob->m_rotation.x ) );
+        camera.RotateY_T1( DEG2RAD( aRenderJob->m_rotation.y ) );
+        camera.RotateZ_T1( DEG2RAD( aRenderJob->m_rotation.z ) );
+
+        camera.Interpolate( 1.0f );
+        camera.SetT0_and_T1_current_T();
+
+        // Write each image as soon as it is rendered
+        wxFileName fn( outPath );
 
-        unsigned char* rgbaPtr = rgbaBuffer;
-        unsigned char* rgbPtr = rgbBuffer;
-        unsigned char* alphaPtr = alphaBuffer;
+        if( sides.size() > 1 )
+            fn.SetName( fn.GetName() + wxS( "-" ) + s_sideNameMap[side] );
 
-        for( int y = 0; y < realSize.y; y++ )
+        if( tiled )
         {
-            for( int x = 0; x < realSize.x; x++ )
+            if( !renderTiledImage( fn.GetFullPath() ) )
             {
-                rgbPtr[0] = rgbaPtr[0];
-                rgbPtr[1] = rgbaPtr[1];
-                rgbPtr[2] = rgbaPtr[2];
-                alphaPtr[0] = rgbaPtr[3];
-
-                rgbaPtr += 4;
-                rgbPtr += 3;
-                alphaPtr += 1;
+                success = false;
+                break;
             }
+
+            continue;
         }
 
-        wxImage image( realSize );
-        image.SetData( rgbBuffer );
-        image.SetAlpha( alphaBuffer );
-        image = image.Mirror( false );
+        raytrace.RenderView( m_reporter );
 
-        image.SetOption( wxIMAGE_OPTION_QUALITY, 90 );
-        image.SaveFile( outPath, aRenderJob->m_format == JOB_PCB_RENDER::FORMAT::PNG ? wxBITMAP_TYPE_PNG
-                                                                                     : wxBITMAP_TYPE_JPEG );
+        if( !saveImage( fn.GetFullPath() ) )
+        {
+            success = false;
+            break;
+        }
     }
 
     if( success )
@@ -1393,6 +1485,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
     else
         drillWriter = std::make_unique<GERBER_WRITER>( brd );
 
+    drillWriter->SetOptimizeHoleOrder( aDrillJob->m_optimizeHoleOrder );
+
     VECTOR2I offset;
 
     if( aDrillJob->m_drillOrigin == JOB_EXPORT_PCB_DRILL::DRILL_ORIGIN::ABS )
@@ -2248,6 +2342,91 @@ int PCBNEW_JOBS_HANDLER::JobExportIpcD356( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobRoute( JOB* aJob )
+{
+    JOB_PCB_ROUTE* routeJob = dynamic_cast<JOB_PCB_ROUTE*>( aJob );
+
+    if( routeJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    BOARD* brd = getBoard( routeJob->m_filename );
+
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    aJob->SetTitleBlock( brd->GetTitleBlock() );
+    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+    brd->SynchronizeProperties();
+
+    if( routeJob->GetConfiguredOutputPath().IsEmpty() )
+    {
+        wxFileName fn = brd->GetFileName();
+        fn.SetName( fn.GetName() + wxS( "-routed" ) );
+        fn.SetExt( FILEEXT::KiCadPcbFileExtension );
+
+        routeJob->SetWorkingOutputPath( fn.GetFullName() );
+    }
+
+    wxString outPath = routeJob->GetFullOutputPath( brd->GetProject() );
+
+    if( !PATHS::EnsurePathExists( outPath, true ) )
+    {
+        m_reporter->Report( _( "Failed to create output directory\n" ), RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    std::set<int> netCodes;
+
+    for( const wxString& netName : routeJob->m_nets )
+    {
+        NETINFO_ITEM* net = brd->FindNet( netName );
+
+        if( !net )
+        {
+            m_reporter->Report( wxString::Format( _( "Net '%s' not found\n" ), netName ),
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_ARGS;
+        }
+
+        netCodes.insert( net->GetNetCode() );
+    }
+
+    // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
+    std::unique_ptr<TOOL_MANAGER> toolManager = std::make_unique<TOOL_MANAGER>();
+    toolManager->SetEnvironment( brd, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
+
+    AR_BATCH_ROUTER router( brd, toolManager.get() );
+
+    router.SetNetFilter( netCodes );
+    router.SetCommitFlags( SKIP_UNDO | SKIP_SET_DIRTY );
+    router.SetReporter( m_reporter );
+    router.SetProgressReporter( m_progressReporter );
+
+    m_reporter->Report( _( "Routing unconnected nets...\n" ), RPT_SEVERITY_INFO );
+
+    AR_BATCH_ROUTER::RESULT result = router.Run();
+
+    m_reporter->Report( wxString::Format( _( "Routed %d of %d connections.\n" ),
+                                          result.m_routed, result.m_attempted ),
+                        RPT_SEVERITY_INFO );
+
+    if( !SaveBoard( outPath, brd, true ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Failed to save board file '%s'.\n" ), outPath ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Saved board file '%s'.\n" ), outPath ),
+                        RPT_SEVERITY_INFO );
+
+    if( routeJob->m_exitCodeUnrouted && result.m_failed > 0 )
+        return CLI::EXIT_CODES::ERR_RC_VIOLATIONS;
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportOdb( JOB* aJob )
 {
     JOB_EXPORT_PCB_ODB* job = dynamic_cast<JOB_EXPORT_PCB_ODB*>( aJob );
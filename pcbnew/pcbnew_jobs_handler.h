@@ -52,6 +52,7 @@ public:
     int JobExportIpc2581( JOB* aJob );
     int JobExportOdb( JOB* aJob );
     int JobExportIpcD356( JOB* aJob );
+    int JobRoute( JOB* aJob );
 
 private:
     BOARD* getBoard( const wxString& aPath = wxEmptyString );
@@ -1171,6 +1171,7 @@ static void initializePlotter( PLOTTER* aPlotter, const BOARD* aBoard,
 
     // Has meaning only for SVG plotter. Must be called only after SetViewport
     aPlotter->SetSvgCoordinatesFormat( aPlotOpts->GetSvgPrecision() );
+    aPlotter->SetSvgCompactMode( aPlotOpts->GetSvgCompact() );
 
     aPlotter->SetCreator( wxT( "PCBNEW" ) );
     aPlotter->SetColorMode( !aPlotOpts->GetBlackAndWhite() );        // default is plot in Black and White.
@@ -24,6 +24,143 @@
 
 namespace PNS {
 
+// Number of items a layer needs before it gets a broadphase grid
+static const int GRID_MIN_ITEMS = 2048;
+
+// Smallest grid cell, keeps degenerate layers (all zero-size items) from blowing up the grid
+static const int GRID_MIN_CELL_SIZE = 10000;
+
+
+void ITEM_GRID::Add( ITEM* aItem, const BOX2I& aBox )
+{
+    ENTRY entry{ aItem, aBox.GetX(), aBox.GetY(), aBox.GetRight(), aBox.GetBottom() };
+
+    m_cells[ cellKey( cellCoord( aBox.GetX() ), cellCoord( aBox.GetY() ) ) ].push_back( entry );
+}
+
+
+bool ITEM_GRID::Remove( ITEM* aItem, const BOX2I& aBox )
+{
+    auto cell = m_cells.find( cellKey( cellCoord( aBox.GetX() ), cellCoord( aBox.GetY() ) ) );
+
+    if( cell == m_cells.end() )
+        return false;
+
+    std::vector<ENTRY>& entries = cell->second;
+
+    for( size_t ii = 0; ii < entries.size(); ++ii )
+    {
+        if( entries[ii].m_item == aItem )
+        {
+            entries[ii] = entries.back();
+            entries.pop_back();
+
+            if( entries.empty() )
+                m_cells.erase( cell );
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void LAYER_INDEX::Add( ITEM* aItem )
+{
+    m_count++;
+
+    if( m_grid )
+    {
+        BOX2I bbox = boundingBox( aItem, m_layer );
+
+        if( m_grid->Fits( bbox ) )
+        {
+            m_grid->Add( aItem, bbox );
+            return;
+        }
+    }
+
+    m_tree.Add( aItem );
+
+    if( !m_grid && m_count >= GRID_MIN_ITEMS )
+        rebuildGrid();
+}
+
+
+void LAYER_INDEX::Remove( ITEM* aItem )
+{
+    m_count--;
+
+    if( m_grid )
+    {
+        BOX2I bbox = boundingBox( aItem, m_layer );
+
+        if( m_grid->Fits( bbox ) && m_grid->Remove( aItem, bbox ) )
+            return;
+    }
+
+    m_tree.Remove( aItem );
+}
+
+
+void LAYER_INDEX::SetClearance( int aClearance )
+{
+    if( aClearance == m_clearance )
+        return;
+
+    m_clearance = aClearance;
+
+    if( m_grid )
+        rebuildGrid();
+}
+
+
+void LAYER_INDEX::rebuildGrid()
+{
+    std::vector<ITEM*> items;
+    std::vector<int>   sizes;
+
+    items.reserve( m_count );
+
+    for( auto it = m_tree.Begin(); !it.IsNull(); it++ )
+        items.push_back( *it );
+
+    if( m_grid )
+        m_grid->ForEachItem( [&]( ITEM* aItem ) { items.push_back( aItem ); } );
+
+    std::vector<BOX2I> boxes;
+    boxes.reserve( items.size() );
+    sizes.reserve( items.size() );
+
+    for( ITEM* item : items )
+    {
+        boxes.push_back( boundingBox( item, m_layer ) );
+        sizes.push_back( std::max( boxes.back().GetWidth(), boxes.back().GetHeight() ) );
+    }
+
+    // Size the cells so that a typical item plus its clearance area spans a cell or two
+    int median = 0;
+
+    if( !sizes.empty() )
+    {
+        std::nth_element( sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end() );
+        median = sizes[sizes.size() / 2];
+    }
+
+    m_tree.RemoveAll();
+    m_grid.emplace( std::max( GRID_MIN_CELL_SIZE, median + 2 * m_clearance ) );
+
+    for( size_t ii = 0; ii < items.size(); ++ii )
+    {
+        if( m_grid->Fits( boxes[ii] ) )
+            m_grid->Add( items[ii], boxes[ii] );
+        else
+            m_tree.Add( items[ii], boxes[ii] );
+    }
+}
+
+
 
 void INDEX::Add( ITEM* aItem )
 {
@@ -32,18 +169,18 @@ void INDEX::Add( ITEM* aItem )
 
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
     {
-        for( int i = 0; i <= range.End(); ++i )
-            m_subIndices.emplace_back( std::make_unique<ITEM_SHAPE_INDEX>( i ) );
+        for( int i = m_subIndices.size(); i <= range.End(); ++i )
+            m_subIndices.emplace_back( std::make_shared<LAYER_INDEX>( i, m_clearance ) );
     }
 
     for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i]->Add( aItem );
+        writableSubIndex( i ).Add( aItem );
 
-    m_allItems.insert( aItem );
+    writableItems().insert( aItem );
     NET_HANDLE net = aItem->Net();
 
     if( net )
-        m_netMap[net].push_back( aItem );
+        writableNetMap()[net].push_back( aItem );
 }
 
 
@@ -56,13 +193,13 @@ void INDEX::Remove( ITEM* aItem )
         return;
 
     for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i]->Remove( aItem );
+        writableSubIndex( i ).Remove( aItem );
 
-    m_allItems.erase( aItem );
+    writableItems().erase( aItem );
     NET_HANDLE net = aItem->Net();
 
-    if( net && m_netMap.find( net ) != m_netMap.end() )
-        m_netMap[net].remove( aItem );
+    if( net && m_netMap->find( net ) != m_netMap->end() )
+        writableNetMap()[net].remove( aItem );
 }
 
 
@@ -73,12 +210,55 @@ void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 }
 
 
-INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( NET_HANDLE aNet )
+LAYER_INDEX& INDEX::writableSubIndex( std::size_t aIndex )
+{
+    std::shared_ptr<LAYER_INDEX>& subIndex = m_subIndices[aIndex];
+
+    if( subIndex.use_count() > 1 )
+        subIndex = std::make_shared<LAYER_INDEX>( *subIndex );
+
+    return *subIndex;
+}
+
+
+INDEX::ITEM_SET& INDEX::writableItems()
+{
+    if( m_allItems.use_count() > 1 )
+        m_allItems = std::make_shared<ITEM_SET>( *m_allItems );
+
+    return *m_allItems;
+}
+
+
+INDEX::NET_MAP& INDEX::writableNetMap()
+{
+    if( m_netMap.use_count() > 1 )
+        m_netMap = std::make_shared<NET_MAP>( *m_netMap );
+
+    return *m_netMap;
+}
+
+
+void INDEX::SetClearance( int aClearance )
 {
-    if( m_netMap.find( aNet ) == m_netMap.end() )
+    if( aClearance == m_clearance )
+        return;
+
+    m_clearance = aClearance;
+
+    for( std::size_t i = 0; i < m_subIndices.size(); ++i )
+        writableSubIndex( i ).SetClearance( aClearance );
+}
+
+
+const INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( NET_HANDLE aNet ) const
+{
+    auto it = m_netMap->find( aNet );
+
+    if( it == m_netMap->end() )
         return nullptr;
 
-    return &m_netMap[aNet];
+    return &it->second;
 }
 
 };
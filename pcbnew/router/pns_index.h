@@ -22,10 +22,15 @@
 #ifndef __PNS_INDEX_H
 #define __PNS_INDEX_H
 
+#include <algorithm>
 #include <deque>
 #include <list>
 #include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <layer_ids.h>
 #include <geometry/shape_index.h>
@@ -36,21 +41,300 @@
 namespace PNS {
 
 
+/**
+ * Hashed uniform grid, used as the broadphase of densely populated layers.
+ *
+ * Each item is stored once, in the cell holding the top-left corner of its bounding box.  Only
+ * items no larger than a cell are accepted, so a query only has to look one cell beyond the
+ * searched area to the left and top.
+ */
+class ITEM_GRID
+{
+public:
+    ITEM_GRID( int aCellSize ) :
+            m_cellSize( aCellSize )
+    {}
+
+    int CellSize() const { return m_cellSize; }
+
+    ///< Return true if an item with bounding box \a aBox can be stored in the grid.
+    bool Fits( const BOX2I& aBox ) const
+    {
+        return aBox.GetWidth() <= m_cellSize && aBox.GetHeight() <= m_cellSize;
+    }
+
+    void Add( ITEM* aItem, const BOX2I& aBox );
+    bool Remove( ITEM* aItem, const BOX2I& aBox );
+
+    template <class Func>
+    void ForEachItem( Func aFunc ) const
+    {
+        for( const auto& [key, cell] : m_cells )
+        {
+            for( const ENTRY& entry : cell )
+                aFunc( entry.m_item );
+        }
+    }
+
+    /**
+     * Call \a aVisitor( item, boxIndex ) for every item overlapping one of \a aBoxes.  An item
+     * overlapping several boxes is reported once per box.  Return false from the visitor to
+     * stop searching.
+     *
+     * @return number of items found.
+     */
+    template <class Visitor>
+    int Query( const BOX2I* aBoxes, int aCount, Visitor& aVisitor ) const;
+
+private:
+    struct ENTRY
+    {
+        ITEM* m_item;
+        int   m_minX, m_minY, m_maxX, m_maxY;
+
+        bool Overlaps( const BOX2I& aBox ) const
+        {
+            return m_minX <= aBox.GetRight() && m_maxX >= aBox.GetX()
+                    && m_minY <= aBox.GetBottom() && m_maxY >= aBox.GetY();
+        }
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( uint64_t aKey ) const
+        {
+            return static_cast<size_t>( ( aKey ^ ( aKey >> 29 ) ) * 0x9E3779B97F4A7C15ULL );
+        }
+    };
+
+    int cellCoord( int aValue ) const
+    {
+        int c = aValue / m_cellSize;
+        return ( aValue < 0 && c * m_cellSize != aValue ) ? c - 1 : c;
+    }
+
+    static uint64_t cellKey( int aX, int aY )
+    {
+        return ( static_cast<uint64_t>( static_cast<uint32_t>( aX ) ) << 32 )
+                | static_cast<uint32_t>( aY );
+    }
+
+    int                                                       m_cellSize;
+    std::unordered_map<uint64_t, std::vector<ENTRY>, KEY_HASH> m_cells;
+};
+
+
+/**
+ * Spatial index of a single layer.  Items start out in an R-Tree; once the layer gets dense
+ * enough, all items small enough are moved to an #ITEM_GRID with cells sized to the typical
+ * item plus the clearance, and only the large ones (zones, big pads) stay in the tree.
+ */
+class LAYER_INDEX
+{
+public:
+    typedef SHAPE_INDEX<ITEM*> ITEM_SHAPE_INDEX;
+
+    LAYER_INDEX( int aLayer, int aClearance ) :
+            m_tree( aLayer ),
+            m_layer( aLayer ),
+            m_clearance( aClearance ),
+            m_count( 0 )
+    {}
+
+    LAYER_INDEX( const LAYER_INDEX& aOther ) = default;
+
+    void Add( ITEM* aItem );
+    void Remove( ITEM* aItem );
+
+    /**
+     * Set the clearance used to size the grid cells, rebuilding the grid if needed.
+     */
+    void SetClearance( int aClearance );
+
+    bool HasGrid() const { return m_grid.has_value(); }
+
+    template <class Visitor>
+    int Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const
+    {
+        BOX2I box = aShape->BBox();
+        box.Inflate( aMinDistance );
+
+        auto visitOne =
+                [&]( ITEM* aItem, int aBox ) -> bool
+                {
+                    return aVisitor( aItem );
+                };
+
+        return Query( &box, 1, visitOne );
+    }
+
+    /**
+     * Search several areas at once, e.g. the segments of a line.  Calls
+     * \a aVisitor( item, boxIndex ) for every item overlapping one of \a aBoxes.
+     */
+    template <class Visitor>
+    int Query( const BOX2I* aBoxes, int aCount, Visitor& aVisitor ) const
+    {
+        int  total = 0;
+        bool stop = false;
+
+        for( int ii = 0; ii < aCount && !stop; ++ii )
+        {
+            auto treeVisitor =
+                    [&]( ITEM* aItem ) -> bool
+                    {
+                        total++;
+
+                        if( !aVisitor( aItem, ii ) )
+                            stop = true;
+
+                        return !stop;
+                    };
+
+            m_tree.Query( aBoxes[ii], treeVisitor );
+        }
+
+        if( m_grid && !stop )
+            total += m_grid->Query( aBoxes, aCount, aVisitor );
+
+        return total;
+    }
+
+private:
+    void rebuildGrid();
+
+    ITEM_SHAPE_INDEX         m_tree;
+    std::optional<ITEM_GRID> m_grid;
+    int                      m_layer;
+    int                      m_clearance;
+    int                      m_count;
+};
+
+
+template <class Visitor>
+int ITEM_GRID::Query( const BOX2I* aBoxes, int aCount, Visitor& aVisitor ) const
+{
+    size_t cellCount = 0;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        const BOX2I& box = aBoxes[ii];
+
+        cellCount += (size_t) ( cellCoord( box.GetRight() ) - cellCoord( box.GetX() ) + 2 )
+                     * (size_t) ( cellCoord( box.GetBottom() ) - cellCoord( box.GetY() ) + 2 );
+    }
+
+    int total = 0;
+
+    auto visitCell =
+            [&]( const std::vector<ENTRY>& aCell ) -> bool
+            {
+                for( const ENTRY& entry : aCell )
+                {
+                    for( int ii = 0; ii < aCount; ++ii )
+                    {
+                        if( !entry.Overlaps( aBoxes[ii] ) )
+                            continue;
+
+                        total++;
+
+                        if( !aVisitor( entry.m_item, ii ) )
+                            return false;
+                    }
+                }
+
+                return true;
+            };
+
+    // Huge search areas are cheaper to handle by scanning the occupied cells
+    if( cellCount > m_cells.size() )
+    {
+        for( const auto& [key, cell] : m_cells )
+        {
+            if( !visitCell( cell ) )
+                break;
+        }
+
+        return total;
+    }
+
+    auto visitKey =
+            [&]( uint64_t aKey ) -> bool
+            {
+                auto it = m_cells.find( aKey );
+                return it == m_cells.end() || visitCell( it->second );
+            };
+
+    if( aCount == 1 )
+    {
+        const BOX2I& box = aBoxes[0];
+
+        for( int x = cellCoord( box.GetX() ) - 1; x <= cellCoord( box.GetRight() ); ++x )
+        {
+            for( int y = cellCoord( box.GetY() ) - 1; y <= cellCoord( box.GetBottom() ); ++y )
+            {
+                if( !visitKey( cellKey( x, y ) ) )
+                    return total;
+            }
+        }
+
+        return total;
+    }
+
+    std::vector<uint64_t> keys;
+    keys.reserve( cellCount );
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        const BOX2I& box = aBoxes[ii];
+
+        for( int x = cellCoord( box.GetX() ) - 1; x <= cellCoord( box.GetRight() ); ++x )
+        {
+            for( int y = cellCoord( box.GetY() ) - 1; y <= cellCoord( box.GetBottom() ); ++y )
+                keys.push_back( cellKey( x, y ) );
+        }
+    }
+
+    // Boxes of neighbouring segments share cells; visit every cell once
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+    for( uint64_t key : keys )
+    {
+        if( !visitKey( key ) )
+            break;
+    }
+
+    return total;
+}
+
+
 /**
  * INDEX
  *
  * Custom spatial index, holding our board items and allowing for very fast searches. Items
  * are assigned to separate R-Tree subindices depending on their type and spanned layers, reducing
  * overlap and improving search time.
+ *
+ * Copies of an index share their per-layer R-Trees, item set and net map until one of the
+ * copies modifies them, so copying an index (e.g. when branching a NODE) is cheap.  The first
+ * change after a copy still clones the item set and the net map, and each modified layer.
  **/
 class INDEX
 {
 public:
-    typedef std::list<ITEM*>            NET_ITEMS_LIST;
-    typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
-    typedef std::unordered_set<ITEM*>   ITEM_SET;
+    typedef std::list<ITEM*>                     NET_ITEMS_LIST;
+    typedef std::unordered_set<ITEM*>            ITEM_SET;
+    typedef std::map<NET_HANDLE, NET_ITEMS_LIST> NET_MAP;
+
+    INDEX() :
+            m_netMap( std::make_shared<NET_MAP>() ),
+            m_allItems( std::make_shared<ITEM_SET>() ),
+            m_clearance( 0 )
+    {}
 
-    INDEX(){};
+    INDEX( const INDEX& aOther ) = default;
+    INDEX& operator=( const INDEX& aOther ) = default;
 
     /**
      * Adds item to the spatial index.
@@ -95,10 +379,27 @@ public:
     template<class Visitor>
     int Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
+    /**
+     * Searches items in proximity of several shapes on the layers of \a aItem in a single pass,
+     * so that search areas sharing grid cells are only visited once.  For each item found,
+     * aVisitor( item, shapeIndex ) is called.
+     *
+     * @param aShapes shapes to search against, e.g. the segments of a line
+     * @return number of items found.
+     */
+    template<class Visitor>
+    int Query( const ITEM* aItem, const std::vector<const SHAPE*>& aShapes, int aMinDistance,
+               Visitor& aVisitor ) const;
+
+    /**
+     * Sets the clearance used to size the broadphase grid of dense layers.
+     */
+    void SetClearance( int aClearance );
+
     /**
      * Returns list of all items in a given net.
      */
-    NET_ITEMS_LIST* GetItemsForNet( NET_HANDLE aNet );
+    const NET_ITEMS_LIST* GetItemsForNet( NET_HANDLE aNet ) const;
 
     /**
      * Function Contains()
@@ -107,25 +408,36 @@ public:
      */
     bool Contains( ITEM* aItem ) const
     {
-        return m_allItems.find( aItem ) != m_allItems.end();
+        return m_allItems->find( aItem ) != m_allItems->end();
     }
 
     /**
      * Returns number of items stored in the index.
      */
-    int Size() const { return m_allItems.size(); }
+    int Size() const { return m_allItems->size(); }
 
-    ITEM_SET::iterator begin() { return m_allItems.begin(); }
-    ITEM_SET::iterator end() { return m_allItems.end(); }
+    ITEM_SET::const_iterator begin() const { return m_allItems->begin(); }
+    ITEM_SET::const_iterator end() const { return m_allItems->end(); }
 
 private:
     template <class Visitor>
     int querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
+    /**
+     * Return the subindex for layer \a aIndex, first making a private copy of it if it is still
+     * shared with another INDEX.
+     */
+    LAYER_INDEX& writableSubIndex( std::size_t aIndex );
+
+    /// Return the item set or net map, first making a private copy if it is still shared.
+    ITEM_SET& writableItems();
+    NET_MAP&  writableNetMap();
+
 private:
-    std::deque<std::unique_ptr<ITEM_SHAPE_INDEX>> m_subIndices;
-    std::map<NET_HANDLE, NET_ITEMS_LIST> m_netMap;
-    ITEM_SET                             m_allItems;
+    std::deque<std::shared_ptr<LAYER_INDEX>> m_subIndices;
+    std::shared_ptr<NET_MAP>                 m_netMap;
+    std::shared_ptr<ITEM_SET>                m_allItems;
+    int                                      m_clearance;
 };
 
 
@@ -165,6 +477,37 @@ int INDEX::Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) con
     return total;
 }
 
+template<class Visitor>
+int INDEX::Query( const ITEM* aItem, const std::vector<const SHAPE*>& aShapes, int aMinDistance,
+                  Visitor& aVisitor ) const
+{
+    int total = 0;
+
+    wxCHECK( aItem->Kind() != ITEM::INVALID_T, 0 );
+
+    std::vector<BOX2I> boxes;
+    boxes.reserve( aShapes.size() );
+
+    for( const SHAPE* shape : aShapes )
+    {
+        boxes.push_back( shape->BBox() );
+        boxes.back().Inflate( aMinDistance );
+    }
+
+    const PNS_LAYER_RANGE& layers = aItem->Layers();
+
+    for( int i = layers.Start(); i <= layers.End(); ++i )
+    {
+        if( i >= (int) m_subIndices.size() )
+            break;
+
+        LAYER_CONTEXT_SETTER layerContext( aVisitor, i );
+        total += m_subIndices[i]->Query( boxes.data(), (int) boxes.size(), aVisitor );
+    }
+
+    return total;
+}
+
 };
 
 #endif
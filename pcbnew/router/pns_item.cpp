@@ -24,6 +24,8 @@
 #include "pns_line.h"
 #include "pns_router.h"
 
+#include <atomic>
+
 #include <geometry/shape_compound.h>
 #include <geometry/shape_poly_set.h>
 
@@ -359,7 +361,7 @@ const NODE* ITEM::OwningNode() const
 
 LINKED_ITEM::UNIQ_ID LINKED_ITEM::genNextUid()
 {
-    static UNIQ_ID uidCount = 0; // fixme: make atomic
+    static std::atomic<UNIQ_ID> uidCount( 0 );
     return uidCount++;
 }
 
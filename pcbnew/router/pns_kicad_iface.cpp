@@ -56,6 +56,7 @@
 #include <wx/log.h>
 
 #include <memory>
+#include <mutex>
 
 #include <advanced_config.h>
 #include <pcbnew_settings.h>
@@ -157,6 +158,10 @@ private:
 
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_tempClearanceCache;
+
+    // Guards the caches, the dummy items and the DRC engine queries when the router queries
+    // from several threads
+    std::recursive_mutex                         m_mutex;
 };
 
 
@@ -204,6 +209,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::IsNetTieExclusion( const PNS::ITEM* aItem,
     if( !aItem || !aCollidingItem )
         return false;
 
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
     BOARD_ITEM*                 item = aItem->BoardItem();
     BOARD_ITEM*                 collidingItem = aCollidingItem->BoardItem();
@@ -231,6 +238,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::IsNetTieExclusion( const PNS::ITEM* aItem,
 bool PNS_PCBNEW_RULE_RESOLVER::IsKeepout( const PNS::ITEM* aObstacle, const PNS::ITEM* aItem,
                                           bool* aEnforce )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     auto checkKeepout =
             []( const ZONE* aKeepout, const BOARD_ITEM* aOther )
             {
@@ -376,6 +385,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
                                                 const PNS::ITEM* aItemA, const PNS::ITEM* aItemB,
                                                 int aPNSLayer, PNS::CONSTRAINT* aConstraint )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
 
     if( !drcEngine )
@@ -454,6 +465,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>& aItems )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     int n_pruned = 0;
     std::set<const PNS::ITEM*> remainingItems( aItems.begin(), aItems.end() );
 
@@ -481,6 +494,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_clearanceCache.clear();
     m_tempClearanceCache.clear();
 }
@@ -488,6 +503,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_tempClearanceCache.clear();
 }
 
@@ -495,6 +512,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
 
     // Search cache (used for actual board items)
@@ -52,8 +52,21 @@ namespace PNS {
 static std::unordered_set<const NODE*> allocNodes;
 #endif
 
+#ifdef PNS_NODE_STATS
+NODE::STATS& NODE::Stats()
+{
+    static STATS stats;
+    return stats;
+}
+#endif
+
+
 NODE::NODE()
 {
+#ifdef PNS_NODE_STATS
+    Stats().m_nodesAllocated.fetch_add( 1, std::memory_order_relaxed );
+#endif
+
     m_depth = 0;
     m_root = this;
     m_parent = nullptr;
@@ -152,15 +165,13 @@ NODE* NODE::Branch()
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
 
-    // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
+    // Immediate offspring of the root branch needs not copy anything. For the rest, copy
+    // joints and overridden item maps.  The item index only holds the items changed since the
+    // root, and shares its containers with ours until either side modifies them, so branching
+    // doesn't copy it; the first change in either branch does.
     if( !isRoot() )
     {
-        JOINT_MAP::iterator j;
-
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
+        *child->m_index = *m_index;
         child->m_joints = m_joints;
         child->m_override = m_override;
     }
@@ -252,6 +263,13 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 };
 
 
+void NODE::SetMaxClearance( int aClearance )
+{
+    m_maxClearance = aClearance;
+    m_index->SetClearance( aClearance );
+}
+
+
 int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
                           const COLLISION_SEARCH_OPTIONS& aOpts ) const
 {
@@ -261,6 +279,10 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
     if( aItem->IsVirtual() )
         return 0;
 
+#ifdef PNS_NODE_STATS
+    Stats().m_collisionQueries.fetch_add( 1, std::memory_order_relaxed );
+#endif
+
     DEFAULT_OBSTACLE_VISITOR visitor( &ctx, aItem );
 
 #ifdef DEBUG
@@ -283,6 +305,72 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
 }
 
 
+void NODE::querySegmentsColliding( const LINE* aLine, NODE::OBSTACLES& aObstacles,
+                                   const COLLISION_SEARCH_OPTIONS& aOpts ) const
+{
+    // Refines each candidate against the segment it was found for.  All segments share one
+    // head item (as they do when queried one by one), so every obstacle is reported once.
+    struct SEGMENT_BATCH_VISITOR : public DEFAULT_OBSTACLE_VISITOR
+    {
+        SEGMENT_BATCH_VISITOR( COLLISION_SEARCH_CONTEXT* aCtx, SEGMENT* aHead,
+                               const std::vector<SEG>& aSegs ) :
+                DEFAULT_OBSTACLE_VISITOR( aCtx, aHead ),
+                m_head( aHead ),
+                m_segs( aSegs )
+        {
+        }
+
+        bool operator()( ITEM* aCandidate, int aSegIdx )
+        {
+            const SEG& seg = m_segs[aSegIdx];
+
+            m_head->SetEnds( seg.A, seg.B );
+            return DEFAULT_OBSTACLE_VISITOR::operator()( aCandidate );
+        }
+
+        SEGMENT*                m_head;
+        const std::vector<SEG>& m_segs;
+    };
+
+    const SHAPE_LINE_CHAIN&    chain = aLine->CLine();
+    std::vector<SEG>           segs;
+    std::vector<SHAPE_SEGMENT> shapes;
+    std::vector<const SHAPE*>  shapePtrs;
+
+    segs.reserve( chain.SegmentCount() );
+    shapes.reserve( chain.SegmentCount() );
+
+    for( int i = 0; i < chain.SegmentCount(); i++ )
+    {
+        segs.push_back( chain.CSegment( i ) );
+        shapes.emplace_back( segs.back(), aLine->Width() );
+        shapePtrs.push_back( &shapes.back() );
+    }
+
+    SEGMENT head( *aLine, segs[0] );
+
+    /// By default, virtual items cannot collide
+    if( head.IsVirtual() )
+        return;
+
+    COLLISION_SEARCH_CONTEXT ctx( aObstacles, aOpts );
+    SEGMENT_BATCH_VISITOR visitor( &ctx, &head, segs );
+
+#ifdef PNS_NODE_STATS
+    Stats().m_collisionQueries.fetch_add( 1, std::memory_order_relaxed );
+#endif
+
+    visitor.SetWorld( this, nullptr );
+    m_index->Query( &head, shapePtrs, m_maxClearance, visitor );
+
+    if( !isRoot() )
+    {
+        visitor.SetWorld( m_root, this );
+        m_root->m_index->Query( &head, shapePtrs, m_maxClearance, visitor );
+    }
+}
+
+
 NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
                                           const COLLISION_SEARCH_OPTIONS& aOpts )
 {
@@ -290,14 +378,21 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
     const int                 clearanceEpsilon = GetRuleResolver()->ClearanceEpsilon();
     OBSTACLES                 obstacleList;
 
-    for( int i = 0; i < aLine->CLine().SegmentCount(); i++ )
+    if( aOpts.m_limitCount < 0 && aLine->CLine().SegmentCount() > 1 )
     {
-        // Note: Clearances between &s and other items are cached,
-        // which means they'll be the same for all segments in the line.
-        // Disabling the cache will lead to slowness.
+        querySegmentsColliding( aLine, obstacleList, aOpts );
+    }
+    else
+    {
+        for( int i = 0; i < aLine->CLine().SegmentCount(); i++ )
+        {
+            // Note: Clearances between &s and other items are cached,
+            // which means they'll be the same for all segments in the line.
+            // Disabling the cache will lead to slowness.
 
-        const SEGMENT s( *aLine, aLine->CLine().CSegment( i ) );
-        QueryColliding( &s, obstacleList, aOpts );
+            const SEGMENT s( *aLine, aLine->CLine().CSegment( i ) );
+            QueryColliding( &s, obstacleList, aOpts );
+        }
     }
 
     if( aLine->EndsWithVia() )
@@ -1551,7 +1646,7 @@ void NODE::KillChildren()
 
 void NODE::AllItemsInNet( NET_HANDLE aNet, std::set<ITEM*>& aItems, int aKindMask )
 {
-    INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( aNet );
+    const INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( aNet );
 
     if( l_cur )
     {
@@ -1564,7 +1659,7 @@ void NODE::AllItemsInNet( NET_HANDLE aNet, std::set<ITEM*>& aItems, int aKindMas
 
     if( !isRoot() )
     {
-        INDEX::NET_ITEMS_LIST* l_root = m_root->m_index->GetItemsForNet( aNet );
+        const INDEX::NET_ITEMS_LIST* l_root = m_root->m_index->GetItemsForNet( aNet );
 
         if( l_root )
         {
@@ -1716,7 +1811,7 @@ ITEM *NODE::FindItemByParent( const BOARD_ITEM* aParent )
     if( aParent && aParent->IsConnected() )
     {
         const BOARD_CONNECTED_ITEM* cItem = static_cast<const BOARD_CONNECTED_ITEM*>( aParent );
-        INDEX::NET_ITEMS_LIST*      l_cur = m_index->GetItemsForNet( cItem->GetNet() );
+        const INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( cItem->GetNet() );
 
         if( l_cur )
         {
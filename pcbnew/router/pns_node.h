@@ -23,6 +23,7 @@
 #ifndef __PNS_NODE_H
 #define __PNS_NODE_H
 
+#include <atomic>
 #include <vector>
 #include <list>
 #include <set>
@@ -243,9 +244,29 @@ public:
     typedef std::vector<ITEM*>    ITEM_VECTOR;
     typedef std::set<OBSTACLE>    OBSTACLES;
 
+#ifdef PNS_NODE_STATS
+    ///< Process-wide counters, used by the router benchmarks.  Only compiled into qa_pns_benchmark,
+    ///< so that they cost nothing in the router itself.
+    struct STATS
+    {
+        std::atomic<uint64_t> m_nodesAllocated{ 0 };
+        std::atomic<uint64_t> m_collisionQueries{ 0 };
+
+        void Reset()
+        {
+            m_nodesAllocated = 0;
+            m_collisionQueries = 0;
+        }
+    };
+#endif
+
     NODE();
     ~NODE();
 
+#ifdef PNS_NODE_STATS
+    static STATS& Stats();
+#endif
+
     ///< Return the expected clearance between items a and b.
     int GetClearance( const ITEM* aA, const ITEM* aB, bool aUseClearanceEpsilon = true ) const;
 
@@ -256,10 +277,7 @@ public:
     }
 
     ///< Set the worst-case clearance between any pair of items.
-    void SetMaxClearance( int aClearance )
-    {
-        m_maxClearance = aClearance;
-    }
+    void SetMaxClearance( int aClearance );
 
     ///< Assign a clearance resolution function object.
     void SetRuleResolver( RULE_RESOLVER* aFunc )
@@ -562,6 +580,11 @@ private:
 
 private:
     struct DEFAULT_OBSTACLE_VISITOR;
+
+    ///< Find the items colliding with each segment of \a aLine in a single index query.
+    void querySegmentsColliding( const LINE* aLine, OBSTACLES& aObstacles,
+                                 const COLLISION_SEARCH_OPTIONS& aOpts ) const;
+
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
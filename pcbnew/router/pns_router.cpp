@@ -55,11 +55,14 @@ namespace PNS {
 
 // an ugly singleton for drawing debug items within the router context.
 // To be fixed sometime in the future.
-static ROUTER* theRouter;
+// Several routers can be alive at once (e.g. a headless batch router run from the board editor)
+// and they are not always destroyed in reverse order, so keep all of them and hand out the most
+// recent one.
+static std::vector<ROUTER*> theRouters;
 
 ROUTER::ROUTER()
 {
-    theRouter = this;
+    theRouters.push_back( this );
 
     m_state = IDLE;
     m_mode = PNS_MODE_ROUTE_SINGLE;
@@ -80,14 +83,16 @@ ROUTER::ROUTER()
 
 ROUTER* ROUTER::GetInstance()
 {
-    return theRouter;
+    return theRouters.empty() ? nullptr : theRouters.back();
 }
 
 
 ROUTER::~ROUTER()
 {
     ClearWorld();
-    theRouter = nullptr;
+
+    std::erase( theRouters, this );
+
     delete m_logger;
 }
 
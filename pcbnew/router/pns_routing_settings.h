@@ -157,6 +157,10 @@ public:
     int ViaForcePropIterationLimit() const { return m_viaForcePropIterationLimit; }
     void SetViaForcePropIterationLimit(int aLimit) { m_viaForcePropIterationLimit = aLimit; }
 
+    ///< Return true if the walkaround policies are evaluated concurrently on the thread pool.
+    bool GetParallelWalkaround() const { return m_parallelWalkaround; }
+    void SetParallelWalkaround( bool aEnable ) { m_parallelWalkaround = aEnable; }
+
 private:
     bool m_shoveVias;
     bool m_startDiagonal;
@@ -173,6 +177,7 @@ private:
     bool m_optimizeEntireDraggedTrack;
     bool m_autoPosture;
     bool m_fixAllSegments;
+    bool m_parallelWalkaround;
 
     DIRECTION_45::CORNER_MODE m_cornerMode;
 
@@ -19,6 +19,9 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <optional>
 
 #include <geometry/shape_line_chain.h>
@@ -29,6 +32,8 @@
 #include "pns_debug_decorator.h"
 #include "pns_solid.h"
 
+#include <thread_pool.h>
+
 
 namespace PNS {
 
@@ -99,180 +104,292 @@ static wxString policy2string ( WALKAROUND::WALK_POLICY policy )
     return wxT("?");
 }
 
-bool WALKAROUND::singleStep()
+bool WALKAROUND::processCluster( const TOPOLOGY::CLUSTER& aCluster, LINE& aLine, bool aCw )
 {
-    TOPOLOGY topo( m_world );
-    TOPOLOGY::CLUSTER pendingClusters[MaxWalkPolicies];
+    DIRECTION_45::CORNER_MODE cornerMode = Settings().GetCornerMode();
 
-    for( int i = 0; i < MaxWalkPolicies; i++ )
+    PNS_DBG( Dbg(), BeginGroup, wxString::Format( "cluster-details [cw %d]", aCw?1:0 ), 1 );
+
+    for( auto& clItem : aCluster.m_items )
     {
-        if( !m_enabledPolicies[i] )
-            continue;
+        int clearance = m_world->GetClearance( clItem, &aLine, false );
+        SHAPE_LINE_CHAIN hull = clItem->Hull( clearance + 1000, aLine.Width(), aLine.Layer() );
 
-        auto& line = m_currentResult.lines[ i ];
-        auto& status = m_currentResult.status[ i ];
+        if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
+        {
+            BOX2I bbox = hull.BBox();
+            hull.Clear();
+            hull.Append( bbox.GetLeft(),  bbox.GetTop()    );
+            hull.Append( bbox.GetRight(), bbox.GetTop()    );
+            hull.Append( bbox.GetRight(), bbox.GetBottom() );
+            hull.Append( bbox.GetLeft(),  bbox.GetBottom() );
+        }
 
-        PNS_DBG( Dbg(), AddItem, &line, WHITE, 10000, wxString::Format( "current (policy %d, stat %d)", i, status ) );
+        LINE tmp( aLine );
 
-        if( status != ST_IN_PROGRESS )
-            continue;
+        bool stat = aLine.Walkaround( hull, tmp.Line(), aCw );
 
-        auto obstacle = nearestObstacle( line );
+        PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull stat %d", stat?1:0 ) );
+        PNS_DBG( Dbg(), AddItem, &tmp, RED, 10000, wxString::Format( "walk stat %d", stat?1:0 ) );
+        PNS_DBG( Dbg(), AddItem, clItem, WHITE, 10000, wxString::Format( "item stat %d", stat?1:0 ) );
 
-        if( !obstacle )
+        if( !stat )
         {
+            PNS_DBGN( Dbg(), EndGroup );
+            return false;
+        }
 
-            m_currentResult.status[ i ] = ST_DONE;
-            PNS_DBG( Dbg(), Message,  wxString::Format( "no-more-colls pol %d st %d", i, status ) );
+        aLine.SetShape( tmp.CLine() );
+    }
 
-            continue;
-        }
+    PNS_DBGN( Dbg(), EndGroup );
+
+    return true;
+}
 
 
-        pendingClusters[ i ] = topo.AssembleCluster( obstacle->m_item, line.Layer(), 0.0, line.Net() );
-        PNS_DBG( Dbg(), AddItem, obstacle->m_item, BLUE, 10000, wxString::Format( "col-item owner-depth %d cl-items=%d", static_cast<const NODE*>( obstacle->m_item->Owner() )->Depth(), (int) pendingClusters[i].m_items.size() ) );
+TOPOLOGY::CLUSTER WALKAROUND::nextCluster( int aPolicy )
+{
+    auto& line = m_currentResult.lines[ aPolicy ];
+    auto& status = m_currentResult.status[ aPolicy ];
+
+    PNS_DBG( Dbg(), AddItem, &line, WHITE, 10000, wxString::Format( "current (policy %d, stat %d)", aPolicy, status ) );
+
+    if( status != ST_IN_PROGRESS )
+        return TOPOLOGY::CLUSTER();
+
+    auto obstacle = nearestObstacle( line );
 
+    if( !obstacle )
+    {
+        status = ST_DONE;
+        PNS_DBG( Dbg(), Message,  wxString::Format( "no-more-colls pol %d st %d", aPolicy, status ) );
+
+        return TOPOLOGY::CLUSTER();
     }
 
-    DIRECTION_45::CORNER_MODE cornerMode = Settings().GetCornerMode();
+    TOPOLOGY          topo( m_world );
+    TOPOLOGY::CLUSTER cluster = topo.AssembleCluster( obstacle->m_item, line.Layer(), 0.0, line.Net() );
+
+    PNS_DBG( Dbg(), AddItem, obstacle->m_item, BLUE, 10000, wxString::Format( "col-item owner-depth %d cl-items=%d", static_cast<const NODE*>( obstacle->m_item->Owner() )->Depth(), (int) cluster.m_items.size() ) );
 
-    auto processCluster = [ & ] ( TOPOLOGY::CLUSTER& aCluster, LINE& aLine, bool aCw ) -> bool
+    return cluster;
+}
+
+
+void WALKAROUND::walkPolicy( int aPolicy, const TOPOLOGY::CLUSTER& aCluster )
+{
+    if( aPolicy == WP_CW || aPolicy == WP_CCW )
     {
-        PNS_DBG( Dbg(), BeginGroup, wxString::Format( "cluster-details [cw %d]", aCw?1:0 ), 1 );
+        bool stat = processCluster( aCluster, m_currentResult.lines[ aPolicy ], aPolicy == WP_CW );
 
-        for( auto& clItem : aCluster.m_items )
-        {
-            int clearance = m_world->GetClearance( clItem, &aLine, false );
-            SHAPE_LINE_CHAIN hull = clItem->Hull( clearance + 1000, aLine.Width(), aLine.Layer() );
+        if( !stat )
+            m_currentResult.status[ aPolicy ] = ST_STUCK;
 
-            if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
-            {
-                BOX2I bbox = hull.BBox();
-                hull.Clear();
-                hull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-                hull.Append( bbox.GetRight(), bbox.GetTop()    );
-                hull.Append( bbox.GetRight(), bbox.GetBottom() );
-                hull.Append( bbox.GetLeft(),  bbox.GetBottom() );
-            }
+        return;
+    }
+
+    LINE& line = m_currentResult.lines[WP_SHORTEST];
+    LINE  path_cw( line ), path_ccw( line );
+
+    auto st_cw = processCluster( aCluster, path_cw, true );
+    auto st_ccw = processCluster( aCluster, path_ccw, false );
 
-            LINE tmp( aLine );
+    bool cw_coll = st_cw ? m_world->CheckColliding( &path_cw ).has_value() : false;
+    bool ccw_coll = st_ccw ? m_world->CheckColliding( &path_ccw ).has_value() : false;
 
-            bool stat = aLine.Walkaround( hull, tmp.Line(), aCw );
+    double lengthFactorCw = (double) path_cw.CLine().Length() / (double) m_initialLength;
+    double lengthFactorCcw = (double) path_ccw.CLine().Length() / (double) m_initialLength;
 
-            PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull stat %d", stat?1:0 ) );
-            PNS_DBG( Dbg(), AddItem, &tmp, RED, 10000, wxString::Format( "walk stat %d", stat?1:0 ) );
-            PNS_DBG( Dbg(), AddItem, clItem, WHITE, 10000, wxString::Format( "item stat %d", stat?1:0 ) );
+    PNS_DBG( Dbg(), AddItem, &path_cw, RED, 10000, wxString::Format( "shortest-cw stat %d lf %.1f", st_cw?1:0, lengthFactorCw ) );
+    PNS_DBG( Dbg(), AddItem, &path_ccw, BLUE, 10000, wxString::Format( "shortest-ccw stat %d lf %.1f", st_ccw?1:0, lengthFactorCcw ) );
 
-            if( !stat )
+
+    std::optional<LINE> shortest;
+    std::optional<LINE> shortest_alt;
+
+
+    if( st_cw && st_ccw )
+    {
+        if( !cw_coll && !ccw_coll || ( cw_coll && ccw_coll) )
+        {
+            if( path_cw.CLine().Length() > path_ccw.CLine().Length() )
             {
-                PNS_DBGN( Dbg(), EndGroup );
-                return false;
+                shortest = path_ccw;
+                shortest_alt = path_cw;
             }
+            else
+            {
+                shortest = path_cw;
+                shortest_alt = path_ccw;
+            }
+        }
+        else if( !cw_coll )
+            shortest = path_cw;
+        else if( !ccw_coll )
+            shortest = path_ccw;
+
+    }
+    else if( st_ccw )
+        shortest = path_ccw;
+    else if( st_cw )
+        shortest = path_cw;
+
+    bool anyColliding = false;
 
-            aLine.SetShape( tmp.CLine() );
+    if( m_lastShortestCluster && shortest.has_value() )
+    {
+        for( auto& item : m_lastShortestCluster->m_items )
+        {
+            if( shortest->Collide( item, m_world, shortest->Layer() ) )
+            {
+                anyColliding = true;
+                break;
+            }
         }
 
-        PNS_DBGN( Dbg(), EndGroup );
+        PNS_DBG( Dbg(), Message, wxString::Format("check-back cc %d items %d coll %d", (int) aCluster.m_items.size(), (int) m_lastShortestCluster->m_items.size(), anyColliding ? 1: 0 ) );
+    }
 
-        return true;
-    };
+    if ( anyColliding )
+    {
+        shortest = shortest_alt;
+    }
 
-    if ( m_enabledPolicies[WP_CW] )
+    if( !shortest )
     {
-        bool stat = processCluster( pendingClusters[ WP_CW ], m_currentResult.lines[ WP_CW ], true );
-        if( !stat )
-            m_currentResult.status[ WP_CW ] = ST_STUCK;
+        m_currentResult.status[WP_SHORTEST] = ST_STUCK;
     }
+    else
+    {
+        m_currentResult.lines[WP_SHORTEST] = *shortest;
+    }
+
+    m_lastShortestCluster = aCluster;
+}
+
+
+bool WALKAROUND::singleStep()
+{
+    TOPOLOGY::CLUSTER pendingClusters[MaxWalkPolicies];
 
-    if ( m_enabledPolicies[WP_CCW] )
+    for( int i = 0; i < MaxWalkPolicies; i++ )
     {
-        bool stat = processCluster( pendingClusters[ WP_CCW ], m_currentResult.lines[ WP_CCW ], false );
-        if( !stat )
-            m_currentResult.status[ WP_CCW ] = ST_STUCK;
+        if( m_enabledPolicies[i] )
+            pendingClusters[i] = nextCluster( i );
     }
 
-    if( m_enabledPolicies[WP_SHORTEST] )
+    for( int i = 0; i < MaxWalkPolicies; i++ )
     {
-        LINE& line = m_currentResult.lines[WP_SHORTEST];
-        LINE  path_cw( line ), path_ccw( line );
+        if( m_enabledPolicies[i] )
+            walkPolicy( i, pendingClusters[i] );
+    }
 
-        auto st_cw = processCluster( pendingClusters[WP_SHORTEST], path_cw, true );
-        auto st_ccw = processCluster( pendingClusters[WP_SHORTEST], path_ccw, false );
+    return ST_IN_PROGRESS;
+}
 
-        bool cw_coll = st_cw ? m_world->CheckColliding( &path_cw ).has_value() : false;
-        bool ccw_coll = st_ccw ? m_world->CheckColliding( &path_ccw ).has_value() : false;
 
-        double lengthFactorCw = (double) path_cw.CLine().Length() / (double) m_initialLength;
-        double lengthFactorCcw = (double) path_ccw.CLine().Length() / (double) m_initialLength;
+bool WALKAROUND::checkPolicyProgress( int aPolicy, int aIteration )
+{
+    auto& st = m_currentResult.status[aPolicy];
+    auto& ln = m_currentResult.lines[aPolicy];
+    double lengthFactor = (double) ln.CLine().Length() / m_initialLength;
+    // In some situations, there isn't a trivial path (or even a path at all).  Hitting the
+    // iteration limit causes lag, so we can exit out early if the walkaround path gets very long
+    // compared with the initial path.  If the length exceeds the initial length times this factor,
+    // fail out.
+    if( m_lengthLimitOn )
+    {
+        if( st != ST_DONE && lengthFactor > m_lengthExpansionFactor )
+            st = ST_ALMOST_DONE;
+    }
 
-        PNS_DBG( Dbg(), AddItem, &path_cw, RED, 10000, wxString::Format( "shortest-cw stat %d lf %.1f", st_cw?1:0, lengthFactorCw ) );
-        PNS_DBG( Dbg(), AddItem, &path_ccw, BLUE, 10000, wxString::Format( "shortest-ccw stat %d lf %.1f", st_ccw?1:0, lengthFactorCcw ) );
+    PNS_DBG( Dbg(), Message, wxString::Format( "check-wp iter %d st %d i %d lf %.1f", aIteration, st, aPolicy, lengthFactor ) );
 
+    return st == ST_IN_PROGRESS;
+}
 
-        std::optional<LINE> shortest;
-        std::optional<LINE> shortest_alt;
 
+void WALKAROUND::routeParallel()
+{
+    // Every walk policy only ever touches its own line, status and clusters, and the world is
+    // only queried, so the policies can be walked independently.  The result is identical to
+    // stepping them in lock-step.
+    thread_pool&     tp = GetKiCadThreadPool();
+    std::vector<int> policies;
 
-        if( st_cw && st_ccw )
-        {
-            if( !cw_coll && !ccw_coll || ( cw_coll && ccw_coll) )
-            {
-                if( path_cw.CLine().Length() > path_ccw.CLine().Length() )
-                {
-                    shortest = path_ccw;
-                    shortest_alt = path_cw;
-                }
-                else
-                {
-                    shortest = path_cw;
-                    shortest_alt = path_ccw;
-                }
-            }
-            else if( !cw_coll )
-                shortest = path_cw;
-            else if( !ccw_coll )
-                shortest = path_ccw;
+    for( int pol = 0; pol < MaxWalkPolicies; pol++ )
+    {
+        if( m_enabledPolicies[pol] )
+            policies.push_back( pol );
+    }
 
-        }
-        else if( st_ccw )
-            shortest = path_ccw;
-        else if( st_cw )
-            shortest = path_cw;
+    // This may run on a pool thread, and the pool doesn't steal work, so this thread claims
+    // policies too and only waits for the ones another thread has already claimed.  When this
+    // thread is done claiming, every policy has been claimed, so tasks which start later only
+    // touch the shared state.  Exceptions are handed over through the promises and rethrown
+    // once every claimed policy is done.
+    struct PARALLEL_STATE
+    {
+        std::vector<int>                policies;
+        std::vector<int>                iterations;
+        std::vector<std::promise<void>> done;
+        std::atomic<size_t>             next{ 0 };
+    };
 
-        bool anyColliding = false;
+    std::shared_ptr<PARALLEL_STATE> state = std::make_shared<PARALLEL_STATE>();
+    state->policies = std::move( policies );
+    state->iterations.resize( state->policies.size(), 0 );
+    state->done.resize( state->policies.size() );
 
-        if( m_lastShortestCluster && shortest.has_value() )
-        {
-            for( auto& item : m_lastShortestCluster->m_items )
+    std::vector<std::future<void>> results;
+
+    for( std::promise<void>& done : state->done )
+        results.push_back( done.get_future() );
+
+    auto walkPolicies =
+            [this, state]()
             {
-                if( shortest->Collide( item, m_world, shortest->Layer() ) )
+                for( size_t ii = state->next++; ii < state->policies.size(); ii = state->next++ )
                 {
-                    anyColliding = true;
-                    break;
+                    int  policy = state->policies[ii];
+                    int& iteration = state->iterations[ii];
+
+                    try
+                    {
+                        for( iteration = 0; iteration < m_iterationLimit; iteration++ )
+                        {
+                            walkPolicy( policy, nextCluster( policy ) );
+
+                            if( !checkPolicyProgress( policy, iteration ) )
+                                break;
+                        }
+
+                        state->done[ii].set_value();
+                    }
+                    catch( ... )
+                    {
+                        state->done[ii].set_exception( std::current_exception() );
+                    }
                 }
-            }
+            };
 
-            PNS_DBG( Dbg(), Message, wxString::Format("check-back cc %d items %d coll %d", (int) pendingClusters[ WP_SHORTEST ].m_items.size(), (int) m_lastShortestCluster->m_items.size(), anyColliding ? 1: 0 ) );
-        }
+    for( size_t ii = 1; ii < state->policies.size(); ii++ )
+        tp.push_task( walkPolicies );
 
-        if ( anyColliding )
-        {
-            shortest = shortest_alt;
-        }
+    walkPolicies();
 
-        if( !shortest )
-        {
-            m_currentResult.status[WP_SHORTEST] = ST_STUCK;
-        }
-        else
-        {
-            m_currentResult.lines[WP_SHORTEST] = *shortest;
-        }
+    for( std::future<void>& result : results )
+        result.wait();
 
-        m_lastShortestCluster = pendingClusters[ WP_SHORTEST ];
-    }
+    for( std::future<void>& result : results )
+        result.get();
 
-    return ST_IN_PROGRESS;
+    // The lock-step walk runs until the slowest policy is done
+    m_iteration = 0;
+
+    for( int iteration : state->iterations )
+        m_iteration = std::max( m_iteration, iteration );
 }
 
 
@@ -302,7 +419,10 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 
     PNS_DBG( Dbg(), AddItem, &aInitialPath, WHITE, 10000, wxT( "initial-path" ) );
 
-    while( m_iteration < m_iterationLimit )
+    // The debug decorator isn't thread safe, so only walk in parallel when it is silent
+    bool parallel = Settings().GetParallelWalkaround() && !( Dbg() && Dbg()->IsDebugEnabled() );
+
+    while( !parallel && m_iteration < m_iterationLimit )
     {
         singleStep();
 
@@ -313,22 +433,7 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
             if (!m_enabledPolicies[pol])
                 continue;
 
-            auto& st = m_currentResult.status[pol];
-            auto& ln = m_currentResult.lines[pol];
-            double lengthFactor = (double) ln.CLine().Length() / (double) aInitialPath.CLine().Length();
-            // In some situations, there isn't a trivial path (or even a path at all).  Hitting the
-            // iteration limit causes lag, so we can exit out early if the walkaround path gets very long
-            // compared with the initial path.  If the length exceeds the initial length times this factor,
-            // fail out.
-            if( m_lengthLimitOn )
-            {
-                if( st != ST_DONE && lengthFactor > m_lengthExpansionFactor )
-                    st = ST_ALMOST_DONE;
-            }
-
-            PNS_DBG( Dbg(), Message, wxString::Format( "check-wp iter %d st %d i %d lf %.1f", m_iteration, st, pol, lengthFactor ) );
-
-            if ( st == ST_IN_PROGRESS )
+            if( checkPolicyProgress( pol, m_iteration ) )
                 stillInProgress = true;
         }
 
@@ -339,6 +444,9 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
         m_iteration++;
     }
 
+    if( parallel )
+        routeParallel();
+
 
     for( int pol = 0; pol < MaxWalkPolicies; pol++ )
     {
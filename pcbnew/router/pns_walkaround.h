@@ -139,6 +139,32 @@ private:
     void start( const LINE& aInitialPath );
     bool singleStep();
 
+    /**
+     * Find the cluster of obstacles the line of \a aPolicy has to walk around next.  Sets the
+     * policy status to ST_DONE if there are none left.
+     */
+    TOPOLOGY::CLUSTER nextCluster( int aPolicy );
+
+    /**
+     * Walk the line of \a aPolicy around \a aCluster.
+     */
+    void walkPolicy( int aPolicy, const TOPOLOGY::CLUSTER& aCluster );
+
+    bool processCluster( const TOPOLOGY::CLUSTER& aCluster, LINE& aLine, bool aCw );
+
+    /**
+     * Apply the length limit to the line of \a aPolicy after \a aIteration steps.
+     *
+     * @return true if the policy is still in progress.
+     */
+    bool checkPolicyProgress( int aPolicy, int aIteration );
+
+    /**
+     * Walk each enabled policy to completion concurrently on the thread pool.  Exceptions
+     * thrown while walking are rethrown on the calling thread.
+     */
+    void routeParallel();
+
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
     NODE* m_world;
 
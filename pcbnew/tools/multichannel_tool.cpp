@@ -47,6 +47,7 @@
 #include <tools/pcb_picker_tool.h>
 #include <random>
 #include <core/profile.h>
+#include <thread_pool.h>
 #include <wx/log.h>
 #include <pgm_base.h>
 
@@ -477,10 +478,36 @@ int MULTICHANNEL_TOOL::CheckRACompatibility( ZONE *aRefZone )
             continue;
 
         m_areas.m_compatMap[&ra] = RULE_AREA_COMPAT_DATA();
+    }
+
+    if( m_areas.m_compatMap.size() == 1 )
+    {
+        auto& [targetArea, compatData] = *m_areas.m_compatMap.begin();
+        resolveConnectionTopology( m_areas.m_refRA, targetArea, compatData );
+        return 0;
+    }
 
-        resolveConnectionTopology( m_areas.m_refRA, &ra, m_areas.m_compatMap[&ra] );
+    // Match all target areas concurrently.  Each of these searches runs sequentially, so that
+    // the thread pool tasks never wait on each other.
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<bool>> returns;
+
+    for( auto& entry : m_areas.m_compatMap )
+    {
+        RULE_AREA*             targetArea = entry.first;
+        RULE_AREA_COMPAT_DATA* compatData = &entry.second;
+
+        returns.emplace_back( tp.submit(
+                [this, targetArea, compatData]()
+                {
+                    return resolveConnectionTopology( m_areas.m_refRA, targetArea, *compatData,
+                                                      false );
+                } ) );
     }
 
+    for( const std::future<bool>& ret : returns )
+        ret.wait();
+
     return 0;
 }
 
@@ -970,14 +997,16 @@ void MULTICHANNEL_TOOL::fixupNet( BOARD_CONNECTED_ITEM* aRef, BOARD_CONNECTED_IT
 
 
 bool MULTICHANNEL_TOOL::resolveConnectionTopology( RULE_AREA* aRefArea, RULE_AREA* aTargetArea,
-                                                   RULE_AREA_COMPAT_DATA& aMatches )
+                                                   RULE_AREA_COMPAT_DATA& aMatches,
+                                                   bool aParallelSearch )
 {
     using namespace TMATCH;
 
     std::unique_ptr<CONNECTION_GRAPH> cgRef ( CONNECTION_GRAPH::BuildFromFootprintSet( aRefArea->m_raFootprints ) );
     std::unique_ptr<CONNECTION_GRAPH> cgTarget ( CONNECTION_GRAPH::BuildFromFootprintSet( aTargetArea->m_raFootprints ) );
 
-    auto status = cgRef->FindIsomorphism( cgTarget.get(), aMatches.m_matchingComponents );
+    auto status = cgRef->FindIsomorphism( cgTarget.get(), aMatches.m_matchingComponents,
+                                          aParallelSearch );
 
     switch( status )
     {
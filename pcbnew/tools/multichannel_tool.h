@@ -137,7 +137,8 @@ private:
                queryComponentsInComponentClass( const wxString& aComponentClassName ) const;
     RULE_AREA* findRAByName( const wxString& aName );
     bool       resolveConnectionTopology( RULE_AREA* aRefArea, RULE_AREA* aTargetArea,
-                                          RULE_AREA_COMPAT_DATA& aMatches );
+                                          RULE_AREA_COMPAT_DATA& aMatches,
+                                          bool aParallelSearch = true );
     bool       copyRuleAreaContents( TMATCH::COMPONENT_MATCHES& aMatches, BOARD_COMMIT* aCommit, RULE_AREA* aRefArea,
                                      RULE_AREA* aTargetArea, REPEAT_LAYOUT_OPTIONS aOpts, std::unordered_set<BOARD_ITEM*>& aAffectedItems,
                                      std::unordered_set<BOARD_ITEM*>& aGroupableItems );
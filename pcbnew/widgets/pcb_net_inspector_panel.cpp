@@ -609,7 +609,8 @@ struct NETCODE_CMP_LESS
 };
 
 
-std::vector<CN_ITEM*> PCB_NET_INSPECTOR_PANEL::relevantConnectivityItems() const
+std::vector<CN_ITEM*>
+PCB_NET_INSPECTOR_PANEL::relevantConnectivityItems( const std::vector<NETINFO_ITEM*>& aNets ) const
 {
     // Pre-filter the connectivity items and sort them by netcode. This avoids quadratic runtime when building the whole
     // net list.
@@ -619,11 +620,32 @@ std::vector<CN_ITEM*> PCB_NET_INSPECTOR_PANEL::relevantConnectivityItems() const
                                    .set( PCB_VIA_T )
                                    .set( PCB_PAD_T );
 
+    // Only keep the items of the requested nets, so that an incremental update only sorts the items it needs
+    std::vector<bool> net_bits;
+
+    for( const NETINFO_ITEM* net : aNets )
+    {
+        const int netCode = net->GetNetCode();
+
+        if( netCode < 0 )
+            continue;
+
+        if( netCode >= static_cast<int>( net_bits.size() ) )
+            net_bits.resize( netCode + 1, false );
+
+        net_bits[netCode] = true;
+    }
+
     std::vector<CN_ITEM*> cn_items;
     cn_items.reserve( 1024 );
 
     for( CN_ITEM* cn_item : m_board->GetConnectivity()->GetConnectivityAlgo()->ItemList() )
     {
+        const int netCode = cn_item->Net();
+
+        if( netCode < 0 || netCode >= static_cast<int>( net_bits.size() ) || !net_bits[netCode] )
+            continue;
+
         if( cn_item->Valid() && type_bits[cn_item->Parent()->Type()] )
             cn_items.push_back( cn_item );
     }
@@ -640,13 +662,13 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
     std::vector<std::unique_ptr<LIST_ITEM>> results;
 
     LENGTH_DELAY_CALCULATION*   calc = m_board->GetLengthCalculation();
-    const std::vector<CN_ITEM*> conItems = relevantConnectivityItems();
+    const std::vector<CN_ITEM*> conItems = relevantConnectivityItems( aNetCodes );
 
-    // First assemble the LENGTH_CALCULATION_ITEMs for board items which match the nets we need to recompute
+    // First assemble the board items which match the nets we need to recompute
     // Precondition: conItems and aNetCodes are sorted in increasing netcode value
     // Functionality: This extracts any items from conItems which have a netcode which is present in aNetCodes
-    std::unordered_map<int, std::vector<LENGTH_DELAY_CALCULATION_ITEM>> netItemsMap;
-    std::vector<NETINFO_ITEM*>                                    foundNets;
+    std::unordered_map<int, std::vector<const BOARD_CONNECTED_ITEM*>> netItemsMap;
+    std::vector<NETINFO_ITEM*>                                        foundNets;
 
     auto itemItr = conItems.begin();
     auto netCodeItr = aNetCodes.begin();
@@ -662,8 +684,7 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
                 foundNets.emplace_back( *netCodeItr );
 
             // Take the item
-            LENGTH_DELAY_CALCULATION_ITEM lengthItem = calc->GetLengthCalculationItem( ( *itemItr )->Parent() );
-            netItemsMap[curItemNetCode].emplace_back( std::move( lengthItem ) );
+            netItemsMap[curItemNetCode].emplace_back( ( *itemItr )->Parent() );
             ++itemItr;
         }
         else if( curItemNetCode < curNetCode )
@@ -681,7 +702,8 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
     }
 
     // Now calculate the length statistics for each net. This includes potentially expensive path optimisations, so
-    // parallelize this work.
+    // parallelize this work. Nets which have not changed since they were last measured come from the calculation
+    // cache.
     std::mutex   resultsMutex;
     thread_pool& tp = GetKiCadThreadPool();
 
@@ -697,10 +719,10 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
                                                           .MergeTracks = true,
                                                           .OptimiseTracesInPads = true,
                                                           .InferViaInPad = false };
-                    LENGTH_DELAY_STATS           lengthDetails = calc->CalculateLengthDetails(
-                            netItemsMap[netCode], opts, nullptr, nullptr, LENGTH_DELAY_LAYER_OPT::WITH_LAYER_DETAIL,
+                    LENGTH_DELAY_STATS           lengthDetails = calc->CalculateNetLengthDetails(
+                            netItemsMap.at( netCode ), opts, LENGTH_DELAY_LAYER_OPT::WITH_LAYER_DETAIL,
                             m_showTimeDomainDetails ? LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL
-                                                              : LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL );
+                                                    : LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL );
 
                     if( aIncludeZeroPadNets || lengthDetails.NumPads > 0 )
                     {
@@ -833,44 +855,46 @@ void PCB_NET_INSPECTOR_PANEL::updateBoardItems( const std::vector<BOARD_ITEM*>&
     if( !IsShownOnScreen() )
         return;
 
-    // Rebuild full list for large changes
-    if( aBoardItems.size()
-        > static_cast<size_t>( ADVANCED_CFG::GetCfg().m_NetInspectorBulkUpdateOptimisationThreshold ) )
-    {
-        buildNetsList();
-    }
-    else
-    {
-        std::vector<NETINFO_ITEM*> changedNets;
+    // Collect the nets touched by the change. Footprints and groups are walked so that moving them only
+    // refreshes the nets of their pads and tracks.
+    std::vector<NETINFO_ITEM*> changedNets;
 
-        for( BOARD_ITEM* boardItem : aBoardItems )
-        {
-            if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( boardItem ) )
+    auto addItemNet =
+            [&]( BOARD_ITEM* aItem )
             {
-                // A new net has been added to the board. Add it to our list if it passes the netname filter test.
-                if( netFilterMatches( net ) )
+                if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( aItem ) )
+                {
                     changedNets.emplace_back( net );
-            }
-            else if( BOARD_CONNECTED_ITEM* i = dynamic_cast<BOARD_CONNECTED_ITEM*>( boardItem ) )
-            {
-                changedNets.emplace_back( i->GetNet() );
-            }
-            else if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( boardItem ) )
-            {
-                for( const PAD* pad : footprint->Pads() )
+                }
+                else if( BOARD_CONNECTED_ITEM* i = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
                 {
-                    if( netFilterMatches( pad->GetNet() ) )
-                        changedNets.emplace_back( pad->GetNet() );
+                    if( i->GetNet() )
+                        changedNets.emplace_back( i->GetNet() );
                 }
-            }
-        }
+            };
+
+    for( BOARD_ITEM* boardItem : aBoardItems )
+    {
+        addItemNet( boardItem );
+        boardItem->RunOnChildren( addItemNet, RECURSE_MODE::RECURSE );
+    }
+
+    std::ranges::sort( changedNets,
+                       []( const NETINFO_ITEM* a, const NETINFO_ITEM* b )
+                       {
+                           return a->GetNetCode() < b->GetNetCode();
+                       } );
 
-        std::ranges::sort( changedNets,
-                           []( const NETINFO_ITEM* a, const NETINFO_ITEM* b )
-                           {
-                               return a->GetNetCode() < b->GetNetCode();
-                           } );
+    changedNets.erase( std::unique( changedNets.begin(), changedNets.end() ), changedNets.end() );
 
+    // Rebuild full list for changes touching many nets
+    if( changedNets.size()
+        > static_cast<size_t>( ADVANCED_CFG::GetCfg().m_NetInspectorBulkUpdateOptimisationThreshold ) )
+    {
+        buildNetsList();
+    }
+    else
+    {
         updateNets( changedNets );
     }
 
@@ -895,7 +919,7 @@ void PCB_NET_INSPECTOR_PANEL::updateNets( const std::vector<NETINFO_ITEM*>& aNet
 
     m_netsList->Freeze();
 
-    std::vector<std::unique_ptr<LIST_ITEM>> newListItems = calculateNets( aNets, true );
+    std::vector<std::unique_ptr<LIST_ITEM>> newListItems = calculateNets( netsToUpdate, true );
 
     for( std::unique_ptr<LIST_ITEM>& newListItem : newListItems )
     {
@@ -113,8 +113,8 @@ private:
     /// Generates a sub-menu for the show / hide columns submenu
     void generateShowHideColumnMenu( wxMenu* target );
 
-    /// Fetches an ordered (by NetCode) list of all board connectivity items
-    std::vector<CN_ITEM*> relevantConnectivityItems() const;
+    /// Fetches an ordered (by NetCode) list of the board connectivity items on the given nets
+    std::vector<CN_ITEM*> relevantConnectivityItems( const std::vector<NETINFO_ITEM*>& aNets ) const;
 
     /// Filter to determine whether a board net should be included in the net inspector
     bool netFilterMatches( NETINFO_ITEM* aNet, PANEL_NET_INSPECTOR_SETTINGS* cfg = nullptr ) const;
@@ -41,7 +41,6 @@
 #include "x3d.h"
 #include <clocale>
 #include <wx/filename.h>
-#include <wx/stdpaths.h>
 #include <wx/string.h>
 #include <wx/wfstream.h>
 #include <wx/log.h>
@@ -167,20 +166,30 @@ private:
 };
 
 
+/**
+ * Read the decompressed content of a .wrz file from memory, with the same line length limit
+ * as the reader used for .wrl files.
+ */
+class WRZ_LINE_READER : public STRING_LINE_READER
+{
+public:
+    WRZ_LINE_READER( std::string&& aData, const wxString& aSource ) :
+            STRING_LINE_READER( std::string(), aSource )
+    {
+        m_lines = std::move( aData );
+        m_maxLineLength = 8388608;
+    }
+};
+
+
 SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
 {
-    FILE_LINE_READER* modelFile = nullptr;
+    LINE_READER* modelFile = nullptr;
     SCENEGRAPH* scene = nullptr;
-    wxString filename = aFileName;
-    wxFileName tmpfilename;
 
     if( aFileName.Upper().EndsWith( wxT( "WRZ" ) ) )
     {
         wxFFileInputStream ifile( aFileName );
-        tmpfilename = wxFileName( aFileName );
-
-        tmpfilename.SetPath( wxStandardPaths::Get().GetTempDir() );
-        tmpfilename.SetExt( wxT( "WRL" ) );
 
         wxFileOffset size = ifile.GetLength();
 
@@ -188,11 +197,6 @@ SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
             return nullptr;
 
         {
-            wxFFileOutputStream ofile( tmpfilename.GetFullPath() );
-
-            if( !ofile.IsOk() )
-                return nullptr;
-
             char *buffer = new char[size];
 
             ifile.Read( buffer, size);
@@ -220,35 +224,32 @@ SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
 
             delete[] buffer;
 
-            ofile.Write( expanded.data(), expanded.size() );
-            ofile.Close();
+            // parse the expanded data in place rather than through a temporary file; the
+            // source stays the .wrz file so that Inline{} urls resolve next to it
+            modelFile = new WRZ_LINE_READER( std::move( expanded ), aFileName );
         }
-
-        filename = tmpfilename.GetFullPath();
-    }
-
-    try
-    {
-        // set the max char limit to 8MB; if a VRML file contains
-        // longer lines then perhaps it shouldn't be used
-        modelFile = new FILE_LINE_READER( filename, 0, 8388608 );
     }
-    catch( IO_ERROR& e )
+    else
     {
-        wxLogError( wxString( wxS( " * " ) )
-                    << wxString::Format( _( "[INFO] load failed: %s" ), e.What() ) );
+        try
+        {
+            // set the max char limit to 8MB; if a VRML file contains
+            // longer lines then perhaps it shouldn't be used
+            modelFile = new FILE_LINE_READER( aFileName, 0, 8388608 );
+        }
+        catch( IO_ERROR& e )
+        {
+            wxLogError( wxString( wxS( " * " ) )
+                        << wxString::Format( _( "[INFO] load failed: %s" ), e.What() ) );
 
-        return nullptr;
+            return nullptr;
+        }
     }
 
 
     // VRML file processor
     WRLPROC proc( modelFile );
 
-    // Cleanup our temporary file
-    if( tmpfilename.IsOk() )
-        wxRemoveFile( tmpfilename.GetFullPath() );
-
     if( proc.GetVRMLType() == WRLVERSION::VRML_V1 )
     {
         wxLogTrace( traceVrmlPlugin, wxT( " * [INFO] Processing VRML 1.0 file" ) );
@@ -22,6 +22,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <wx/string.h>
@@ -726,6 +729,49 @@ bool WRLPROC::ReadString( std::string& aSFString )
 }
 
 
+bool WRLPROC::parseFloat( const std::string& aGlob, float& aValue )
+{
+    const char* start = aGlob.data();
+    const char* end = start + aGlob.size();
+
+    // an explicit '+' sign is valid VRML but is not accepted by the number conversions
+    if( start != end && '+' == *start && ( end - start ) > 1 && '-' != start[1] )
+        ++start;
+
+    if( start == end )
+        return false;
+
+#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
+    // GCC older than 11 and clang older than 13 have no std::from_chars for floats.  The
+    // plugin switches LC_NUMERIC to "C" while loading, so strtof is safe here.
+    char* tmp;
+
+    errno = 0;
+    aValue = strtof( start, &tmp );
+
+    return errno == 0 && tmp == end;
+#else
+    std::from_chars_result res = std::from_chars( start, end, aValue );
+
+    return res.ec == std::errc() && res.ptr == end;
+#endif
+}
+
+
+bool WRLPROC::parseInt( const std::string& aGlob, int& aValue )
+{
+    const char* start = aGlob.data();
+    const char* end = start + aGlob.size();
+
+    if( start != end && '+' == *start && ( end - start ) > 1 && '-' != start[1] )
+        ++start;
+
+    std::from_chars_result res = std::from_chars( start, end, aValue );
+
+    return res.ec == std::errc() && res.ptr == end;
+}
+
+
 bool WRLPROC::ReadSFBool( bool& aSFBool )
 {
     if( !EatSpace() )
@@ -843,11 +889,7 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
         return false;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFFloat;
-
-    if( istr.fail() || !istr.eof() )
+    if( !parseFloat( tmp, aSFFloat ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -913,11 +955,7 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
         return true;
     }
 
-    std::istringstream istr;
-    istr.str( tmp );
-    istr >> aSFInt32;
-
-    if( istr.fail() || !istr.eof() )
+    if( !parseInt( tmp, aSFInt32 ) )
     {
         std::ostringstream ostr;
         ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -980,11 +1018,7 @@ bool WRLPROC::ReadSFRotation( WRLROTATION& aSFRotation )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> trot[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, trot[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1053,11 +1087,7 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
             return false;
         }
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> tcol[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -1132,11 +1162,7 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
         if( ',' == m_buf[m_bufpos] )
             Pop();
 
-        std::istringstream istr;
-        istr.str( tmp );
-        istr >> tcol[i];
-
-        if( istr.fail() || !istr.eof() )
+        if( !parseFloat( tmp, tcol[i] ) )
         {
             std::ostringstream ostr;
             ostr << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -105,6 +105,10 @@ public:
     bool getRawLine( void );
 
 private:
+    // convert a whole glob to a number without the overhead of a string stream
+    static bool parseFloat( const std::string& aGlob, float& aValue );
+    static bool parseInt( const std::string& aGlob, int& aValue );
+
     LINE_READER* m_file;
     std::string m_buf;          // string being parsed
     bool m_eof;
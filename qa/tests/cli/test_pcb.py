@@ -139,3 +139,46 @@ def test_pcb_export_gerber( kitest: KiTestFixture,
         # Comparison DPI = 5080 => 1px == 5um. I.e. allowable error of 15 um after eroding
         assert utils.gerbers_are_equivalent( str( generated_gerber_path ), gbr_source_path, 5080,
                                              originInches, windowsizeInches )
+
+
+def png_size( path: Path ) -> Tuple[int, int]:
+    # The IHDR chunk always comes first, right after the 8 byte signature
+    with open( path, "rb" ) as f:
+        header = f.read( 24 )
+
+    assert header[:8] == b"\x89PNG\r\n\x1a\n"
+    assert header[12:16] == b"IHDR"
+
+    return ( int.from_bytes( header[16:20], "big" ), int.from_bytes( header[20:24], "big" ) )
+
+
+def test_pcb_render_sides( kitest: KiTestFixture ):
+    input_file = kitest.get_data_file_path( "cli/artwork_generation_regressions/ZoneFill-4.0.7.kicad_pcb" )
+    output_dir = kitest.get_output_path( "cli/render_sides/" )
+    output_file = output_dir / "render.png"
+
+    # Several sides are written to one file per side, named after the side
+    side_files = [ output_dir / "render-top.png", output_dir / "render-bottom.png" ]
+
+    for side_file in side_files:
+        if side_file.exists():
+            side_file.unlink()
+
+    command = [utils.kicad_cli(), "pcb", "render", "--side", "top,bottom", "--quality", "basic",
+               "-w", "64", "-h", "48", "-o", str( output_file ), input_file]
+
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode == 0
+
+    for side_file in side_files:
+        assert side_file.exists()
+        assert png_size( side_file ) == ( 64, 48 )
+        kitest.add_attachment( side_file )
+
+    # A repeated side is rejected before anything is rendered
+    command = [utils.kicad_cli(), "pcb", "render", "--side", "top,top", "--quality", "basic",
+               "-w", "64", "-h", "48", "-o", str( output_file ), input_file]
+
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode != 0
+    assert "Duplicate side" in stderr
@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <base_units.h>
+#include <geometry/eda_angle.h>
+#include <math/util.h>
+#include <page_info.h>
+#include <plotters/plotters_pslike.h>
+
+
+/**
+ * Plot the same items in normal or compact mode, and return the SVG file content.
+ *
+ * The items are three strokes of the same width, the same large polygon at two positions and
+ * another large polygon.
+ */
+static std::string plotItems( bool aCompact )
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path()
+                                       / "qa_svg_plotter_tst.svg";
+
+    SVG_PLOTTER plotter( nullptr );
+
+    plotter.SetPageSettings( PAGE_INFO( PAGE_INFO::A4 ) );
+    plotter.SetViewport( VECTOR2I( 0, 0 ), pcbIUScale.IU_PER_MILS / 10, 1.0, false );
+    plotter.SetSvgCoordinatesFormat( 4 );
+    plotter.SetSvgCompactMode( aCompact );
+
+    BOOST_REQUIRE( plotter.OpenFile( path.string() ) );
+    BOOST_REQUIRE( plotter.StartPlot( wxT( "1" ) ) );
+
+    const int width = pcbIUScale.mmToIU( 0.25 );
+
+    for( int ii = 0; ii < 3; ++ii )
+    {
+        plotter.SetCurrentLineWidth( width );
+        plotter.MoveTo( VECTOR2I( pcbIUScale.mmToIU( 10 ), pcbIUScale.mmToIU( 10 + ii ) ) );
+        plotter.FinishTo( VECTOR2I( pcbIUScale.mmToIU( 20 ), pcbIUScale.mmToIU( 10 + ii ) ) );
+    }
+
+    auto makePoly =
+            []( const VECTOR2I& aOrigin, int aCorners )
+            {
+                std::vector<VECTOR2I> corners;
+
+                // Keep the corners on the 0.1 um grid of the output precision, so that the
+                // quantized offsets are the same at each position
+                const double radius = pcbIUScale.mmToIU( 1.2345 ) / 100.0;
+
+                for( int ii = 0; ii < aCorners; ++ii )
+                {
+                    EDA_ANGLE angle = FULL_CIRCLE * ii / aCorners;
+                    corners.emplace_back( aOrigin.x + KiROUND( radius * angle.Cos() ) * 100,
+                                          aOrigin.y + KiROUND( radius * angle.Sin() ) * 100 );
+                }
+
+                corners.push_back( corners.front() );
+                return corners;
+            };
+
+    plotter.PlotPoly( makePoly( VECTOR2I( pcbIUScale.mmToIU( 50 ), pcbIUScale.mmToIU( 50 ) ), 16 ),
+                      FILL_T::FILLED_SHAPE, 0 );
+    plotter.PlotPoly( makePoly( VECTOR2I( pcbIUScale.mmToIU( 60 ), pcbIUScale.mmToIU( 55 ) ), 16 ),
+                      FILL_T::FILLED_SHAPE, 0 );
+    plotter.PlotPoly( makePoly( VECTOR2I( pcbIUScale.mmToIU( 70 ), pcbIUScale.mmToIU( 50 ) ), 12 ),
+                      FILL_T::FILLED_SHAPE, 0 );
+
+    BOOST_REQUIRE( plotter.EndPlot() );
+
+    std::ifstream     file( path );
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+
+    std::filesystem::remove( path );
+
+    return content.str();
+}
+
+
+static size_t countOf( const std::string& aText, const std::string& aPattern )
+{
+    size_t count = 0;
+
+    for( size_t pos = aText.find( aPattern ); pos != std::string::npos;
+         pos = aText.find( aPattern, pos + aPattern.size() ) )
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+
+BOOST_AUTO_TEST_SUITE( SvgPlotter )
+
+
+BOOST_AUTO_TEST_CASE( NormalMode )
+{
+    const std::string svg = plotItems( false );
+
+    // One path per stroke and per polygon, nothing shared
+    BOOST_CHECK_EQUAL( countOf( svg, "<path" ), 6 );
+    BOOST_CHECK_EQUAL( countOf( svg, "<use" ), 0 );
+    BOOST_CHECK( svg.find( "<path d=\"M10.0000 10.0000\n" ) != std::string::npos );
+}
+
+
+BOOST_AUTO_TEST_CASE( CompactMode )
+{
+    const std::string normal = plotItems( false );
+    const std::string svg = plotItems( true );
+
+    // The three strokes share one path element
+    BOOST_CHECK_EQUAL( countOf( svg, "<path d=\"M" ), 1 );
+    BOOST_CHECK_EQUAL( countOf( svg, "\nM" ), 2 );
+
+    // The repeated polygon is output once and referenced, the other one has its own path
+    BOOST_CHECK_EQUAL( countOf( svg, "<path id=\"p1\"" ), 1 );
+    BOOST_CHECK_EQUAL( countOf( svg, "<path id=\"p2\"" ), 1 );
+    BOOST_CHECK_EQUAL( countOf( svg, "<use xlink:href=\"#p1\" x=\"10\" y=\"5\"/>" ), 1 );
+    BOOST_CHECK_EQUAL( countOf( svg, "<use" ), 1 );
+
+    // Trailing zeros are trimmed
+    BOOST_CHECK( svg.find( "<path d=\"M10 10\nL20 10\n" ) != std::string::npos );
+
+    // Each element is closed
+    BOOST_CHECK_EQUAL( countOf( svg, "<path" ), countOf( svg, "/>\n" ) - countOf( svg, "<use" ) );
+
+    BOOST_CHECK_LT( svg.size(), normal.size() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/shape_index.h>
+#include <geometry/shape_rect.h>
+
+#include <set>
+
+
+namespace
+{
+
+struct INDEXED_RECT
+{
+    INDEXED_RECT( int aX, int aY ) : m_rect( VECTOR2I( aX, aY ), VECTOR2I( 10, 10 ) ) {}
+
+    const SHAPE* Shape( int aLayer ) const { return &m_rect; }
+
+    SHAPE_RECT m_rect;
+};
+
+
+std::set<INDEXED_RECT*> queryAll( const SHAPE_INDEX<INDEXED_RECT*>& aIndex )
+{
+    std::set<INDEXED_RECT*> found;
+    SHAPE_RECT              everything( VECTOR2I( -100000, -100000 ), VECTOR2I( 200000, 200000 ) );
+
+    auto visitor = [&found]( INDEXED_RECT* aItem ) -> bool
+                   {
+                       found.insert( aItem );
+                       return true;
+                   };
+
+    aIndex.Query( &everything, 0, visitor );
+
+    return found;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( ShapeIndex )
+
+
+/**
+ * A copied index must hold the same items as the original and be fully independent of it.
+ */
+BOOST_AUTO_TEST_CASE( CopyIsIndependent )
+{
+    std::vector<std::unique_ptr<INDEXED_RECT>> items;
+    SHAPE_INDEX<INDEXED_RECT*>                 index( 0 );
+
+    // Enough items to build a tree several levels deep
+    for( int ii = 0; ii < 500; ++ii )
+    {
+        items.push_back( std::make_unique<INDEXED_RECT>( ( ii % 25 ) * 100, ( ii / 25 ) * 100 ) );
+        index.Add( items.back().get() );
+    }
+
+    SHAPE_INDEX<INDEXED_RECT*> copy( index );
+
+    BOOST_CHECK( queryAll( copy ) == queryAll( index ) );
+    BOOST_CHECK_EQUAL( queryAll( copy ).size(), items.size() );
+
+    for( int ii = 0; ii < 250; ++ii )
+        copy.Remove( items[ii].get() );
+
+    BOOST_CHECK_EQUAL( queryAll( copy ).size(), items.size() - 250 );
+    BOOST_CHECK_EQUAL( queryAll( index ).size(), items.size() );
+
+    INDEXED_RECT extra( 5000, 5000 );
+    index.Add( &extra );
+
+    BOOST_CHECK_EQUAL( queryAll( index ).size(), items.size() + 1 );
+    BOOST_CHECK_EQUAL( queryAll( copy ).count( &extra ), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <settings/settings_manager.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+
+/**
+ * The creepage board has three pairs of parallel tracks on F.Cu, in nets A/B, C/D and E/F:
+ *  - A and B are 1.75 mm apart
+ *  - C and D are 1.75 mm apart too, but a 1 mm wide slot runs between them and 5 mm past
+ *    their ends, so the creepage path around it is about 10.8 mm long
+ *  - E and F are 9.75 mm apart
+ * The pairs are more than 12.5 mm away from each other.
+ */
+struct DRC_CREEPAGE_TEST_FIXTURE
+{
+    DRC_CREEPAGE_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /**
+     * Run the DRC and return the net name pairs of the creepage violations, sorted.
+     */
+    std::set<std::pair<wxString, wxString>> runCreepage()
+    {
+        std::vector<DRC_ITEM>  violations;
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+        // Only keep the creepage test
+        for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
+            bds.m_DRCSeverities[ ii ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+        bds.m_DRCSeverities[ DRCE_CREEPAGE ] = SEVERITY::RPT_SEVERITY_ERROR;
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer,
+                     DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
+                {
+                    if( aItem->GetErrorCode() == DRCE_CREEPAGE )
+                        violations.push_back( *aItem );
+                } );
+
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+        std::set<std::pair<wxString, wxString>> pairs;
+
+        for( const DRC_ITEM& item : violations )
+        {
+            BOOST_TEST_MESSAGE( item.GetErrorMessage() );
+
+            BOARD_ITEM* item1 = m_board->GetItem( item.GetMainItemID() );
+            BOARD_ITEM* item2 = m_board->GetItem( item.GetAuxItemID() );
+
+            BOOST_REQUIRE( item1 && item1->IsConnected() );
+            BOOST_REQUIRE( item2 && item2->IsConnected() );
+
+            wxString net1 = static_cast<BOARD_CONNECTED_ITEM*>( item1 )->GetNetname();
+            wxString net2 = static_cast<BOARD_CONNECTED_ITEM*>( item2 )->GetNetname();
+
+            pairs.emplace( std::min( net1, net2 ), std::max( net1, net2 ) );
+        }
+
+        // Each pair is reported once
+        BOOST_CHECK_EQUAL( pairs.size(), violations.size() );
+
+        return pairs;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( DRCCreepage, DRC_CREEPAGE_TEST_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( DirectPath )
+{
+    // With a 3 mm creepage, only A/B are too close: the path between C and D goes around the
+    // slot and is much longer than the target, and E/F are out of range
+    KI_TEST::LoadBoard( m_settingsManager, "creepage", m_board );
+
+    std::set<std::pair<wxString, wxString>> expected = { { wxS( "A" ), wxS( "B" ) } };
+    std::set<std::pair<wxString, wxString>> pairs = runCreepage();
+
+    BOOST_CHECK( pairs == expected );
+}
+
+
+BOOST_AUTO_TEST_CASE( PathAroundSlot )
+{
+    // With an 11.5 mm creepage, the path around the slot is found too, and E/F are in range
+    KI_TEST::LoadBoard( m_settingsManager, "creepage", m_board );
+
+    const std::filesystem::path rulesPath = std::filesystem::temp_directory_path()
+                                            / "qa_drc_creepage_tst.kicad_dru";
+
+    {
+        std::ofstream rules( rulesPath );
+        rules << "(version 1)\n"
+                 "(rule \"creepage\" (constraint creepage (min 11.5mm)))\n";
+    }
+
+    m_board->GetDesignSettings().m_DRCEngine->InitEngine( wxFileName( rulesPath.string() ) );
+    std::filesystem::remove( rulesPath );
+
+    std::set<std::pair<wxString, wxString>> expected = { { wxS( "A" ), wxS( "B" ) },
+                                                         { wxS( "C" ), wxS( "D" ) },
+                                                         { wxS( "E" ), wxS( "F" ) } };
+    std::set<std::pair<wxString, wxString>> pairs = runCreepage();
+
+    BOOST_CHECK( pairs == expected );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
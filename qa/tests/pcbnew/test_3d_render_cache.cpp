@@ -0,0 +1,230 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <3d_cache/3d_cache.h>
+#include <plugins/3dapi/ifsg_api.h>
+
+
+struct RENDER_CACHE_FIXTURE
+{
+    RENDER_CACHE_FIXTURE() :
+            m_path( std::filesystem::temp_directory_path() / "qa_render_cache_tst.3dm" ),
+            m_fileName( m_path.string() ),
+            m_model( S3D::New3DModel() )
+    {
+        m_model->m_MaterialsSize = 2;
+        m_model->m_Materials = new SMATERIAL[2];
+
+        for( unsigned int ii = 0; ii < 2; ++ii )
+        {
+            SMATERIAL& mat = m_model->m_Materials[ii];
+
+            S3D::Init3DMaterial( mat );
+            mat.m_Ambient = SFVEC3F( 0.1f * ii );
+            mat.m_Diffuse = SFVEC3F( 0.2f, 0.3f, 0.4f + 0.1f * ii );
+            mat.m_Emissive = SFVEC3F( 0.0f );
+            mat.m_Specular = SFVEC3F( 0.5f );
+            mat.m_Shininess = 0.25f;
+            mat.m_Transparency = 0.5f * ii;
+        }
+
+        m_model->m_MeshesSize = 2;
+        m_model->m_Meshes = new SMESH[2];
+
+        // The first mesh has texture coordinates and colors, the second has neither
+        fillMesh( m_model->m_Meshes[0], 0, true );
+        fillMesh( m_model->m_Meshes[1], 1, false );
+    }
+
+    ~RENDER_CACHE_FIXTURE()
+    {
+        S3D::Destroy3DModel( &m_model );
+        std::filesystem::remove( m_path );
+    }
+
+    static void fillMesh( SMESH& aMesh, unsigned int aMaterialIdx, bool aWithOptionalArrays )
+    {
+        S3D::Init3DMesh( aMesh );
+
+        aMesh.m_VertexSize = 4;
+        aMesh.m_Positions = new SFVEC3F[4];
+        aMesh.m_Normals = new SFVEC3F[4];
+
+        for( unsigned int ii = 0; ii < 4; ++ii )
+        {
+            aMesh.m_Positions[ii] = SFVEC3F( ii & 1, ii >> 1, aMaterialIdx );
+            aMesh.m_Normals[ii] = SFVEC3F( 0.0f, 0.0f, 1.0f );
+        }
+
+        if( aWithOptionalArrays )
+        {
+            aMesh.m_Texcoords = new SFVEC2F[4];
+            aMesh.m_Color = new SFVEC3F[4];
+
+            for( unsigned int ii = 0; ii < 4; ++ii )
+            {
+                aMesh.m_Texcoords[ii] = SFVEC2F( ii & 1, ii >> 1 );
+                aMesh.m_Color[ii] = SFVEC3F( 0.25f * ii );
+            }
+        }
+
+        const unsigned int faces[] = { 0, 1, 2, 1, 3, 2 };
+
+        aMesh.m_FaceIdxSize = 6;
+        aMesh.m_FaceIdx = new unsigned int[6];
+        std::copy( std::begin( faces ), std::end( faces ), aMesh.m_FaceIdx );
+        aMesh.m_MaterialIdx = aMaterialIdx;
+    }
+
+    S3DMODEL* writeAndRead()
+    {
+        BOOST_REQUIRE( S3D_CACHE::WriteRenderCache( m_fileName, "plugin info", *m_model ) );
+
+        std::string pluginInfo;
+        S3DMODEL*   model = S3D_CACHE::ReadRenderCache( m_fileName, pluginInfo );
+
+        if( model )
+            BOOST_CHECK_EQUAL( pluginInfo, "plugin info" );
+
+        return model;
+    }
+
+    std::filesystem::path m_path;
+    wxString              m_fileName;
+    S3DMODEL*             m_model;
+};
+
+
+template <typename T>
+static void checkArray( const T* aExpected, const T* aActual, unsigned int aSize )
+{
+    BOOST_REQUIRE_EQUAL( aExpected == nullptr, aActual == nullptr );
+
+    for( unsigned int ii = 0; aExpected && ii < aSize; ++ii )
+        BOOST_CHECK( aExpected[ii] == aActual[ii] );
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( RenderCache3D, RENDER_CACHE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    S3DMODEL* model = writeAndRead();
+
+    BOOST_REQUIRE( model );
+    BOOST_REQUIRE_EQUAL( model->m_MaterialsSize, m_model->m_MaterialsSize );
+    BOOST_REQUIRE_EQUAL( model->m_MeshesSize, m_model->m_MeshesSize );
+
+    for( unsigned int ii = 0; ii < model->m_MaterialsSize; ++ii )
+    {
+        const SMATERIAL& expected = m_model->m_Materials[ii];
+        const SMATERIAL& actual = model->m_Materials[ii];
+
+        BOOST_CHECK( expected.m_Ambient == actual.m_Ambient );
+        BOOST_CHECK( expected.m_Diffuse == actual.m_Diffuse );
+        BOOST_CHECK( expected.m_Emissive == actual.m_Emissive );
+        BOOST_CHECK( expected.m_Specular == actual.m_Specular );
+        BOOST_CHECK_EQUAL( expected.m_Shininess, actual.m_Shininess );
+        BOOST_CHECK_EQUAL( expected.m_Transparency, actual.m_Transparency );
+    }
+
+    for( unsigned int ii = 0; ii < model->m_MeshesSize; ++ii )
+    {
+        const SMESH& expected = m_model->m_Meshes[ii];
+        const SMESH& actual = model->m_Meshes[ii];
+
+        BOOST_TEST_CONTEXT( "Mesh " << ii )
+        {
+            BOOST_REQUIRE_EQUAL( actual.m_VertexSize, expected.m_VertexSize );
+            BOOST_REQUIRE_EQUAL( actual.m_FaceIdxSize, expected.m_FaceIdxSize );
+            BOOST_CHECK_EQUAL( actual.m_MaterialIdx, expected.m_MaterialIdx );
+
+            checkArray( expected.m_Positions, actual.m_Positions, expected.m_VertexSize );
+            checkArray( expected.m_Normals, actual.m_Normals, expected.m_VertexSize );
+            checkArray( expected.m_Texcoords, actual.m_Texcoords, expected.m_VertexSize );
+            checkArray( expected.m_Color, actual.m_Color, expected.m_VertexSize );
+            checkArray( expected.m_FaceIdx, actual.m_FaceIdx, expected.m_FaceIdxSize );
+        }
+    }
+
+    S3D::Destroy3DModel( &model );
+}
+
+
+BOOST_AUTO_TEST_CASE( TruncatedFile )
+{
+    BOOST_REQUIRE( S3D_CACHE::WriteRenderCache( m_fileName, "plugin info", *m_model ) );
+
+    const std::uintmax_t size = std::filesystem::file_size( m_path );
+
+    // Cut the file in the middle of the arrays, and in the header
+    for( std::uintmax_t newSize : { size - 1, size / 2, (std::uintmax_t) 10 } )
+    {
+        BOOST_TEST_CONTEXT( "Size " << newSize )
+        {
+            std::filesystem::resize_file( m_path, newSize );
+
+            std::string pluginInfo;
+            BOOST_CHECK( S3D_CACHE::ReadRenderCache( m_fileName, pluginInfo ) == nullptr );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( BadMagic )
+{
+    BOOST_REQUIRE( S3D_CACHE::WriteRenderCache( m_fileName, "plugin info", *m_model ) );
+
+    {
+        std::fstream file( m_path, std::ios::in | std::ios::out | std::ios::binary );
+        file.put( 'X' );
+    }
+
+    std::string pluginInfo;
+    BOOST_CHECK( S3D_CACHE::ReadRenderCache( m_fileName, pluginInfo ) == nullptr );
+}
+
+
+BOOST_AUTO_TEST_CASE( BadMaterialIndex )
+{
+    m_model->m_Meshes[1].m_MaterialIdx = m_model->m_MaterialsSize;
+
+    BOOST_CHECK( writeAndRead() == nullptr );
+}
+
+
+BOOST_AUTO_TEST_CASE( BadFaceIndex )
+{
+    m_model->m_Meshes[0].m_FaceIdx[4] = m_model->m_Meshes[0].m_VertexSize;
+
+    BOOST_CHECK( writeAndRead() == nullptr );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <autorouter/ar_batch_router.h>
+#include <board.h>
+#include <connectivity/connectivity_data.h>
+#include <pcb_track.h>
+#include <settings/settings_manager.h>
+#include <tool/tool_manager.h>
+#include <tool/tools_holder.h>
+
+
+namespace
+{
+
+struct AR_BATCH_ROUTER_TEST_FIXTURE
+{
+    AR_BATCH_ROUTER_TEST_FIXTURE() : m_settingsManager( true /* headless */ ) {}
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+class AR_BATCH_TOOLS_HOLDER : public TOOLS_HOLDER
+{
+public:
+    wxWindow* GetToolCanvas() const override { return nullptr; }
+};
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( ArBatchRouter, AR_BATCH_ROUTER_TEST_FIXTURE )
+
+
+/**
+ * Net A is a straight run between two pads.  The second pad of net B sits inside a closed
+ * loop of net C tracks, which the walkaround router can't get through on a single layer.
+ */
+BOOST_AUTO_TEST_CASE( RoutesReachableConnections )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "ar_batch_router", m_board );
+
+    TOOL_MANAGER           toolMgr;
+    AR_BATCH_TOOLS_HOLDER* toolsHolder = new AR_BATCH_TOOLS_HOLDER;
+
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, toolsHolder );
+
+    int tracksBefore = (int) m_board->Tracks().size();
+
+    AR_BATCH_ROUTER         router( m_board.get(), &toolMgr );
+    AR_BATCH_ROUTER::RESULT result = router.Run();
+
+    BOOST_CHECK_EQUAL( result.m_attempted, 2 );
+    BOOST_CHECK_EQUAL( result.m_routed, 1 );
+    BOOST_CHECK_EQUAL( result.m_failed, 1 );
+    BOOST_CHECK( !result.m_cancelled );
+
+    BOOST_CHECK_GT( (int) m_board->Tracks().size(), tracksBefore );
+
+    int netBTracks = 0;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->GetNetname() == wxT( "B" ) )
+            netBTracks++;
+    }
+
+    // Connections that don't reach their target are not committed
+    BOOST_CHECK_EQUAL( netBTracks, 0 );
+
+    m_board->BuildConnectivity();
+
+    // Only the net B connection is left
+    BOOST_CHECK_EQUAL( (int) m_board->GetConnectivity()->GetUnconnectedCount( false ), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,219 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <base_units.h>
+#include <convert_shape_list_to_polygon.h>
+#include <geometry/shape_poly_set.h>
+#include <pcb_shape.h>
+
+
+struct OUTLINE_CONVERSION_FIXTURE
+{
+    PCB_SHAPE* addShape( SHAPE_T aShape, const VECTOR2I& aStart, const VECTOR2I& aEnd )
+    {
+        m_shapes.push_back( std::make_unique<PCB_SHAPE>( nullptr, aShape ) );
+
+        PCB_SHAPE* shape = m_shapes.back().get();
+        shape->SetLayer( Edge_Cuts );
+        shape->SetStart( aStart );
+        shape->SetEnd( aEnd );
+
+        return shape;
+    }
+
+    PCB_SHAPE* addSegment( int aX1, int aY1, int aX2, int aY2 )
+    {
+        return addShape( SHAPE_T::SEGMENT, mm( aX1, aY1 ), mm( aX2, aY2 ) );
+    }
+
+    PCB_SHAPE* addRect( int aX1, int aY1, int aX2, int aY2 )
+    {
+        return addShape( SHAPE_T::RECTANGLE, mm( aX1, aY1 ), mm( aX2, aY2 ) );
+    }
+
+    PCB_SHAPE* addCircle( int aX, int aY, int aRadius )
+    {
+        return addShape( SHAPE_T::CIRCLE, mm( aX, aY ), mm( aX + aRadius, aY ) );
+    }
+
+    /**
+     * Add a rectangle made of four segments, given in a scrambled order and direction.
+     */
+    void addSegmentRect( int aX1, int aY1, int aX2, int aY2 )
+    {
+        addSegment( aX2, aY1, aX2, aY2 );
+        addSegment( aX1, aY1, aX1, aY2 );
+        addSegment( aX1, aY1, aX2, aY1 );
+        addSegment( aX1, aY2, aX2, aY2 );
+    }
+
+    bool convert( bool aAllowDisjoint )
+    {
+        std::vector<PCB_SHAPE*> shapes;
+
+        for( const std::unique_ptr<PCB_SHAPE>& shape : m_shapes )
+            shapes.push_back( shape.get() );
+
+        OUTLINE_ERROR_HANDLER errorHandler =
+                [&]( const wxString& aMsg, BOARD_ITEM* aItemA, BOARD_ITEM* aItemB,
+                     const VECTOR2I& aPt )
+                {
+                    m_errors.push_back( aMsg );
+                };
+
+        m_polys.RemoveAllContours();
+        m_errors.clear();
+
+        return ConvertOutlineToPolygon( shapes, m_polys, pcbIUScale.mmToIU( 0.005 ),
+                                        pcbIUScale.mmToIU( 0.01 ), aAllowDisjoint,
+                                        &errorHandler );
+    }
+
+    /// Index of the outline whose bounding box has the given width, or -1
+    int outlineOfWidth( int aWidth ) const
+    {
+        for( int ii = 0; ii < m_polys.OutlineCount(); ++ii )
+        {
+            if( m_polys.COutline( ii ).BBox().GetWidth() == pcbIUScale.mmToIU( aWidth ) )
+                return ii;
+        }
+
+        return -1;
+    }
+
+    static VECTOR2I mm( int aX, int aY )
+    {
+        return VECTOR2I( pcbIUScale.mmToIU( aX ), pcbIUScale.mmToIU( aY ) );
+    }
+
+    std::vector<std::unique_ptr<PCB_SHAPE>> m_shapes;
+    SHAPE_POLY_SET                          m_polys;
+    std::vector<wxString>                   m_errors;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ConvertOutlineToPolygonTests, OUTLINE_CONVERSION_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( SegmentsChainedIntoOutline )
+{
+    addSegmentRect( 0, 0, 100, 50 );
+
+    // Chained within the epsilon
+    m_shapes.front()->SetEnd( m_shapes.front()->GetEnd() + VECTOR2I( 0, 5 ) );
+
+    BOOST_CHECK( convert( false ) );
+    BOOST_CHECK( m_errors.empty() );
+    BOOST_REQUIRE_EQUAL( m_polys.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( m_polys.HoleCount( 0 ), 0 );
+    BOOST_CHECK_EQUAL( m_polys.COutline( 0 ).PointCount(), 4 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Holes )
+{
+    addSegmentRect( 0, 0, 100, 100 );
+    addRect( 10, 10, 30, 30 );
+    addSegmentRect( 60, 10, 90, 30 );
+    addCircle( 50, 70, 10 );
+
+    BOOST_CHECK( convert( false ) );
+    BOOST_CHECK( m_errors.empty() );
+    BOOST_REQUIRE_EQUAL( m_polys.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( m_polys.HoleCount( 0 ), 3 );
+}
+
+
+BOOST_AUTO_TEST_CASE( NestedHoles )
+{
+    // An outline, a hole in it, an island in the hole and a hole in the island
+    addSegmentRect( 0, 0, 100, 100 );
+    addRect( 10, 10, 90, 90 );
+    addSegmentRect( 20, 20, 80, 80 );
+    addCircle( 50, 50, 20 );
+
+    BOOST_CHECK( convert( true ) );
+    BOOST_CHECK( m_errors.empty() );
+    BOOST_REQUIRE_EQUAL( m_polys.OutlineCount(), 2 );
+
+    int outer = outlineOfWidth( 100 );
+    int island = outlineOfWidth( 60 );
+
+    BOOST_REQUIRE( outer >= 0 && island >= 0 );
+    BOOST_REQUIRE_EQUAL( m_polys.HoleCount( outer ), 1 );
+    BOOST_REQUIRE_EQUAL( m_polys.HoleCount( island ), 1 );
+    BOOST_CHECK_EQUAL( m_polys.CHole( outer, 0 ).BBox().GetWidth(), pcbIUScale.mmToIU( 80 ) );
+    BOOST_CHECK_LE( std::abs( m_polys.CHole( island, 0 ).BBox().GetWidth()
+                              - pcbIUScale.mmToIU( 40 ) ),
+                    pcbIUScale.mmToIU( 0.01 ) );
+
+    // The island is a second top-level outline
+    BOOST_CHECK( !convert( false ) );
+    BOOST_CHECK_EQUAL( m_errors.size(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( SelfIntersectingOutline )
+{
+    // A bow tie
+    addSegment( 0, 0, 100, 100 );
+    addSegment( 100, 100, 100, 0 );
+    addSegment( 100, 0, 0, 100 );
+    addSegment( 0, 100, 0, 0 );
+
+    BOOST_CHECK( !convert( false ) );
+    BOOST_REQUIRE( !m_errors.empty() );
+    BOOST_CHECK( m_errors.front().Contains( wxS( "self-intersecting" ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( OverlappingHoles )
+{
+    // Two holes crossing each other, with no corner of one inside the other
+    addSegmentRect( 0, 0, 100, 100 );
+    addRect( 10, 30, 50, 40 );
+    addRect( 25, 10, 35, 60 );
+
+    BOOST_CHECK( !convert( false ) );
+    BOOST_CHECK_EQUAL( m_errors.size(), 4 );
+
+    for( const wxString& error : m_errors )
+        BOOST_CHECK( error.Contains( wxS( "self-intersecting" ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( OpenOutline )
+{
+    addSegment( 0, 0, 100, 0 );
+    addSegment( 100, 0, 100, 100 );
+    addSegment( 100, 100, 0, 100 );
+
+    BOOST_CHECK( !convert( false ) );
+    BOOST_REQUIRE( !m_errors.empty() );
+    BOOST_CHECK( m_errors.front().Contains( wxS( "not a closed shape" ) ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <length_delay_calculation/length_delay_calculation.h>
+
+
+struct LENGTH_DELAY_CACHE_FIXTURE
+{
+    LENGTH_DELAY_CACHE_FIXTURE()
+    {
+        m_net1 = new NETINFO_ITEM( &m_board, wxS( "net1" ), 1 );
+        m_net2 = new NETINFO_ITEM( &m_board, wxS( "net2" ), 2 );
+        m_board.Add( m_net1 );
+        m_board.Add( m_net2 );
+
+        m_trackA = addTrack( VECTOR2I( 0, 0 ), VECTOR2I( pcbIUScale.mmToIU( 10 ), 0 ) );
+        m_trackB = addTrack( VECTOR2I( pcbIUScale.mmToIU( 10 ), 0 ),
+                             VECTOR2I( pcbIUScale.mmToIU( 20 ), 0 ) );
+    }
+
+    PCB_TRACK* addTrack( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+    {
+        PCB_TRACK* track = new PCB_TRACK( &m_board );
+
+        track->SetLayer( F_Cu );
+        track->SetWidth( pcbIUScale.mmToIU( 0.2 ) );
+        track->SetStart( aStart );
+        track->SetEnd( aEnd );
+        track->SetNet( m_net1 );
+        m_board.Add( track );
+
+        return track;
+    }
+
+    int64_t netLength()
+    {
+        constexpr PATH_OPTIMISATIONS opts = { .OptimiseViaLayers = true,
+                                              .MergeTracks = true,
+                                              .OptimiseTracesInPads = true,
+                                              .InferViaInPad = false };
+
+        LENGTH_DELAY_STATS stats = m_board.GetLengthCalculation()->CalculateNetLengthDetails(
+                { m_trackA, m_trackB }, opts );
+
+        return stats.TrackLength;
+    }
+
+    BOARD         m_board;
+    NETINFO_ITEM* m_net1;
+    NETINFO_ITEM* m_net2;
+    PCB_TRACK*    m_trackA;
+    PCB_TRACK*    m_trackB;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( LengthDelayCache, LENGTH_DELAY_CACHE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( UnchangedNetIsCached )
+{
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 20 ) );
+
+    // Not reported to the board, so the cached result must still be returned
+    m_trackB->SetEnd( VECTOR2I( pcbIUScale.mmToIU( 30 ), 0 ) );
+
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 20 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( TrackEditInvalidates )
+{
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 20 ) );
+
+    m_trackB->SetEnd( VECTOR2I( pcbIUScale.mmToIU( 30 ), 0 ) );
+    m_board.OnItemChanged( m_trackB );
+
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 30 ) );
+
+    std::vector<BOARD_ITEM*> changed = { m_trackA };
+    m_trackA->SetStart( VECTOR2I( pcbIUScale.mmToIU( 5 ), 0 ) );
+    m_board.OnItemsChanged( changed );
+
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 25 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( NetChangeInvalidatesOldNet )
+{
+    // Cached under net1, the net of the first item
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 20 ) );
+
+    // The track leaves net1: the net1 entries it was measured in must be dropped too
+    m_trackB->SetNet( m_net2 );
+    m_trackB->SetEnd( VECTOR2I( pcbIUScale.mmToIU( 40 ), 0 ) );
+    m_board.OnItemChanged( m_trackB );
+
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 40 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( RemovalInvalidates )
+{
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 20 ) );
+
+    m_board.Remove( m_trackB );
+    m_trackB->SetEnd( VECTOR2I( pcbIUScale.mmToIU( 15 ), 0 ) );
+
+    BOOST_CHECK_EQUAL( netLength(), pcbIUScale.mmToIU( 15 ) );
+
+    delete m_trackB;
+    m_trackB = nullptr;
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
 #include <settings/settings_manager.h>
 #include <tools/multichannel_tool.h>
 #include <connectivity/topo_match.h>
+#include <netinfo.h>
 
 struct MULTICHANNEL_TEST_FIXTURE
 {
@@ -221,4 +222,155 @@ BOOST_FIXTURE_TEST_CASE( MultichannelToolRegressions, MULTICHANNEL_TEST_FIXTURE
 }
 
 
+/**
+ * Add rings of resistors to \a aBoard: in a ring of N resistors, pin 2 of each resistor is on
+ * the same net as pin 1 of the next one.
+ *
+ * @param aOddFootprint gives the first resistor of the first ring another footprint.
+ * @return the footprints of all the rings.
+ */
+static std::set<FOOTPRINT*> addResistorRings( BOARD* aBoard, const std::vector<int>& aRingSizes,
+                                              bool aOddFootprint = false )
+{
+    std::set<FOOTPRINT*> fps;
+
+    for( int ringSize : aRingSizes )
+    {
+        const int firstNet = aBoard->GetNetInfo().GetNetCount();
+
+        for( int ii = 0; ii < ringSize; ii++ )
+        {
+            int netCode = firstNet + ii;
+            aBoard->Add( new NETINFO_ITEM( aBoard, wxString::Format( wxS( "N%d" ), netCode ),
+                                           netCode ) );
+        }
+
+        for( int ii = 0; ii < ringSize; ii++ )
+        {
+            FOOTPRINT* fp = new FOOTPRINT( aBoard );
+            bool       odd = aOddFootprint && fps.empty();
+
+            fp->SetReference( wxString::Format( wxS( "R%d" ),
+                                                (int) aBoard->Footprints().size() + 1 ) );
+            fp->SetFPID( LIB_ID( wxS( "Resistor_SMD" ), odd ? wxS( "R_0805" ) : wxS( "R_0603" ) ) );
+            aBoard->Add( fp );
+
+            for( int pin = 0; pin < 2; pin++ )
+            {
+                PAD* pad = new PAD( fp );
+                pad->SetNumber( wxString::Format( wxS( "%d" ), pin + 1 ) );
+                pad->SetNetCode( firstNet + ( ii + pin ) % ringSize );
+                fp->Add( pad );
+            }
+
+            fps.insert( fp );
+        }
+    }
+
+    return fps;
+}
+
+
+/**
+ * Check that \a aResult maps every footprint of a channel onto one of the other channel, and
+ * that the nets of the matched pads correspond one to one.
+ */
+static void checkMatchPreservesNets( const TMATCH::COMPONENT_MATCHES& aResult,
+                                     size_t aComponentCount )
+{
+    BOOST_REQUIRE_EQUAL( aResult.size(), aComponentCount );
+
+    std::map<int, int>   netMap;
+    std::set<int>        mappedNets;
+    std::set<FOOTPRINT*> matched;
+
+    for( const auto& [fpA, fpB] : aResult )
+    {
+        BOOST_CHECK( fpA != fpB );
+        BOOST_CHECK( matched.insert( fpB ).second );
+        BOOST_REQUIRE_EQUAL( fpA->Pads().size(), fpB->Pads().size() );
+
+        for( size_t ii = 0; ii < fpA->Pads().size(); ii++ )
+        {
+            int netA = fpA->Pads()[ii]->GetNetCode();
+            int netB = fpB->Pads()[ii]->GetNetCode();
+
+            auto [it, inserted] = netMap.emplace( netA, netB );
+
+            if( inserted )
+                BOOST_CHECK( mappedNets.insert( netB ).second );
+            else
+                BOOST_CHECK_EQUAL( it->second, netB );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( TopoMatchSymmetricChannels )
+{
+    using TMATCH::CONNECTION_GRAPH;
+
+    // All the resistors of a ring look the same, so the first reference component has one
+    // candidate per target resistor and the search takes the parallel path
+    m_board = std::make_unique<BOARD>();
+
+    std::set<FOOTPRINT*> refFps = addResistorRings( m_board.get(), { 6 } );
+    std::set<FOOTPRINT*> tgtFps = addResistorRings( m_board.get(), { 6 } );
+
+    auto cgRef = CONNECTION_GRAPH::BuildFromFootprintSet( refFps );
+    auto cgTarget = CONNECTION_GRAPH::BuildFromFootprintSet( tgtFps );
+
+    TMATCH::COMPONENT_MATCHES parallelResult, sequentialResult;
+
+    BOOST_CHECK_EQUAL( cgRef->FindIsomorphism( cgTarget.get(), parallelResult, true ),
+                       CONNECTION_GRAPH::ST_OK );
+    BOOST_CHECK_EQUAL( cgRef->FindIsomorphism( cgTarget.get(), sequentialResult, false ),
+                       CONNECTION_GRAPH::ST_OK );
+
+    checkMatchPreservesNets( parallelResult, refFps.size() );
+
+    // The parallel search returns the match the sequential one finds
+    BOOST_CHECK( parallelResult == sequentialResult );
+}
+
+
+BOOST_AUTO_TEST_CASE( TopoMatchMismatchedChannels )
+{
+    using TMATCH::CONNECTION_GRAPH;
+
+    m_board = std::make_unique<BOARD>();
+
+    std::set<FOOTPRINT*> hexagon = addResistorRings( m_board.get(), { 6 } );
+    std::set<FOOTPRINT*> triangles = addResistorRings( m_board.get(), { 3, 3 } );
+    std::set<FOOTPRINT*> pentagon = addResistorRings( m_board.get(), { 5 } );
+    std::set<FOOTPRINT*> oddHexagon = addResistorRings( m_board.get(), { 6 }, true );
+
+    auto cgHexagon = CONNECTION_GRAPH::BuildFromFootprintSet( hexagon );
+
+    auto checkStatus =
+            [&]( const std::set<FOOTPRINT*>& aTarget, CONNECTION_GRAPH::STATUS aExpected )
+            {
+                auto cgTarget = CONNECTION_GRAPH::BuildFromFootprintSet( aTarget );
+
+                for( bool parallel : { true, false } )
+                {
+                    BOOST_TEST_CONTEXT( "Parallel " << parallel )
+                    {
+                        TMATCH::COMPONENT_MATCHES result;
+
+                        BOOST_CHECK_EQUAL( cgHexagon->FindIsomorphism( cgTarget.get(), result,
+                                                                       parallel ),
+                                           aExpected );
+                    }
+                }
+            };
+
+    // A ring of six and two rings of three have the same component signatures, so the
+    // mismatch is only found by exhausting the candidates of the (parallel) search
+    checkStatus( triangles, CONNECTION_GRAPH::ST_TOPOLOGY_MISMATCH );
+    checkStatus( pentagon, CONNECTION_GRAPH::ST_COMPONENT_COUNT_MISMATCH );
+    checkStatus( oddHexagon, CONNECTION_GRAPH::ST_TOPOLOGY_MISMATCH );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
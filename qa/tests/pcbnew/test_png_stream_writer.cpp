@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <functional>
+
+#include <exporters/png_stream_writer.h>
+
+#include <wx/image.h>
+
+
+struct PNG_STREAM_WRITER_FIXTURE
+{
+    PNG_STREAM_WRITER_FIXTURE() :
+            m_path( std::filesystem::temp_directory_path() / "qa_png_stream_writer_tst.png" )
+    {
+        if( !wxImage::FindHandler( wxBITMAP_TYPE_PNG ) )
+            wxImage::AddHandler( new wxPNGHandler );
+    }
+
+    ~PNG_STREAM_WRITER_FIXTURE() { std::filesystem::remove( m_path ); }
+
+    using PIXEL_FUNC = std::function<uint32_t( unsigned int aX, unsigned int aY )>;
+
+    /**
+     * Write an image whose RGBA pixels are given by \a aPixel, in bands of the given heights.
+     */
+    bool writeImage( unsigned int aWidth, const std::vector<unsigned int>& aBands,
+                     const PIXEL_FUNC& aPixel )
+    {
+        unsigned int height = 0;
+
+        for( unsigned int rows : aBands )
+            height += rows;
+
+        PNG_STREAM_WRITER writer;
+
+        if( !writer.Open( m_path.string(), aWidth, height ) )
+            return false;
+
+        unsigned int y0 = 0;
+
+        for( unsigned int rows : aBands )
+        {
+            std::vector<uint8_t> band( (size_t) aWidth * rows * 4 );
+
+            for( unsigned int y = 0; y < rows; ++y )
+            {
+                for( unsigned int x = 0; x < aWidth; ++x )
+                {
+                    uint32_t rgba = aPixel( x, y0 + y );
+                    uint8_t* px = &band[( (size_t) y * aWidth + x ) * 4];
+
+                    px[0] = rgba >> 24;
+                    px[1] = rgba >> 16;
+                    px[2] = rgba >> 8;
+                    px[3] = rgba;
+                }
+            }
+
+            if( !writer.WriteRows( band.data(), rows ) )
+                return false;
+
+            y0 += rows;
+        }
+
+        return writer.Close();
+    }
+
+    void checkImage( unsigned int aWidth, unsigned int aHeight, const PIXEL_FUNC& aPixel )
+    {
+        wxImage image;
+
+        BOOST_REQUIRE( image.LoadFile( m_path.string(), wxBITMAP_TYPE_PNG ) );
+        BOOST_REQUIRE_EQUAL( image.GetWidth(), (int) aWidth );
+        BOOST_REQUIRE_EQUAL( image.GetHeight(), (int) aHeight );
+        BOOST_REQUIRE( image.HasAlpha() );
+
+        int mismatches = 0;
+
+        for( unsigned int y = 0; y < aHeight; ++y )
+        {
+            for( unsigned int x = 0; x < aWidth; ++x )
+            {
+                uint32_t rgba = aPixel( x, y );
+
+                if( image.GetRed( x, y ) != (uint8_t) ( rgba >> 24 )
+                        || image.GetGreen( x, y ) != (uint8_t) ( rgba >> 16 )
+                        || image.GetBlue( x, y ) != (uint8_t) ( rgba >> 8 )
+                        || image.GetAlpha( x, y ) != (uint8_t) rgba )
+                {
+                    mismatches++;
+                }
+            }
+        }
+
+        BOOST_CHECK_EQUAL( mismatches, 0 );
+    }
+
+    std::filesystem::path m_path;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PngStreamWriter, PNG_STREAM_WRITER_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( Bands )
+{
+    // Gradients, with an alpha channel and a width which is not a multiple of anything
+    auto pixel =
+            []( unsigned int aX, unsigned int aY ) -> uint32_t
+            {
+                return ( ( aX * 5 ) & 0xFF ) << 24 | ( ( aY * 3 ) & 0xFF ) << 16
+                       | ( ( aX ^ aY ) & 0xFF ) << 8 | ( ( 255 - aX - aY ) & 0xFF );
+            };
+
+    BOOST_REQUIRE( writeImage( 37, { 1, 7, 20, 22 }, pixel ) );
+    checkImage( 37, 50, pixel );
+}
+
+
+BOOST_AUTO_TEST_CASE( SeveralIdatChunks )
+{
+    // Noise doesn't compress, so the data spans several IDAT chunks
+    auto pixel =
+            []( unsigned int aX, unsigned int aY ) -> uint32_t
+            {
+                uint32_t v = ( aY * 600 + aX ) * 2654435761u;
+                return v ^ ( v >> 15 );
+            };
+
+    BOOST_REQUIRE( writeImage( 600, { 160, 160, 160, 120 }, pixel ) );
+    BOOST_CHECK_GT( std::filesystem::file_size( m_path ), 2 * 256 * 1024 );
+    checkImage( 600, 600, pixel );
+}
+
+
+BOOST_AUTO_TEST_CASE( RowCount )
+{
+    PNG_STREAM_WRITER    writer;
+    std::vector<uint8_t> rows( 4 * 4 * 3 );
+
+    BOOST_REQUIRE( writer.Open( m_path.string(), 4, 4 ) );
+
+    // More rows than the image height are refused, and the image can't be closed until all
+    // the rows are written
+    BOOST_CHECK( !writer.WriteRows( rows.data(), 5 ) );
+    BOOST_CHECK( writer.WriteRows( rows.data(), 3 ) );
+    BOOST_CHECK( !writer.Close() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
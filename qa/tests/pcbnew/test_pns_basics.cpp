@@ -32,6 +32,9 @@
 #include <router/pns_item.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
+#include <router/pns_line.h>
+#include <router/pns_routing_settings.h>
+#include <router/pns_walkaround.h>
 
 static bool isCopper( const PNS::ITEM* aItem )
 {
@@ -414,3 +417,146 @@ BOOST_FIXTURE_TEST_CASE( PNSHoleCollisions, PNS_TEST_FIXTURE )
     }
 }
 
+
+BOOST_FIXTURE_TEST_CASE( PNSDenseLayerQueries, PNS_TEST_FIXTURE )
+{
+    // A via array large enough for the index to switch to the grid broadphase must report
+    // the same collisions as the few vias surrounding the probe, indexed in an R-Tree.
+    const int pitch = 1000000;
+    const int count = 60;
+    const int centre = count / 2;
+
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+    m_router->LoadSettings( &settings );
+
+    std::unique_ptr<PNS::NODE> dense( new PNS::NODE );
+    std::unique_ptr<PNS::NODE> sparse( new PNS::NODE );
+
+    for( PNS::NODE* world : { dense.get(), sparse.get() } )
+    {
+        world->SetMaxClearance( 1000000 );
+        world->SetRuleResolver( &m_ruleResolver );
+    }
+
+    m_ruleResolver.m_defaultClearance = 300000;
+
+    for( int x = 0; x < count; x++ )
+    {
+        for( int y = 0; y < count; y++ )
+        {
+            VECTOR2I        pos( x * pitch, y * pitch );
+            PNS_LAYER_RANGE layers( F_Cu, B_Cu );
+            auto            net = (PNS::NET_HANDLE) (intptr_t) ( 2 + x * count + y );
+
+            PNS::VIA* via = new PNS::VIA( pos, layers, 500000, 100000 );
+            via->SetNet( net );
+            dense->AddRaw( via );
+
+            if( std::abs( x - centre ) <= 1 && std::abs( y - centre ) <= 1 )
+            {
+                via = new PNS::VIA( pos, layers, 500000, 100000 );
+                via->SetNet( net );
+                sparse->AddRaw( via );
+            }
+        }
+    }
+
+    PNS::VIA probe( VECTOR2I( centre * pitch + 200000, centre * pitch ),
+                    PNS_LAYER_RANGE( F_Cu, B_Cu ), 500000, 100000 );
+    probe.SetNet( (PNS::NET_HANDLE) 1 );
+
+    PNS::NODE::OBSTACLES denseObstacles, sparseObstacles;
+    dense->QueryColliding( &probe, denseObstacles );
+    sparse->QueryColliding( &probe, sparseObstacles );
+
+    BOOST_CHECK_GT( sparseObstacles.size(), 0 );
+    BOOST_CHECK_EQUAL( denseObstacles.size(), sparseObstacles.size() );
+
+    // Multi-segment lines are queried in a single batch
+    PNS::LINE line;
+    line.SetShape( SHAPE_LINE_CHAIN( { VECTOR2I( centre * pitch - 600000, centre * pitch - 400000 ),
+                                       VECTOR2I( centre * pitch + 400000, centre * pitch - 400000 ),
+                                       VECTOR2I( centre * pitch + 400000, centre * pitch + 900000 ) } ) );
+    line.SetWidth( 100000 );
+    line.SetLayer( F_Cu );
+    line.SetNet( (PNS::NET_HANDLE) 1 );
+
+    PNS::NODE::OPT_OBSTACLE denseNearest = dense->NearestObstacle( &line );
+    PNS::NODE::OPT_OBSTACLE sparseNearest = sparse->NearestObstacle( &line );
+
+    BOOST_REQUIRE( denseNearest.has_value() );
+    BOOST_REQUIRE( sparseNearest.has_value() );
+    BOOST_CHECK_EQUAL( denseNearest->m_item->Anchor( 0 ), sparseNearest->m_item->Anchor( 0 ) );
+    BOOST_CHECK_EQUAL( denseNearest->m_ipFirst, sparseNearest->m_ipFirst );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PNSParallelWalkaround, PNS_TEST_FIXTURE )
+{
+    // Walking the policies on the thread pool must give the same result as the lock-step walk
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+    m_router->LoadSettings( &settings );
+
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+    world->SetMaxClearance( 1000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    m_ruleResolver.m_defaultClearance = 200000;
+
+    // A row of vias across the path, some of them close enough to form clusters
+    const std::vector<VECTOR2I> viaPositions = { { 3000000, 0 },        { 6000000, 300000 },
+                                                 { 6800000, -300000 },  { 10000000, 500000 },
+                                                 { 14000000, -200000 }, { 14700000, 400000 } };
+
+    for( size_t ii = 0; ii < viaPositions.size(); ii++ )
+    {
+        PNS::VIA* via = new PNS::VIA( viaPositions[ii], PNS_LAYER_RANGE( F_Cu, B_Cu ), 600000,
+                                      300000 );
+        via->SetNet( (PNS::NET_HANDLE) (intptr_t) ( 2 + ii ) );
+        world->AddRaw( via );
+    }
+
+    PNS::LINE path;
+    path.SetShape( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( 18000000, 0 ) } ) );
+    path.SetWidth( 200000 );
+    path.SetLayer( F_Cu );
+    path.SetNet( (PNS::NET_HANDLE) 1 );
+
+    auto walk =
+            [&]( bool aParallel )
+            {
+                settings.SetParallelWalkaround( aParallel );
+
+                PNS::WALKAROUND walkaround( world.get(), m_router );
+                walkaround.SetAllowedPolicies( { PNS::WALKAROUND::WP_CW,
+                                                 PNS::WALKAROUND::WP_CCW,
+                                                 PNS::WALKAROUND::WP_SHORTEST } );
+
+                return walkaround.Route( path );
+            };
+
+    PNS::WALKAROUND::RESULT sequential = walk( false );
+    PNS::WALKAROUND::RESULT parallel = walk( true );
+
+    int done = 0;
+
+    for( int pol : { PNS::WALKAROUND::WP_CW, PNS::WALKAROUND::WP_CCW,
+                     PNS::WALKAROUND::WP_SHORTEST } )
+    {
+        BOOST_TEST_CONTEXT( "Policy " << pol )
+        {
+            BOOST_CHECK_EQUAL( parallel.status[pol], sequential.status[pol] );
+            BOOST_CHECK( parallel.lines[pol].CLine().CPoints()
+                         == sequential.lines[pol].CLine().CPoints() );
+
+            // A finished walk went around the vias
+            if( sequential.status[pol] == PNS::WALKAROUND::ST_DONE )
+            {
+                BOOST_CHECK( !world->CheckColliding( &sequential.lines[pol] ) );
+                done++;
+            }
+        }
+    }
+
+    BOOST_CHECK_GT( done, 0 );
+}
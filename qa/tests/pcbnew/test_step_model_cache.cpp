@@ -0,0 +1,164 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <STEPControl_Writer.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDocStd_Document.hxx>
+
+#include <wx/utils.h>
+
+#include <exporters/step/step_pcb_model.h>
+
+
+struct STEP_MODEL_CACHE_FIXTURE
+{
+    STEP_MODEL_CACHE_FIXTURE() :
+            m_dir( std::filesystem::temp_directory_path() / "qa_step_model_cache" )
+    {
+        std::filesystem::remove_all( m_dir );
+        std::filesystem::create_directories( m_dir / "models" );
+
+        // Keep the converted models away from the user's cache
+        m_hadCacheHome = wxGetEnv( wxT( "KICAD_CACHE_HOME" ), &m_cacheHome );
+        wxSetEnv( wxT( "KICAD_CACHE_HOME" ), ( m_dir / "cache" ).string() );
+    }
+
+    ~STEP_MODEL_CACHE_FIXTURE()
+    {
+        if( m_hadCacheHome )
+            wxSetEnv( wxT( "KICAD_CACHE_HOME" ), m_cacheHome );
+        else
+            wxUnsetEnv( wxT( "KICAD_CACHE_HOME" ) );
+
+        std::filesystem::remove_all( m_dir );
+    }
+
+    std::string writeBoxModel( const std::string& aName )
+    {
+        std::filesystem::path path = m_dir / "models" / aName;
+        STEPControl_Writer    writer;
+
+        BOOST_REQUIRE( writer.Transfer( BRepPrimAPI_MakeBox( 1.0, 2.0, 3.0 ).Shape(),
+                                        STEPControl_AsIs ) == IFSelect_RetDone );
+        BOOST_REQUIRE( writer.Write( path.string().c_str() ) == IFSelect_RetDone );
+
+        return path.string();
+    }
+
+    std::vector<std::filesystem::path> cacheFiles()
+    {
+        std::vector<std::filesystem::path> files;
+
+        for( const auto& entry : std::filesystem::recursive_directory_iterator( m_dir / "cache" ) )
+        {
+            if( entry.path().extension() == ".xbf" )
+                files.push_back( entry.path() );
+        }
+
+        return files;
+    }
+
+    static Handle( TDocStd_Document ) modelDoc( STEP_PCB_MODEL& aModel, const std::string& aFile )
+    {
+        auto it = aModel.m_modelDocs.find( aFile );
+
+        return it != aModel.m_modelDocs.end() ? it->second : Handle( TDocStd_Document )();
+    }
+
+    std::filesystem::path m_dir;
+    wxString              m_cacheHome;
+    bool                  m_hadCacheHome;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( StepModelCache, STEP_MODEL_CACHE_FIXTURE )
+
+
+/**
+ * A model read from its STEP file is written to the cache, and the next export opens the
+ * cached document instead of reading the STEP file again.
+ */
+BOOST_AUTO_TEST_CASE( CacheRoundTrip )
+{
+    std::string fileName = writeBoxModel( "box.step" );
+
+    {
+        STEP_PCB_MODEL model( wxT( "first" ) );
+        model.LoadModels( { fileName } );
+
+        BOOST_CHECK( !modelDoc( model, fileName ).IsNull() );
+    }
+
+    std::vector<std::filesystem::path> files = cacheFiles();
+    BOOST_REQUIRE_EQUAL( files.size(), 1u );
+
+    STEP_PCB_MODEL model( wxT( "second" ) );
+    model.LoadModels( { fileName } );
+
+    Handle( TDocStd_Document ) doc = modelDoc( model, fileName );
+
+    BOOST_REQUIRE( !doc.IsNull() );
+
+    std::filesystem::path docPath( TCollection_AsciiString( doc->GetPath() ).ToCString() );
+    BOOST_CHECK( std::filesystem::equivalent( docPath, files[0] ) );
+
+    // No new entry for the same contents
+    BOOST_CHECK_EQUAL( cacheFiles().size(), 1u );
+}
+
+
+/**
+ * Model files with identical contents are read once, and share the document.
+ */
+BOOST_AUTO_TEST_CASE( LoadModelsDeduplicates )
+{
+    std::string fileA = writeBoxModel( "a.step" );
+    std::string fileB = ( m_dir / "models" / "b.step" ).string();
+
+    std::filesystem::copy_file( fileA, fileB );
+
+    STEP_PCB_MODEL model( wxT( "dedup" ) );
+    model.LoadModels( { fileA, fileB, fileA } );
+
+    Handle( TDocStd_Document ) docA = modelDoc( model, fileA );
+    Handle( TDocStd_Document ) docB = modelDoc( model, fileB );
+
+    BOOST_REQUIRE( !docA.IsNull() );
+    BOOST_CHECK( docA == docB );
+    BOOST_CHECK_EQUAL( cacheFiles().size(), 1u );
+
+    // A missing file is recorded as a failed read, and does not affect the others
+    std::string missing = ( m_dir / "models" / "missing.step" ).string();
+
+    model.LoadModels( { missing } );
+    BOOST_CHECK( modelDoc( model, missing ).IsNull() );
+    BOOST_CHECK( modelDoc( model, fileA ) == docA );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,12 +26,14 @@
 #include "pns_log_player.h"
 
 #include <pcbnew_utils/board_test_utils.h>
+#include <core/profile.h>
 
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
 
-PNS_LOG_PLAYER::PNS_LOG_PLAYER()
+PNS_LOG_PLAYER::PNS_LOG_PLAYER() :
+        m_debugEnabled( true )
 {
     SetReporter( &NULL_REPORTER::GetInstance() );
 }
@@ -58,6 +60,7 @@ void PNS_LOG_PLAYER::createRouter()
 
     m_debugDecorator = new PNS_TEST_DEBUG_DECORATOR( m_reporter );
     m_debugDecorator->Clear();
+    m_debugDecorator->SetDebugEnabled( m_debugEnabled );
     m_iface->SetDebugDecorator( m_debugDecorator );
 }
 
@@ -104,6 +107,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
     m_router->SetMode( aLog->GetMode() );
 
+    m_eventTimings.clear();
+
     for( auto evt : aLog->Events() )
     {
         if( eventIdx < aFrom || ( aTo >= 0 && eventIdx > aTo ) )
@@ -128,6 +133,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        PROF_TIMER eventTimer;
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -225,6 +232,9 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        eventTimer.Stop();
+        m_eventTimings.push_back( { evt.type, (uint64_t) ( eventTimer.msecs() * 1000.0 ) } );
+
         PNS::NODE* node = nullptr;
 
 #if 0
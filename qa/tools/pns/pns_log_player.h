@@ -24,11 +24,13 @@
 #define __PNS_LOG_PLAYER_H
 
 #include <map>
+#include <vector>
 #include <pcbnew/board.h>
 
 #include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 #include <router/pns_router.h>
+#include <router/pns_logger.h>
 
 
 class PNS_TEST_DEBUG_DECORATOR;
@@ -93,6 +95,13 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    ///< Wall-clock time spent by the router on a single replayed event.
+    struct EVENT_TIMING
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        uint64_t                m_durationUs;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -106,6 +115,14 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Enable or disable the router debug output.  Disable it when measuring performance, the
+     * debug decorator records every intermediate shape.
+     */
+    void SetDebugEnabled( bool aEnabled ) { m_debugEnabled = aEnabled; }
+
+    const std::vector<EVENT_TIMING>& GetEventTimings() const { return m_eventTimings; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -120,6 +137,9 @@ private:
     std::unique_ptr<PNS::ROUTING_SETTINGS>      m_routingSettings;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    bool      m_debugEnabled;
+
+    std::vector<EVENT_TIMING> m_eventTimings;
 };
 
 #endif
@@ -0,0 +1,396 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Headless router benchmark.  Replays a corpus of recorded P&S sessions (the same corpus
+ * as qa_pns_regressions) without any GUI and writes per-case latency and work counters
+ * as JSON.  When given a baseline JSON from an earlier run, reports the cases that got
+ * slower than the given tolerance and exits with an error code.
+ */
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include <fmt/format.h>
+
+#include <json_common.h>
+#include <reporter.h>
+#include <core/profile.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+#include <router/pns_node.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+
+using json = nlohmann::json;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            "displays help on the command line parameters",
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "o",
+            "output",
+            "JSON file to write the results to (default qa_pns_benchmark.json)",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "b",
+            "baseline",
+            "compare the results against this JSON file from an earlier run",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "t",
+            "tolerance",
+            "allowed slowdown against the baseline, in percent (default 25)",
+            wxCMD_LINE_VAL_NUMBER,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "r",
+            "repeat",
+            "replay each case this many times and keep the fastest run (default 3)",
+            wxCMD_LINE_VAL_NUMBER,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "c",
+            "case",
+            "replay only the case with this name",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            "cases",
+            "cases",
+            "directory holding tests.lst (default: the pns_regressions test data)",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+struct BENCHMARK_CASE
+{
+    wxString m_name;
+    wxString m_logPath;
+};
+
+
+struct BENCHMARK_RESULT
+{
+    std::vector<uint64_t> m_moveTimesUs;
+    uint64_t              m_totalUs = 0;
+    uint64_t              m_collisionQueries = 0;
+    uint64_t              m_nodesAllocated = 0;
+    int                   m_events = 0;
+    bool                  m_loaded = false;
+    bool                  m_pass = false;
+};
+
+
+static std::vector<BENCHMARK_CASE> loadCases( const wxString& aDir )
+{
+    std::vector<BENCHMARK_CASE> cases;
+    wxFileName                  fnameList( aDir, wxT( "tests.lst" ) );
+    wxTextFile                  fp( fnameList.GetFullPath() );
+
+    if( !fp.Open() )
+    {
+        std::cerr << "Failed to load test list from " << fnameList.GetFullPath() << std::endl;
+        return cases;
+    }
+
+    for( size_t ii = 0; ii < fp.GetLineCount(); ++ii )
+    {
+        wxString line = fp[ii];
+        line.Trim().Trim( false );
+
+        if( line.IsEmpty() )
+            continue;
+
+        wxFileName logPath( aDir, wxEmptyString );
+        logPath.AppendDir( line );
+        logPath.SetName( wxT( "pns" ) );
+
+        cases.push_back( { line, logPath.GetFullPath() } );
+    }
+
+    return cases;
+}
+
+
+static BENCHMARK_RESULT runCase( const BENCHMARK_CASE& aCase )
+{
+    BENCHMARK_RESULT result;
+    PNS_LOG_FILE     logFile;
+    PNS_LOG_PLAYER   player;
+
+    if( !logFile.Load( aCase.m_logPath, &NULL_REPORTER::GetInstance() ) )
+        return result;
+
+    result.m_loaded = true;
+
+    player.SetDebugEnabled( false );
+
+    PNS::NODE::Stats().Reset();
+
+    PROF_TIMER timer;
+    player.ReplayLog( &logFile, 0 );
+    timer.Stop();
+
+    result.m_totalUs = (uint64_t) ( timer.msecs() * 1000.0 );
+    result.m_collisionQueries = PNS::NODE::Stats().m_collisionQueries;
+    result.m_nodesAllocated = PNS::NODE::Stats().m_nodesAllocated;
+    result.m_events = (int) player.GetEventTimings().size();
+    result.m_pass = player.CompareResults( &logFile );
+
+    for( const PNS_LOG_PLAYER::EVENT_TIMING& timing : player.GetEventTimings() )
+    {
+        if( timing.m_type == PNS::LOGGER::EVT_MOVE )
+            result.m_moveTimesUs.push_back( timing.m_durationUs );
+    }
+
+    std::sort( result.m_moveTimesUs.begin(), result.m_moveTimesUs.end() );
+
+    return result;
+}
+
+
+static uint64_t percentile( const std::vector<uint64_t>& aSorted, double aFraction )
+{
+    if( aSorted.empty() )
+        return 0;
+
+    size_t idx = (size_t) ( aFraction * (double) ( aSorted.size() - 1 ) + 0.5 );
+    return aSorted[ std::min( idx, aSorted.size() - 1 ) ];
+}
+
+
+static json toJson( const BENCHMARK_RESULT& aResult )
+{
+    json j;
+
+    j["loaded"] = aResult.m_loaded;
+    j["pass"] = aResult.m_pass;
+    j["events"] = aResult.m_events;
+    j["moves"] = aResult.m_moveTimesUs.size();
+    j["total_us"] = aResult.m_totalUs;
+    j["move_median_us"] = percentile( aResult.m_moveTimesUs, 0.5 );
+    j["move_p99_us"] = percentile( aResult.m_moveTimesUs, 0.99 );
+    j["move_max_us"] = aResult.m_moveTimesUs.empty() ? 0 : aResult.m_moveTimesUs.back();
+    j["collision_queries"] = aResult.m_collisionQueries;
+    j["nodes_allocated"] = aResult.m_nodesAllocated;
+
+    return j;
+}
+
+
+/**
+ * Compare a case against its baseline.  Timings are compared with \a aTolerance, the work
+ * counters are deterministic for a given log and must not grow at all.
+ *
+ * @return a description of the regressions found, empty if none.
+ */
+static std::string compareWithBaseline( const json& aResult, const json& aBaseline,
+                                        double aTolerance )
+{
+    std::string regressions;
+
+    auto checkTime =
+            [&]( const char* aKey )
+            {
+                uint64_t cur = aResult.value( aKey, (uint64_t) 0 );
+                uint64_t base = aBaseline.value( aKey, (uint64_t) 0 );
+
+                // Ignore noise on very fast events
+                if( cur > 1000 && cur > base * ( 1.0 + aTolerance / 100.0 ) )
+                {
+                    regressions += fmt::format( " {} {} -> {} us;", aKey, base, cur );
+                }
+            };
+
+    auto checkCount =
+            [&]( const char* aKey )
+            {
+                uint64_t cur = aResult.value( aKey, (uint64_t) 0 );
+                uint64_t base = aBaseline.value( aKey, (uint64_t) 0 );
+
+                if( cur > base )
+                    regressions += fmt::format( " {} {} -> {};", aKey, base, cur );
+            };
+
+    checkTime( "move_median_us" );
+    checkTime( "move_p99_us" );
+    checkCount( "collision_queries" );
+    checkCount( "nodes_allocated" );
+
+    if( aBaseline.value( "pass", false ) && !aResult.value( "pass", false ) )
+        regressions += " results no longer match the reference;";
+
+    return regressions;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer( argc, argv );
+
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( "Headless P&S router benchmark. Replays recorded routing sessions and "
+                            "reports per-case timings and work counters as JSON." );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+        return cmd_parsed_ok == -1 ? 0 : 1;
+
+    wxString casesDir;
+
+    if( cl_parser.GetParamCount() > 0 )
+        casesDir = cl_parser.GetParam( 0 );
+    else
+        casesDir = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions/" );
+
+    long repeat = 3;
+    long tolerance = 25;
+    cl_parser.Found( "repeat", &repeat );
+    cl_parser.Found( "tolerance", &tolerance );
+    repeat = std::max( 1L, repeat );
+
+    json baseline;
+    wxString baselinePath;
+
+    if( cl_parser.Found( "baseline", &baselinePath ) )
+    {
+        std::ifstream baselineFile( baselinePath.fn_str() );
+
+        try
+        {
+            baselineFile >> baseline;
+        }
+        catch( const std::exception& e )
+        {
+            std::cerr << "Failed to read baseline " << baselinePath << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BENCHMARK_CASE> cases = loadCases( casesDir );
+    wxString                    onlyCase;
+
+    if( cl_parser.Found( "case", &onlyCase ) )
+    {
+        std::erase_if( cases,
+                       [&]( const BENCHMARK_CASE& aCase )
+                       {
+                           return aCase.m_name != onlyCase;
+                       } );
+    }
+
+    if( cases.empty() )
+    {
+        std::cerr << "No cases to replay" << std::endl;
+        return 1;
+    }
+
+    json results;
+    int  regressed = 0;
+    int  failed = 0;
+
+    for( const BENCHMARK_CASE& benchCase : cases )
+    {
+        BENCHMARK_RESULT best;
+
+        for( long ii = 0; ii < repeat; ++ii )
+        {
+            BENCHMARK_RESULT run = runCase( benchCase );
+
+            if( ii == 0 || run.m_totalUs < best.m_totalUs )
+                best = std::move( run );
+        }
+
+        json caseResult = toJson( best );
+        std::string name = benchCase.m_name.ToStdString();
+
+        if( !best.m_loaded || best.m_events == 0 )
+        {
+            std::cerr << "FAILED " << name << ": could not replay " << benchCase.m_logPath
+                      << std::endl;
+            failed++;
+        }
+
+        if( baseline.contains( "cases" ) && baseline["cases"].contains( name ) )
+        {
+            std::string regressions = compareWithBaseline( caseResult, baseline["cases"][name],
+                                                           (double) tolerance );
+
+            if( !regressions.empty() )
+            {
+                std::cerr << "REGRESSION " << name << ":" << regressions << std::endl;
+                caseResult["regressions"] = regressions;
+                regressed++;
+            }
+        }
+
+        results["cases"][name] = caseResult;
+    }
+
+    results["repeat"] = repeat;
+
+    // The log player chats on stdout, so the results always go to a file
+    wxString outputPath = wxT( "qa_pns_benchmark.json" );
+    cl_parser.Found( "output", &outputPath );
+
+    std::ofstream outputFile( outputPath.fn_str() );
+    outputFile << results.dump( 2 ) << std::endl;
+
+    if( failed )
+        return 1;
+
+    return regressed ? 2 : 0;
+}
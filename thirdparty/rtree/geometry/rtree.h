@@ -140,6 +140,12 @@ public:
 public:
 
     RTree();
+
+    /// Deep copy of the tree structure.  Much faster than re-inserting every entry since no
+    /// node splits have to be computed.
+    RTree( const RTree& aOther );
+    RTree& operator=( const RTree& ) = delete;
+
     virtual ~RTree();
 
     /// Insert entry
@@ -605,6 +611,7 @@ protected:
     }
 
     void    RemoveAllRec( Node* a_node ) const;
+    Node*   CopyRec( const Node* a_node ) const;
     void    Reset() const;
     void    CountRec( const Node* a_node, int& a_count ) const;
 
@@ -725,6 +732,13 @@ RTREE_TEMPLATE RTREE_QUAL::RTree()
 }
 
 
+RTREE_TEMPLATE RTREE_QUAL::RTree( const RTree& aOther )
+{
+    m_root = CopyRec( aOther.m_root );
+    m_unitSphereVolume = aOther.m_unitSphereVolume;
+}
+
+
 RTREE_TEMPLATE
 RTREE_QUAL::~RTree() {
     Reset(); // Free, or reset node memory
@@ -1158,6 +1172,27 @@ void RTREE_QUAL::RemoveAllRec( Node* a_node ) const
 }
 
 
+RTREE_TEMPLATE
+typename RTREE_QUAL::Node* RTREE_QUAL::CopyRec( const Node* a_node ) const
+{
+    ASSERT( a_node );
+    ASSERT( a_node->m_level >= 0 );
+
+    Node* newNode = AllocNode();
+    *newNode = *a_node;
+
+    if( a_node->IsInternalNode() ) // This is an internal node in the tree
+    {
+        for( int index = 0; index < a_node->m_count; ++index )
+        {
+            newNode->m_branch[index].m_child = CopyRec( a_node->m_branch[index].m_child );
+        }
+    }
+
+    return newNode;
+}
+
+
 RTREE_TEMPLATE
 typename RTREE_QUAL::Node* RTREE_QUAL::AllocNode() const
 {